@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-distributed-example.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-distributed-example.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-distributed-example.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+// 3N over the ns-3 distributed simulator.
+//
+// A chain of nodes split in consecutive blocks, one per MPI rank, with a
+// producer at the first node and a consumer at the last one. Interests, Data
+// and the 3N PDUs carrying them cross the ranks serialized over the
+// point-to-point links joining the blocks. Every rank traces its own nodes,
+// in rate-trace-rank<r>.txt and app-delays-trace-rank<r>.txt:
+//
+//   ./waf --run nnn-distributed-example --command-template="mpirun -np 2 %s --nodes=16"
+//
+// Needs ns-3 configured with --enable-mpi. Run with one rank, the whole
+// chain is simulated by the one process.
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/mpi-interface.h"
+
+#include "ns3/nnn-app-delay-tracer.h"
+#include "ns3/nnn-app-helper.h"
+#include "ns3/nnn-distributed-helper.h"
+#include "ns3/nnn-global-routing-helper.h"
+#include "ns3/nnn-l3-rate-tracer.h"
+#include "ns3/nnn-sector-hierarchy-helper.h"
+#include "ns3/nnn-stack-helper.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nodes = 16;
+  double frequency = 100.0;
+  double stop = 20.0;
+  std::string delay = "5ms";
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of nodes in the chain", nodes);
+  cmd.AddValue ("frequency", "Interests per second sent by the consumer", frequency);
+  cmd.AddValue ("stop", "Simulated seconds", stop);
+  cmd.AddValue ("delay", "Delay of every link, the lookahead between ranks", delay);
+  cmd.Parse (argc, argv);
+
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+  MpiInterface::Enable (&argc, &argv);
+
+  uint32_t ranks = nnn::DistributedHelper::GetSize ();
+  NS_ABORT_MSG_IF (nodes < 2 * ranks, "The chain needs at least 2 nodes per rank");
+
+  // Every rank builds the whole chain, node i being simulated by rank i * ranks / nodes
+  NodeContainer chain;
+  for (uint32_t i = 0; i < nodes; i++)
+    {
+      chain.Create (1, (i * ranks) / nodes);
+    }
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue (delay));
+
+  // Links between nodes of different ranks get a remote channel
+  for (uint32_t i = 0; i + 1 < nodes; i++)
+    {
+      p2p.Install (chain.Get (i), chain.Get (i + 1));
+    }
+
+  nnn::NNNStackHelper stack;
+  stack.Install (chain);
+
+  // The names and routes of remote nodes are loaded too, so that every rank
+  // sees the same hierarchy without enrolling across ranks
+  nnn::SectorHierarchyHelper hierarchy;
+  std::string name = "1";
+  for (uint32_t i = 0; i < nodes; i++)
+    {
+      hierarchy.AddNode (chain.Get (i), name);
+      name += ".1";
+    }
+  hierarchy.Install ();
+
+  nnn::GlobalRoutingHelper routing;
+  routing.AddOrigin ("/distributed", chain.Get (0));
+  routing.CalculateRoutes ();
+
+  // Applications only run on the rank simulating their node
+  nnn::AppHelper producer ("ns3::nnn::ICNProducer");
+  producer.SetPrefix ("/distributed");
+  producer.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producer.Install (nnn::DistributedHelper::GetLocalNodes (NodeContainer (chain.Get (0))));
+
+  nnn::AppHelper consumer ("ns3::nnn::ICNConsumerCbr");
+  consumer.SetPrefix ("/distributed");
+  consumer.SetAttribute ("Frequency", DoubleValue (frequency));
+  consumer.Install (nnn::DistributedHelper::GetLocalNodes (NodeContainer (chain.Get (nodes - 1))));
+
+  nnn::L3RateTracer::InstallAll ("rate-trace.txt", Seconds (1.0));
+  nnn::AppDelayTracer::InstallAll ("app-delays-trace.txt");
+
+  std::cout << "Rank " << nnn::DistributedHelper::GetRank () << " of " << ranks << " simulates "
+      << nnn::DistributedHelper::GetLocalNodes (chain).GetN () << " of " << nodes << " nodes" << std::endl;
+
+  Simulator::Stop (Seconds (stop));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  MpiInterface::Disable ();
+
+  return 0;
+}
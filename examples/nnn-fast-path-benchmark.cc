@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-fast-path-benchmark.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-fast-path-benchmark.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-fast-path-benchmark.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+// Reference scenario to measure the cost of logging on the forwarding path.
+//
+// A chain of nodes is built with node 0 holding a fixed 3N name, the rest
+// enrolling one after the other. A CBR consumer at the end of the chain
+// requests content from a producer on node 0. The program prints the number of
+// PDUs handled by the forwarding strategies per wall clock second.
+//
+// Compare a build configured with and without --nnnsim-fast-path, with ns-3
+// logging compiled in (debug build) and no NS_LOG variable set:
+//
+//   ./waf configure -d debug && ./waf build
+//   ./waf --run nnn-fast-path-benchmark
+//   ./waf configure -d debug --nnnsim-fast-path && ./waf build
+//   ./waf --run nnn-fast-path-benchmark
+//
+// No before and after numbers have been recorded for --nnnsim-fast-path:
+// the option was added without an ns-3 tree to build and run it against, so
+// its gain is still to be measured with the commands above.
+//
+// The cost of tracing on the same path is measured by comparing a run with
+// and without an L3RateTracer attached to every node, at a high rate:
+//
+//   ./waf --run "nnn-fast-path-benchmark --nodes=32 --frequency=10000"
+//   ./waf --run "nnn-fast-path-benchmark --nodes=32 --frequency=10000 --rateTrace=rate-trace.bin"
+//
+// No numbers have been recorded for the per face counter arrays of the
+// tracers either. Running both commands on builds from before and after
+// the change gives the per event cost of tracing.
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/nnn-address.h"
+#include "ns3/nnn-app-helper.h"
+#include "ns3/nnn-forwarding-strategy.h"
+#include "ns3/nnn-l3-rate-tracer.h"
+#include "ns3/nnn-stack-helper.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+static uint64_t g_fwEvents = 0;
+
+static void
+CountInterest (Ptr<const nnn::Interest>, Ptr<const nnn::Face>)
+{
+  g_fwEvents++;
+}
+
+static void
+CountData (Ptr<const nnn::Data>, Ptr<const nnn::Face>)
+{
+  g_fwEvents++;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nodes = 8;
+  double frequency = 1000.0;
+  double stop = 60.0;
+  std::string rateTrace;
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of nodes in the chain", nodes);
+  cmd.AddValue ("frequency", "Interests per second sent by the consumer", frequency);
+  cmd.AddValue ("stop", "Simulated seconds", stop);
+  cmd.AddValue ("rateTrace", "If set, file to which an L3RateTracer on every node writes", rateTrace);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (nodes < 2, "The chain needs at least 2 nodes");
+
+  NodeContainer chain;
+  chain.Create (nodes);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1ms"));
+
+  for (uint32_t i = 0; i + 1 < nodes; i++)
+    {
+      p2p.Install (chain.Get (i), chain.Get (i + 1));
+    }
+
+  nnn::NNNStackHelper stack;
+  stack.Install (chain);
+
+  for (uint32_t i = 0; i + 1 < nodes; i++)
+    {
+      stack.AddRoute (chain.Get (i + 1), "/bench", chain.Get (i), 1);
+    }
+
+  // Node 0 is the root of the 3N name space, the rest enroll in order
+  Ptr<nnn::ForwardingStrategy> root = chain.Get (0)->GetObject<nnn::ForwardingStrategy> ();
+  root->SetNode3NName (Create<nnn::NNNAddress> ("1"), Seconds (stop * 2), true);
+
+  for (uint32_t i = 1; i < nodes; i++)
+    {
+      Ptr<nnn::ForwardingStrategy> fw = chain.Get (i)->GetObject<nnn::ForwardingStrategy> ();
+      Simulator::Schedule (MilliSeconds (100 * i), &nnn::ForwardingStrategy::Enroll, fw);
+    }
+
+  nnn::AppHelper producer ("ns3::nnn::ICNProducer");
+  producer.SetPrefix ("/bench");
+  producer.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producer.Install (chain.Get (0));
+
+  nnn::AppHelper consumer ("ns3::nnn::ICNConsumerCbr");
+  consumer.SetPrefix ("/bench");
+  consumer.SetAttribute ("Frequency", DoubleValue (frequency));
+  ApplicationContainer apps = consumer.Install (chain.Get (nodes - 1));
+  apps.Start (MilliSeconds (100 * (nodes + 1)));
+
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/InInterests",
+                                 MakeCallback (&CountInterest));
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/InData",
+                                 MakeCallback (&CountData));
+
+  if (!rateTrace.empty ())
+    {
+      nnn::L3RateTracer::InstallAll (rateTrace, Seconds (0.5));
+    }
+
+  Simulator::Stop (Seconds (stop));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+
+  Simulator::Destroy ();
+  nnn::L3RateTracer::Destroy ();
+
+  double rate = (elapsed > 0) ? (g_fwEvents * 1000.0) / elapsed : 0.0;
+
+  std::cout << "nodes\tfrequency\tevents\twall_ms\tevents_per_s" << std::endl;
+  std::cout << nodes << "\t" << frequency << "\t" << g_fwEvents << "\t"
+            << elapsed << "\t" << rate << std::endl;
+
+  return 0;
+}
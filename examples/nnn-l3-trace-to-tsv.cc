@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-l3-trace-to-tsv.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-l3-trace-to-tsv.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-l3-trace-to-tsv.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+// Converts the binary output of L3RateTracer and L3AggregateTracer (trace
+// files ending in .bin) back to the TSV written in text mode.
+//
+//   ./waf --run "nnn-l3-trace-to-tsv --input=rate-trace.bin --output=rate-trace.txt"
+
+#include "ns3/core-module.h"
+
+#include "ns3/nnn-l3-binary-trace.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace ns3;
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Binary trace written by L3RateTracer or L3AggregateTracer", input);
+  cmd.AddValue ("output", "TSV file to write, - for standard output", output);
+  cmd.Parse (argc, argv);
+
+  std::ifstream is (input.c_str (), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open ())
+    {
+      std::cerr << "Cannot open " << input << std::endl;
+      return 1;
+    }
+
+  bool ok;
+  if (output == "-")
+    {
+      ok = nnn::L3BinaryTraceReader::ConvertToTsv (is, std::cout);
+    }
+  else
+    {
+      std::ofstream os (output.c_str (), std::ios_base::out | std::ios_base::trunc);
+      if (!os.is_open ())
+        {
+          std::cerr << "Cannot open " << output << " for writing" << std::endl;
+          return 1;
+        }
+      ok = nnn::L3BinaryTraceReader::ConvertToTsv (is, os);
+    }
+
+  if (!ok)
+    {
+      std::cerr << input << " is not a valid binary L3 trace" << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,817 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-micro-benchmark.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-micro-benchmark.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-micro-benchmark.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+// Micro-benchmarks for the tables and wire codecs, outside of a simulation.
+//
+// Every benchmark runs against tables of --sizes entries holding names of
+// --depths labels: the NNST, NNPT and PDU buffer lookups, PIT and content
+// store lookups and insertions, the 3N name distance and the encoding and
+// decoding of every 3N and ICN PDU and name. Operations are timed in
+// batches of --batch calls. --warmup batches are run and thrown away, then
+// --repetitions batches are timed and the minimum, percentiles, maximum and
+// mean of the nanoseconds per call over the batches are reported.
+//
+// Results are printed as JSON, one benchmark per line, so two runs can be
+// compared with a line diff or loaded by a script. --label tags the run, for
+// instance with the commit it was built from:
+//
+//   ./waf --run "nnn-micro-benchmark --label=$(git rev-parse --short HEAD)" > micro.json
+//   ./waf --run "nnn-micro-benchmark --filter=wire_ --sizes=256 --depths=2,8"
+//
+// Decoding includes the copy of the packet, as the decoders consume their
+// input. Encoding drops the cached wire of the PDU first, so it measures a
+// full encoding and not a cache hit.
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#include "ns3/nnn-icn-naming.h"
+#include "ns3/nnn-icn-pdus.h"
+#include "ns3/nnn-icn-content-store.h"
+#include "ns3/nnn-l3-protocol.h"
+#include "ns3/nnn-naming.h"
+#include "ns3/nnn-nnpt.h"
+#include "ns3/nnn-nnst.h"
+#include "ns3/nnn-pdu-buffer.h"
+#include "ns3/nnn-pdus.h"
+#include "ns3/nnn-pit.h"
+#include "ns3/nnn-stack-helper.h"
+#include "ns3/icn-wire.h"
+#include "ns3/nnn-wire.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+// Results of the measured operations are stored here so that they are not
+// optimized away
+static volatile uint64_t g_sink = 0;
+
+// PDUs encoded and decoded by the codec benchmarks, per type
+static const uint32_t POOL = 256;
+
+// PDUs waiting in every destination of the PDU buffer read by PopQueue
+static const uint32_t QUEUE = 8;
+
+enum PduType
+{
+  PDU_NULLP = 0,
+  PDU_SO,
+  PDU_DO,
+  PDU_DU,
+  PDU_EN,
+  PDU_AEN,
+  PDU_REN,
+  PDU_DEN,
+  PDU_INF,
+  PDU_OEN,
+  PDU_TYPES
+};
+
+static uint64_t
+NowNs ()
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t> (ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+static std::vector<uint32_t>
+ParseList (const std::string &list)
+{
+  std::vector<uint32_t> values;
+  std::istringstream is (list);
+  std::string value;
+
+  while (std::getline (is, value, ','))
+    {
+      if (!value.empty ())
+	values.push_back (std::strtoul (value.c_str (), 0, 10));
+    }
+
+  return values;
+}
+
+// Labels of name id in a hierarchy with the given fan out, most significant first
+static std::vector<uint32_t>
+Labels (uint32_t id, uint32_t depth, uint32_t fanOut)
+{
+  std::vector<uint32_t> labels (depth);
+  for (uint32_t j = depth; j > 0; j--)
+    {
+      labels[j - 1] = id % fanOut;
+      id /= fanOut;
+    }
+  return labels;
+}
+
+static std::string
+MakeName (uint32_t id, uint32_t depth, uint32_t fanOut, const std::string &suffix)
+{
+  std::vector<uint32_t> labels = Labels (id, depth, fanOut);
+  std::ostringstream os;
+  os << std::hex;
+  for (uint32_t j = 0; j < depth; j++)
+    {
+      os << (j ? "." : "") << labels[j];
+    }
+  os << suffix;
+  return os.str ();
+}
+
+static std::string
+MakeIcnName (uint32_t id, uint32_t depth, uint32_t fanOut, const std::string &suffix)
+{
+  std::vector<uint32_t> labels = Labels (id, depth, fanOut);
+  std::ostringstream os;
+  os << "/bench";
+  for (uint32_t j = 0; j < depth; j++)
+    {
+      os << "/" << labels[j];
+    }
+  os << suffix;
+  return os.str ();
+}
+
+/**
+ * Tables and PDUs shared by the benchmarks of one table size and name depth
+ */
+struct Fixture
+{
+  Fixture (uint32_t size, uint32_t depth);
+  ~Fixture ();
+
+  uint32_t m_size;
+
+  std::vector<Ptr<const nnn::NNNAddress> > m_names;    ///< names in the NNST, NNPT and PDU buffers
+  std::vector<Ptr<const nnn::NNNAddress> > m_queries;  ///< names one label below m_names
+  std::vector<Ptr<const nnn::NNNAddress> > m_newNames; ///< names paired to m_names in the NNPT
+
+  std::vector<Ptr<nnn::Interest> > m_interests;    ///< Interests with an entry in the PIT and content store
+  std::vector<Ptr<nnn::Interest> > m_newInterests; ///< Interests without
+  std::vector<Ptr<nnn::Data> > m_data;             ///< Data for m_interests, then for m_newInterests
+
+  Ptr<Node> m_node;
+  Ptr<nnn::NNST> m_nnst;
+  Ptr<nnn::NNPT> m_nnpt;
+  Ptr<nnn::Pit> m_pit;
+  Ptr<nnn::ContentStore> m_cs;
+  Ptr<nnn::PDUBuffer> m_buffer;     ///< QUEUE PDUs per destination
+  Ptr<nnn::PDUBuffer> m_pushBuffer; ///< grows with the push benchmarks
+
+  std::vector<Ptr<nnn::NNNPDU> > m_pdus[PDU_TYPES];
+  std::vector<Ptr<Packet> > m_wires[PDU_TYPES];
+  std::vector<std::string> m_wireStrs[PDU_TYPES];
+  std::vector<Ptr<Packet> > m_interestWires;
+  std::vector<Ptr<Packet> > m_dataWires;
+  std::vector<std::string> m_interestWireStrs;
+  std::vector<std::string> m_dataWireStrs;
+  std::vector<std::string> m_nameWires;
+  std::vector<std::string> m_icnNameWires;
+};
+
+Fixture::Fixture (uint32_t size, uint32_t depth)
+  : m_size (size)
+{
+  // Smallest fan out giving every name its own labels
+  uint32_t fanOut = 2;
+  while (std::pow (static_cast<double> (fanOut), static_cast<double> (depth)) < size)
+    fanOut++;
+
+  Time lease = Seconds (1000000);
+  Address poa = Mac48Address::Allocate ();
+
+  for (uint32_t i = 0; i < size; i++)
+    {
+      m_names.push_back (Create<nnn::NNNAddress> (MakeName (i, depth, fanOut, "")));
+      m_queries.push_back (Create<nnn::NNNAddress> (MakeName (i, depth, fanOut, ".f")));
+      m_newNames.push_back (Create<nnn::NNNAddress> (MakeName (i, depth, fanOut, ".e")));
+    }
+
+  for (uint32_t i = 0; i < 2 * size; i++)
+    {
+      Ptr<nnn::Interest> interest = Create<nnn::Interest> ();
+      interest->SetName (Create<icn::Name> (MakeIcnName (i % size, depth, fanOut, (i < size) ? "" : "/new")));
+      interest->SetNonce (i);
+      interest->SetInterestLifetime (Seconds (2));
+      (i < size ? m_interests : m_newInterests).push_back (interest);
+
+      Ptr<nnn::Data> data = Create<nnn::Data> (Create<Packet> (1024));
+      data->SetName (Create<icn::Name> (interest->GetName ()));
+      m_data.push_back (data);
+    }
+
+  // A node with one face and a default route, for the PIT to find a FIB entry
+  m_node = CreateObject<Node> ();
+  Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+  device->SetAddress (Mac48Address::Allocate ());
+  m_node->AddDevice (device);
+
+  std::ostringstream csSize;
+  csSize << size;
+
+  nnn::NNNStackHelper stack;
+  stack.SetDefaultRoutes (true);
+  stack.SetPit ("ns3::nnn::pit::Persistent", "MaxSize", "0", "PitEntryPruningTimout", "0s");
+  stack.SetContentStore ("ns3::nnn::cs::Lru", "MaxSize", csSize.str ());
+  stack.Install (m_node);
+
+  Ptr<nnn::Face> face = m_node->GetObject<nnn::L3Protocol> ()->GetFace (0);
+
+  m_nnst = m_node->GetObject<nnn::NNST> ();
+  m_nnpt = m_node->GetObject<nnn::NNPT> ();
+  m_pit = m_node->GetObject<nnn::Pit> ();
+  m_cs = m_node->GetObject<nnn::ContentStore> ();
+  m_buffer = CreateObject<nnn::PDUBuffer> (Seconds (1000000));
+  m_pushBuffer = CreateObject<nnn::PDUBuffer> (Seconds (1000000));
+
+  for (uint32_t i = 0; i < size; i++)
+    {
+      m_nnst->Add (m_names[i], face, poa, lease, 1);
+      m_nnpt->addEntry (m_names[i], m_newNames[i], lease);
+      m_pit->Create (m_interests[i]);
+      m_cs->Add (m_data[i]);
+      m_buffer->AddDestination (*m_names[i]);
+      m_pushBuffer->AddDestination (*m_names[i]);
+    }
+
+  for (uint32_t k = 0; k < POOL; k++)
+    {
+      const nnn::NNNAddress &name = *m_names[k % size];
+      const nnn::NNNAddress &other = *m_newNames[(k * 7) % size];
+      Ptr<Packet> payload = icn::Wire::FromInterest (m_interests[k % size]);
+
+      Ptr<nnn::NULLp> null_p = Create<nnn::NULLp> ();
+      null_p->SetLifetime (Seconds (2));
+      null_p->SetPDUPayloadType (nnn::ICN_NNN);
+      null_p->SetPayload (payload);
+      m_pdus[PDU_NULLP].push_back (null_p);
+
+      Ptr<nnn::SO> so_p = Create<nnn::SO> ();
+      so_p->SetName (name);
+      so_p->SetLifetime (Seconds (2));
+      so_p->SetPDUPayloadType (nnn::ICN_NNN);
+      so_p->SetPayload (payload);
+      m_pdus[PDU_SO].push_back (so_p);
+
+      Ptr<nnn::DO> do_p = Create<nnn::DO> ();
+      do_p->SetName (name);
+      do_p->SetLifetime (Seconds (2));
+      do_p->SetPDUPayloadType (nnn::ICN_NNN);
+      do_p->SetPayload (payload);
+      m_pdus[PDU_DO].push_back (do_p);
+
+      Ptr<nnn::DU> du_p = Create<nnn::DU> ();
+      du_p->SetSrcName (name);
+      du_p->SetDstName (other);
+      du_p->SetLifetime (Seconds (2));
+      du_p->SetPDUPayloadType (nnn::ICN_NNN);
+      du_p->SetPayload (payload);
+      m_pdus[PDU_DU].push_back (du_p);
+
+      Ptr<nnn::EN> en_p = Create<nnn::EN> ();
+      en_p->SetLifetime (Seconds (2));
+      en_p->AddPoa (poa);
+      m_pdus[PDU_EN].push_back (en_p);
+
+      Ptr<nnn::AEN> aen_p = Create<nnn::AEN> ();
+      aen_p->SetName (name);
+      aen_p->SetLifetime (Seconds (2));
+      aen_p->SetLeasetime (lease);
+      aen_p->AddPoa (poa);
+      m_pdus[PDU_AEN].push_back (aen_p);
+
+      Ptr<nnn::REN> ren_p = Create<nnn::REN> ();
+      ren_p->SetName (name);
+      ren_p->SetLifetime (Seconds (2));
+      ren_p->SetRemainLease (lease);
+      ren_p->AddPoa (poa);
+      m_pdus[PDU_REN].push_back (ren_p);
+
+      Ptr<nnn::DEN> den_p = Create<nnn::DEN> ();
+      den_p->SetName (name);
+      den_p->SetLifetime (Seconds (2));
+      den_p->AddPoa (poa);
+      m_pdus[PDU_DEN].push_back (den_p);
+
+      Ptr<nnn::INF> inf_p = Create<nnn::INF> ();
+      inf_p->SetOldName (name);
+      inf_p->SetNewName (other);
+      inf_p->SetLifetime (Seconds (2));
+      inf_p->SetRemainLease (lease);
+      m_pdus[PDU_INF].push_back (inf_p);
+
+      Ptr<nnn::OEN> oen_p = Create<nnn::OEN> (name);
+      oen_p->SetSrcName (other);
+      oen_p->SetLifetime (Seconds (2));
+      oen_p->SetLeasetime (lease);
+      oen_p->AddPoa (poa);
+      m_pdus[PDU_OEN].push_back (oen_p);
+
+      m_interestWires.push_back (icn::Wire::FromInterest (m_interests[k % size]));
+      m_dataWires.push_back (icn::Wire::FromData (m_data[k % size]));
+      m_interestWireStrs.push_back (icn::Wire::FromInterestStr (m_interests[k % size]));
+      m_dataWireStrs.push_back (icn::Wire::FromDataStr (m_data[k % size]));
+      m_nameWires.push_back (nnn::Wire::FromName (m_names[k % size]));
+      m_icnNameWires.push_back (icn::Wire::FromName (m_interests[k % size]->GetNamePtr ()));
+    }
+
+  for (uint32_t k = 0; k < POOL; k++)
+    {
+      m_wires[PDU_NULLP].push_back (nnn::Wire::FromNULLp (StaticCast<nnn::NULLp> (m_pdus[PDU_NULLP][k])));
+      m_wires[PDU_SO].push_back (nnn::Wire::FromSO (StaticCast<nnn::SO> (m_pdus[PDU_SO][k])));
+      m_wires[PDU_DO].push_back (nnn::Wire::FromDO (StaticCast<nnn::DO> (m_pdus[PDU_DO][k])));
+      m_wires[PDU_DU].push_back (nnn::Wire::FromDU (StaticCast<nnn::DU> (m_pdus[PDU_DU][k])));
+      m_wires[PDU_EN].push_back (nnn::Wire::FromEN (StaticCast<nnn::EN> (m_pdus[PDU_EN][k])));
+      m_wires[PDU_AEN].push_back (nnn::Wire::FromAEN (StaticCast<nnn::AEN> (m_pdus[PDU_AEN][k])));
+      m_wires[PDU_REN].push_back (nnn::Wire::FromREN (StaticCast<nnn::REN> (m_pdus[PDU_REN][k])));
+      m_wires[PDU_DEN].push_back (nnn::Wire::FromDEN (StaticCast<nnn::DEN> (m_pdus[PDU_DEN][k])));
+      m_wires[PDU_INF].push_back (nnn::Wire::FromINF (StaticCast<nnn::INF> (m_pdus[PDU_INF][k])));
+      m_wires[PDU_OEN].push_back (nnn::Wire::FromOEN (StaticCast<nnn::OEN> (m_pdus[PDU_OEN][k])));
+
+      for (uint32_t t = 0; t < PDU_TYPES; t++)
+	{
+	  m_wireStrs[t].push_back (nnn::PacketToBuffer (m_wires[t][k]));
+	}
+    }
+
+  for (uint32_t i = 0; i < size; i++)
+    {
+      for (uint32_t q = 0; q < QUEUE; q++)
+	{
+	  m_buffer->PushSO (*m_names[i], StaticCast<nnn::SO> (m_pdus[PDU_SO][(i + q) % POOL]));
+	}
+    }
+}
+
+Fixture::~Fixture ()
+{
+  m_buffer->Dispose ();
+  m_pushBuffer->Dispose ();
+  m_node->Dispose ();
+}
+
+typedef uint64_t (*Operation) (Fixture &f, uint32_t i);
+
+//////////////////////////////////////////////////////////////////////
+// Tables
+//////////////////////////////////////////////////////////////////////
+
+static uint64_t
+NnstClosestSector (Fixture &f, uint32_t i)
+{
+  return f.m_nnst->ClosestSector (*f.m_queries[i % f.m_size]) != 0;
+}
+
+static uint64_t
+NnstClosestSectorNameInfo (Fixture &f, uint32_t i)
+{
+  return f.m_nnst->ClosestSectorNameInfo (f.m_queries[i % f.m_size]) != 0;
+}
+
+static uint64_t
+NnstClosestSectorFaceInfo (Fixture &f, uint32_t i)
+{
+  return f.m_nnst->ClosestSectorFaceInfo (f.m_queries[i % f.m_size], 0).first != 0;
+}
+
+static uint64_t
+NnstOneHopNameInfo (Fixture &f, uint32_t i)
+{
+  return f.m_nnst->OneHopNameInfo (f.m_names[i % f.m_size]).size ();
+}
+
+static uint64_t
+NnstOneHopFaceInfo (Fixture &f, uint32_t i)
+{
+  return f.m_nnst->OneHopFaceInfo (f.m_names[i % f.m_size], 0).size ();
+}
+
+static uint64_t
+NnstOneHopSubSectorNameInfo (Fixture &f, uint32_t i)
+{
+  return f.m_nnst->OneHopSubSectorNameInfo (f.m_names[i % f.m_size]).size ();
+}
+
+static uint64_t
+NnstOneHopSubSectorFaceInfo (Fixture &f, uint32_t i)
+{
+  return f.m_nnst->OneHopSubSectorFaceInfo (f.m_names[i % f.m_size], 0).size ();
+}
+
+static uint64_t
+NnstOneHopParentSectorNameInfo (Fixture &f, uint32_t i)
+{
+  return f.m_nnst->OneHopParentSectorNameInfo (f.m_queries[i % f.m_size]).size ();
+}
+
+static uint64_t
+NnstOneHopParentSectorFaceInfo (Fixture &f, uint32_t i)
+{
+  return f.m_nnst->OneHopParentSectorFaceInfo (f.m_queries[i % f.m_size], 0).size ();
+}
+
+// Half of the lookups miss
+static uint64_t
+NnptFoundOldName (Fixture &f, uint32_t i)
+{
+  const std::vector<Ptr<const nnn::NNNAddress> > &names = (i % 2) ? f.m_newNames : f.m_names;
+  return f.m_nnpt->foundOldName (names[(i / 2) % f.m_size]);
+}
+
+static uint64_t
+NnptFindPairedNamePtr (Fixture &f, uint32_t i)
+{
+  return f.m_nnpt->findPairedNamePtr (f.m_names[i % f.m_size]) != 0;
+}
+
+static uint64_t
+BufferPushSO (Fixture &f, uint32_t i)
+{
+  f.m_pushBuffer->PushSO (*f.m_names[i % f.m_size], StaticCast<nnn::SO> (f.m_pdus[PDU_SO][i % POOL]));
+  return 1;
+}
+
+static uint64_t
+BufferPushDO (Fixture &f, uint32_t i)
+{
+  f.m_pushBuffer->PushDO (*f.m_names[i % f.m_size], StaticCast<nnn::DO> (f.m_pdus[PDU_DO][i % POOL]));
+  return 1;
+}
+
+static uint64_t
+BufferPushDU (Fixture &f, uint32_t i)
+{
+  f.m_pushBuffer->PushDU (*f.m_names[i % f.m_size], StaticCast<nnn::DU> (f.m_pdus[PDU_DU][i % POOL]));
+  return 1;
+}
+
+static uint64_t
+BufferPopQueue (Fixture &f, uint32_t i)
+{
+  return f.m_buffer->PopQueue (*f.m_names[i % f.m_size]).size ();
+}
+
+static uint64_t
+PitLookup (Fixture &f, uint32_t i)
+{
+  return f.m_pit->Lookup (*f.m_interests[i % f.m_size]) != 0;
+}
+
+// The entry is erased right away to keep the size of the PIT
+static uint64_t
+PitCreate (Fixture &f, uint32_t i)
+{
+  Ptr<nnn::pit::Entry> entry = f.m_pit->Create (f.m_newInterests[i % f.m_size]);
+  if (entry != 0)
+    f.m_pit->MarkErased (entry);
+  return entry != 0;
+}
+
+static uint64_t
+CsLookup (Fixture &f, uint32_t i)
+{
+  return f.m_cs->Lookup (f.m_interests[i % f.m_size]) != 0;
+}
+
+// Cycles through twice as many Data as the store holds, so every Add evicts
+static uint64_t
+CsAdd (Fixture &f, uint32_t i)
+{
+  return f.m_cs->Add (f.m_data[(f.m_size + i) % (2 * f.m_size)]);
+}
+
+static uint64_t
+NameDistance (Fixture &f, uint32_t i)
+{
+  return f.m_names[i % f.m_size]->distance (*f.m_names[(i * 7) % f.m_size]);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Wire codecs
+//////////////////////////////////////////////////////////////////////
+
+template<class T, int Type, Ptr<Packet> (*From) (Ptr<const T>, int8_t)>
+static uint64_t
+Encode (Fixture &f, uint32_t i)
+{
+  Ptr<const T> pdu = StaticCast<const T> (f.m_pdus[Type][i % POOL]);
+  pdu->SetWire (0);
+  return From (pdu, nnn::Wire::WIRE_FORMAT_DEFAULT)->GetSize ();
+}
+
+template<class T, int Type, Ptr<T> (*To) (Ptr<Packet>, int8_t)>
+static uint64_t
+Decode (Fixture &f, uint32_t i)
+{
+  return To (f.m_wires[Type][i % POOL]->Copy (), nnn::Wire::WIRE_FORMAT_AUTODETECT) != 0;
+}
+
+template<class T, int Type, std::string (*From) (Ptr<const T>, int8_t)>
+static uint64_t
+EncodeStr (Fixture &f, uint32_t i)
+{
+  Ptr<const T> pdu = StaticCast<const T> (f.m_pdus[Type][i % POOL]);
+  pdu->SetWire (0);
+  return From (pdu, nnn::Wire::WIRE_FORMAT_DEFAULT).size ();
+}
+
+template<class T, int Type, Ptr<T> (*To) (const std::string &, int8_t)>
+static uint64_t
+DecodeStr (Fixture &f, uint32_t i)
+{
+  return To (f.m_wireStrs[Type][i % POOL], nnn::Wire::WIRE_FORMAT_AUTODETECT) != 0;
+}
+
+static uint64_t
+EncodeInterest (Fixture &f, uint32_t i)
+{
+  Ptr<const nnn::Interest> interest = f.m_interests[i % f.m_size];
+  interest->SetWire (0);
+  return icn::Wire::FromInterest (interest)->GetSize ();
+}
+
+static uint64_t
+DecodeInterest (Fixture &f, uint32_t i)
+{
+  return icn::Wire::ToInterest (f.m_interestWires[i % POOL]->Copy ()) != 0;
+}
+
+static uint64_t
+EncodeInterestStr (Fixture &f, uint32_t i)
+{
+  Ptr<const nnn::Interest> interest = f.m_interests[i % f.m_size];
+  interest->SetWire (0);
+  return icn::Wire::FromInterestStr (interest).size ();
+}
+
+static uint64_t
+DecodeInterestStr (Fixture &f, uint32_t i)
+{
+  return icn::Wire::ToInterestStr (f.m_interestWireStrs[i % POOL]) != 0;
+}
+
+static uint64_t
+EncodeData (Fixture &f, uint32_t i)
+{
+  Ptr<const nnn::Data> data = f.m_data[i % f.m_size];
+  data->SetWire (0);
+  return icn::Wire::FromData (data)->GetSize ();
+}
+
+static uint64_t
+DecodeData (Fixture &f, uint32_t i)
+{
+  return icn::Wire::ToData (f.m_dataWires[i % POOL]->Copy ()) != 0;
+}
+
+static uint64_t
+EncodeDataStr (Fixture &f, uint32_t i)
+{
+  Ptr<const nnn::Data> data = f.m_data[i % f.m_size];
+  data->SetWire (0);
+  return icn::Wire::FromDataStr (data).size ();
+}
+
+static uint64_t
+DecodeDataStr (Fixture &f, uint32_t i)
+{
+  return icn::Wire::ToDataStr (f.m_dataWireStrs[i % POOL]) != 0;
+}
+
+static uint64_t
+EncodeName (Fixture &f, uint32_t i)
+{
+  return nnn::Wire::FromName (f.m_names[i % f.m_size]).size ();
+}
+
+static uint64_t
+DecodeName (Fixture &f, uint32_t i)
+{
+  return nnn::Wire::ToName (f.m_nameWires[i % POOL])->size ();
+}
+
+static uint64_t
+EncodeIcnName (Fixture &f, uint32_t i)
+{
+  return icn::Wire::FromName (f.m_interests[i % f.m_size]->GetNamePtr ()).size ();
+}
+
+static uint64_t
+DecodeIcnName (Fixture &f, uint32_t i)
+{
+  return icn::Wire::ToName (f.m_icnNameWires[i % POOL])->size ();
+}
+
+struct Benchmark
+{
+  const char *name;
+  Operation operation;
+};
+
+// Benchmarks reading a table run before the ones changing it
+static const Benchmark g_benchmarks[] =
+{
+  { "nnst_closest_sector",                &NnstClosestSector },
+  { "nnst_closest_sector_name_info",      &NnstClosestSectorNameInfo },
+  { "nnst_closest_sector_face_info",      &NnstClosestSectorFaceInfo },
+  { "nnst_one_hop_name_info",             &NnstOneHopNameInfo },
+  { "nnst_one_hop_face_info",             &NnstOneHopFaceInfo },
+  { "nnst_one_hop_sub_sector_name_info",  &NnstOneHopSubSectorNameInfo },
+  { "nnst_one_hop_sub_sector_face_info",  &NnstOneHopSubSectorFaceInfo },
+  { "nnst_one_hop_parent_sector_name_info", &NnstOneHopParentSectorNameInfo },
+  { "nnst_one_hop_parent_sector_face_info", &NnstOneHopParentSectorFaceInfo },
+  { "nnpt_found_old_name",                &NnptFoundOldName },
+  { "nnpt_find_paired_name_ptr",          &NnptFindPairedNamePtr },
+  { "pdu_buffer_pop_queue",               &BufferPopQueue },
+  { "pdu_buffer_push_so",                 &BufferPushSO },
+  { "pdu_buffer_push_do",                 &BufferPushDO },
+  { "pdu_buffer_push_du",                 &BufferPushDU },
+  { "pit_lookup",                         &PitLookup },
+  { "pit_create_erase",                   &PitCreate },
+  { "cs_lookup",                          &CsLookup },
+  { "cs_add",                             &CsAdd },
+  { "name_distance",                      &NameDistance },
+  { "wire_from_nullp",     &Encode<nnn::NULLp, PDU_NULLP, &nnn::Wire::FromNULLp> },
+  { "wire_to_nullp",       &Decode<nnn::NULLp, PDU_NULLP, &nnn::Wire::ToNULLp> },
+  { "wire_from_so",        &Encode<nnn::SO, PDU_SO, &nnn::Wire::FromSO> },
+  { "wire_to_so",          &Decode<nnn::SO, PDU_SO, &nnn::Wire::ToSO> },
+  { "wire_from_do",        &Encode<nnn::DO, PDU_DO, &nnn::Wire::FromDO> },
+  { "wire_to_do",          &Decode<nnn::DO, PDU_DO, &nnn::Wire::ToDO> },
+  { "wire_from_du",        &Encode<nnn::DU, PDU_DU, &nnn::Wire::FromDU> },
+  { "wire_to_du",          &Decode<nnn::DU, PDU_DU, &nnn::Wire::ToDU> },
+  { "wire_from_en",        &Encode<nnn::EN, PDU_EN, &nnn::Wire::FromEN> },
+  { "wire_to_en",          &Decode<nnn::EN, PDU_EN, &nnn::Wire::ToEN> },
+  { "wire_from_aen",       &Encode<nnn::AEN, PDU_AEN, &nnn::Wire::FromAEN> },
+  { "wire_to_aen",         &Decode<nnn::AEN, PDU_AEN, &nnn::Wire::ToAEN> },
+  { "wire_from_ren",       &Encode<nnn::REN, PDU_REN, &nnn::Wire::FromREN> },
+  { "wire_to_ren",         &Decode<nnn::REN, PDU_REN, &nnn::Wire::ToREN> },
+  { "wire_from_den",       &Encode<nnn::DEN, PDU_DEN, &nnn::Wire::FromDEN> },
+  { "wire_to_den",         &Decode<nnn::DEN, PDU_DEN, &nnn::Wire::ToDEN> },
+  { "wire_from_inf",       &Encode<nnn::INF, PDU_INF, &nnn::Wire::FromINF> },
+  { "wire_to_inf",         &Decode<nnn::INF, PDU_INF, &nnn::Wire::ToINF> },
+  { "wire_from_oen",       &Encode<nnn::OEN, PDU_OEN, &nnn::Wire::FromOEN> },
+  { "wire_to_oen",         &Decode<nnn::OEN, PDU_OEN, &nnn::Wire::ToOEN> },
+  { "wire_from_nullp_str", &EncodeStr<nnn::NULLp, PDU_NULLP, &nnn::Wire::FromNULLpStr> },
+  { "wire_to_nullp_str",   &DecodeStr<nnn::NULLp, PDU_NULLP, &nnn::Wire::ToNULLpStr> },
+  { "wire_from_so_str",    &EncodeStr<nnn::SO, PDU_SO, &nnn::Wire::FromSOStr> },
+  { "wire_to_so_str",      &DecodeStr<nnn::SO, PDU_SO, &nnn::Wire::ToSOStr> },
+  { "wire_from_do_str",    &EncodeStr<nnn::DO, PDU_DO, &nnn::Wire::FromDOStr> },
+  { "wire_to_do_str",      &DecodeStr<nnn::DO, PDU_DO, &nnn::Wire::ToDOStr> },
+  { "wire_from_du_str",    &EncodeStr<nnn::DU, PDU_DU, &nnn::Wire::FromDUStr> },
+  { "wire_to_du_str",      &DecodeStr<nnn::DU, PDU_DU, &nnn::Wire::ToDUStr> },
+  { "wire_from_en_str",    &EncodeStr<nnn::EN, PDU_EN, &nnn::Wire::FromENStr> },
+  { "wire_to_en_str",      &DecodeStr<nnn::EN, PDU_EN, &nnn::Wire::ToENStr> },
+  { "wire_from_aen_str",   &EncodeStr<nnn::AEN, PDU_AEN, &nnn::Wire::FromAENStr> },
+  { "wire_to_aen_str",     &DecodeStr<nnn::AEN, PDU_AEN, &nnn::Wire::ToAENStr> },
+  { "wire_from_ren_str",   &EncodeStr<nnn::REN, PDU_REN, &nnn::Wire::FromRENStr> },
+  { "wire_to_ren_str",     &DecodeStr<nnn::REN, PDU_REN, &nnn::Wire::ToRENStr> },
+  { "wire_from_den_str",   &EncodeStr<nnn::DEN, PDU_DEN, &nnn::Wire::FromDENStr> },
+  { "wire_to_den_str",     &DecodeStr<nnn::DEN, PDU_DEN, &nnn::Wire::ToDENStr> },
+  { "wire_from_inf_str",   &EncodeStr<nnn::INF, PDU_INF, &nnn::Wire::FromINFStr> },
+  { "wire_to_inf_str",     &DecodeStr<nnn::INF, PDU_INF, &nnn::Wire::ToINFStr> },
+  { "wire_from_oen_str",   &EncodeStr<nnn::OEN, PDU_OEN, &nnn::Wire::FromOENStr> },
+  { "wire_to_oen_str",     &DecodeStr<nnn::OEN, PDU_OEN, &nnn::Wire::ToOENStr> },
+  { "wire_from_interest",     &EncodeInterest },
+  { "wire_to_interest",       &DecodeInterest },
+  { "wire_from_interest_str", &EncodeInterestStr },
+  { "wire_to_interest_str",   &DecodeInterestStr },
+  { "wire_from_data",         &EncodeData },
+  { "wire_to_data",           &DecodeData },
+  { "wire_from_data_str",     &EncodeDataStr },
+  { "wire_to_data_str",       &DecodeDataStr },
+  { "wire_from_name",         &EncodeName },
+  { "wire_to_name",           &DecodeName },
+  { "wire_from_icn_name",     &EncodeIcnName },
+  { "wire_to_icn_name",       &DecodeIcnName },
+};
+
+// Nearest rank percentile of sorted samples
+static double
+Percentile (const std::vector<double> &sorted, double p)
+{
+  size_t rank = static_cast<size_t> (std::ceil (p * sorted.size ()));
+  return sorted[std::max<size_t> (rank, 1) - 1];
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string sizes = "100,1000,10000";
+  std::string depths = "2,4,8";
+  std::string filter;
+  std::string label;
+  uint32_t batch = 10000;
+  uint32_t warmup = 2;
+  uint32_t repetitions = 15;
+
+  CommandLine cmd;
+  cmd.AddValue ("sizes", "Comma separated numbers of entries of the tables", sizes);
+  cmd.AddValue ("depths", "Comma separated numbers of labels of the names", depths);
+  cmd.AddValue ("filter", "Only run the benchmarks whose name contains this string", filter);
+  cmd.AddValue ("label", "Label of the run written with every result, for instance a commit", label);
+  cmd.AddValue ("batch", "Calls per timed batch", batch);
+  cmd.AddValue ("warmup", "Batches run before timing", warmup);
+  cmd.AddValue ("repetitions", "Timed batches", repetitions);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (batch == 0 || repetitions == 0, "Batches and repetitions should not be empty");
+
+  std::vector<uint32_t> sizeList = ParseList (sizes);
+  std::vector<uint32_t> depthList = ParseList (depths);
+  uint32_t benchmarks = sizeof (g_benchmarks) / sizeof (g_benchmarks[0]);
+  uint64_t sink = 0;
+
+  std::cout << "[" << std::endl;
+  bool first = true;
+
+  for (size_t s = 0; s < sizeList.size (); s++)
+    {
+      for (size_t d = 0; d < depthList.size (); d++)
+	{
+	  NS_ABORT_MSG_IF (sizeList[s] == 0 || depthList[d] == 0, "Sizes and depths should be positive");
+
+	  Fixture fixture (sizeList[s], depthList[d]);
+
+	  for (uint32_t b = 0; b < benchmarks; b++)
+	    {
+	      if (!filter.empty () && std::string (g_benchmarks[b].name).find (filter) == std::string::npos)
+		continue;
+
+	      Operation operation = g_benchmarks[b].operation;
+	      std::vector<double> samples;
+	      uint32_t i = 0;
+
+	      for (uint32_t r = 0; r < warmup + repetitions; r++)
+		{
+		  uint64_t start = NowNs ();
+		  for (uint32_t n = 0; n < batch; n++, i++)
+		    {
+		      sink += operation (fixture, i);
+		    }
+		  uint64_t elapsed = NowNs () - start;
+
+		  if (r >= warmup)
+		    samples.push_back (static_cast<double> (elapsed) / batch);
+		}
+
+	      std::sort (samples.begin (), samples.end ());
+	      double mean = 0;
+	      for (size_t k = 0; k < samples.size (); k++)
+		{
+		  mean += samples[k] / samples.size ();
+		}
+
+	      std::cout << (first ? "  " : ", ")
+			<< "{\"benchmark\": \"" << g_benchmarks[b].name << "\""
+			<< ", \"label\": \"" << label << "\""
+			<< ", \"size\": " << sizeList[s]
+			<< ", \"depth\": " << depthList[d]
+			<< ", \"batch\": " << batch
+			<< ", \"repetitions\": " << repetitions
+			<< ", \"ns_per_op\": {\"min\": " << samples.front ()
+			<< ", \"p50\": " << Percentile (samples, 0.5)
+			<< ", \"p90\": " << Percentile (samples, 0.9)
+			<< ", \"p99\": " << Percentile (samples, 0.99)
+			<< ", \"max\": " << samples.back ()
+			<< ", \"mean\": " << mean
+			<< "}}" << std::endl;
+	      first = false;
+	    }
+	}
+    }
+
+  std::cout << "]" << std::endl;
+  g_sink = sink;
+
+  Simulator::Destroy ();
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-name-benchmark.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-name-benchmark.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-name-benchmark.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+// Micro-benchmarks for the 3N name operations on the forwarding hot path:
+// nnnSIM name serialization and deserialization, the label comparisons used
+// by operator== and the sector predicates, and the distance used to pick the
+// closest NNST entry.
+//
+//   ./waf --run "nnn-name-benchmark --count=1000000"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#include "ns3/nnn-naming.h"
+#include "ns3/nnn-nnnsim-wire.h"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+// Results of the measured operations are stored here so that they are not
+// optimized away
+static volatile uint64_t g_sink = 0;
+
+static void
+Report (const std::string &operation, uint32_t count, int64_t ms)
+{
+  std::cout << operation << "\t" << count << "\t" << ms << "\t" << (ms * 1000000.0) / count << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t count = 1000000;
+  uint32_t depth = 4;
+
+  CommandLine cmd;
+  cmd.AddValue ("count", "Number of times each operation is run", count);
+  cmd.AddValue ("depth", "Number of labels of the names", depth);
+  cmd.Parse (argc, argv);
+
+  // Names spread over a hierarchy of the given depth
+  std::vector<nnn::NNNAddress> names;
+  std::vector<nnn::NNNAddress> sectors;
+  for (uint32_t i = 0; i < 256; i++)
+    {
+      std::ostringstream os;
+      os << std::hex << (i % 4);
+      for (uint32_t j = 1; j < depth; j++)
+	{
+	  os << "." << std::hex << ((i >> (2 * j)) % 4 + j * 0x100);
+	}
+      names.push_back (nnn::NNNAddress (os.str ()));
+      sectors.push_back (names.back ().getSectorName ());
+    }
+
+  // Encoded form of every name
+  std::vector<Buffer> encoded (names.size ());
+  for (uint32_t i = 0; i < names.size (); i++)
+    {
+      encoded[i].AddAtStart (nnn::wire::NnnSim::SerializedSizeName (names[i]));
+      Buffer::Iterator it = encoded[i].Begin ();
+      nnn::wire::NnnSim::SerializeName (it, names[i]);
+
+      it = encoded[i].Begin ();
+      NS_ABORT_MSG_IF (*nnn::wire::NnnSim::DeserializeName (it) != names[i], "Name does not survive the round trip");
+    }
+
+  SystemWallClockMs clock;
+  uint64_t sink = 0;
+
+  std::cout << "operation\tcount\twall_ms\tns_per_op" << std::endl;
+
+  Buffer buffer;
+  buffer.AddAtStart (nnn::wire::NnnSim::SerializedSizeName (names.back ()));
+  clock.Start ();
+  for (uint32_t i = 0; i < count; i++)
+    {
+      Buffer::Iterator it = buffer.Begin ();
+      sink += nnn::wire::NnnSim::SerializeName (it, names[i % names.size ()]);
+    }
+  Report ("serialize", count, clock.End ());
+
+  clock.Start ();
+  for (uint32_t i = 0; i < count; i++)
+    {
+      Buffer::Iterator it = encoded[i % encoded.size ()].Begin ();
+      sink += nnn::wire::NnnSim::DeserializeName (it)->size ();
+    }
+  Report ("deserialize", count, clock.End ());
+
+  clock.Start ();
+  for (uint32_t i = 0; i < count; i++)
+    {
+      sink += (names[i % names.size ()] == names[(i * 7) % names.size ()]);
+    }
+  Report ("compare_labels", count, clock.End ());
+
+  clock.Start ();
+  for (uint32_t i = 0; i < count; i++)
+    {
+      sink += names[i % names.size ()].isSubSector (sectors[(i * 7) % sectors.size ()]);
+    }
+  Report ("is_sub_sector", count, clock.End ());
+
+  clock.Start ();
+  for (uint32_t i = 0; i < count; i++)
+    {
+      sink += names[i % names.size ()].distance (names[(i * 7) % names.size ()]);
+    }
+  Report ("distance", count, clock.End ());
+
+  g_sink = sink;
+
+  return 0;
+}
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-replication-sweep.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-replication-sweep.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-replication-sweep.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+// Parameter sweep over independent replicas with the ReplicationRunner.
+//
+// A chain of nodes where a consumer at one end requests content from a
+// producer at the other is run for every combination of consumer
+// retransmission timer, 3N lease time and content store size, with --runs
+// seeds each. The replicas run in parallel processes, --jobs at a time (one
+// per core by default). Every replica writes its rate and application delay
+// traces in its own directory under --output, which also ends up with a
+// summary of the replicas and the traces of all of them in one file each:
+//
+//   ./waf --run "nnn-replication-sweep --runs=10 --retx=50ms,100ms --csSize=10,100 --output=sweep"
+//
+//   sweep/replicas.txt         run, values, exit status and wall time of every replica
+//   sweep/rate-trace.txt       rate traces of every replica
+//   sweep/app-delays-trace.txt application delays of every replica
+//   sweep/replica-<n>/         outputs of replica n
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/nnn-app-delay-tracer.h"
+#include "ns3/nnn-app-helper.h"
+#include "ns3/nnn-global-routing-helper.h"
+#include "ns3/nnn-l3-rate-tracer.h"
+#include "ns3/nnn-replication-runner.h"
+#include "ns3/nnn-sector-hierarchy-helper.h"
+#include "ns3/nnn-stack-helper.h"
+
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+
+static uint32_t g_nodes = 8;
+static double g_frequency = 100.0;
+static double g_stop = 20.0;
+
+static void
+Scenario (const std::string &directory)
+{
+  NodeContainer chain;
+  chain.Create (g_nodes);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("5ms"));
+
+  for (uint32_t i = 0; i + 1 < g_nodes; i++)
+    {
+      p2p.Install (chain.Get (i), chain.Get (i + 1));
+    }
+
+  nnn::NNNStackHelper stack;
+  stack.Install (chain);
+
+  nnn::SectorHierarchyHelper hierarchy;
+  std::string name = "1";
+  for (uint32_t i = 0; i < g_nodes; i++)
+    {
+      hierarchy.AddNode (chain.Get (i), name);
+      name += ".1";
+    }
+  hierarchy.Install ();
+
+  nnn::GlobalRoutingHelper routing;
+  routing.AddOrigin ("/sweep", chain.Get (0));
+  routing.CalculateRoutes ();
+
+  nnn::AppHelper producer ("ns3::nnn::ICNProducer");
+  producer.SetPrefix ("/sweep");
+  producer.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producer.Install (chain.Get (0));
+
+  nnn::AppHelper consumer ("ns3::nnn::ICNConsumerZipfMandelbrot");
+  consumer.SetPrefix ("/sweep");
+  consumer.SetAttribute ("Frequency", DoubleValue (g_frequency));
+  consumer.Install (chain.Get (g_nodes - 1));
+
+  nnn::L3RateTracer::InstallAll (directory + "/rate-trace.txt", Seconds (1.0));
+  nnn::AppDelayTracer::InstallAll (directory + "/app-delays-trace.txt");
+
+  Simulator::Stop (Seconds (g_stop));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t runs = 5;
+  uint32_t jobs = 0;
+  std::string output = "sweep";
+  std::string retx = "50ms,100ms";
+  std::string leases = "300s";
+  std::string csSize = "10,100";
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of nodes in the chain", g_nodes);
+  cmd.AddValue ("frequency", "Interests per second sent by the consumer", g_frequency);
+  cmd.AddValue ("stop", "Simulated seconds of every replica", g_stop);
+  cmd.AddValue ("runs", "Number of RngRun values per combination of parameters", runs);
+  cmd.AddValue ("jobs", "Replicas running at the same time, 0 for one per core", jobs);
+  cmd.AddValue ("output", "Directory of the results", output);
+  cmd.AddValue ("retx", "Comma separated consumer retransmission timers", retx);
+  cmd.AddValue ("leases", "Comma separated 3N lease times", leases);
+  cmd.AddValue ("csSize", "Comma separated content store sizes", csSize);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (g_nodes < 2, "The chain needs at least 2 nodes");
+
+  nnn::ReplicationRunner runner;
+  runner.SetScenario (MakeCallback (&Scenario));
+  runner.SetJobs (jobs);
+  runner.SetOutputDirectory (output);
+  runner.SetRuns (1, runs);
+  runner.AddParameter ("ns3::nnn::ICNConsumer::RetxTimer", retx);
+  runner.AddParameter ("ns3::nnn::ForwardingStrategy::3NLeasetime", leases);
+  runner.AddParameter ("ns3::nnn::cs::Lru::MaxSize", csSize);
+
+  uint32_t failed = runner.Run ();
+
+  std::cout << "Results in " << output << ", " << failed << " replicas failed" << std::endl;
+
+  return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,542 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-scenario-benchmark.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-scenario-benchmark.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-scenario-benchmark.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+// Reference scenarios to follow the cost of whole simulations over time.
+//
+//   line   A chain of --size nodes. A CBR consumer at one end requests
+//          content from a producer at the other.
+//   tree   A binary tree of depth --size with two mobile nodes under every
+//          leaf router. The mobile nodes request content from a producer at
+//          the root and move between two neighbouring leaf routers every
+//          --handoff seconds.
+//   grid   A --size x --size grid with LRU content stores of --csSize
+//          entries. The nodes of the last row request a Zipf-Mandelbrot
+//          catalog from a producer in the first corner.
+//   storm  --size nodes attached to one root all enroll within --window
+//          seconds.
+//
+// The 3N names of the line, tree and grid are loaded at t=0 with the
+// SectorHierarchyHelper and their FIBs filled with the GlobalRoutingHelper,
+// so the runs measure forwarding and not enrollment. Only the storm enrolls.
+//
+// Every run prints one JSON object with the wall clock time of the
+// simulation, the number of simulator events and of 3N PDUs sent by the
+// forwarding strategies per wall clock second, the peak resident set size of
+// the process and the size of every table at the end of the simulation. Run
+// one scenario per process, the peak RSS is the one of the whole process:
+//
+//   for s in line tree grid storm; do
+//     ./waf --run "nnn-scenario-benchmark --scenario=$s" >> scenarios.json
+//   done
+//
+// No baseline scenarios.json has been recorded yet: the benchmark was
+// written without an ns-3 tree to build and run it against. The first run
+// of the loop above on a reference machine gives the baseline later
+// changes are compared with.
+//
+// With nnnSIM configured with --nnnsim-profile, --stages=<file> writes the
+// time spent in every stage of the forwarding path (see StageProfiler).
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/nnn-address.h"
+#include "ns3/nnn-app-helper.h"
+#include "ns3/nnn-fib.h"
+#include "ns3/nnn-forwarding-strategy.h"
+#include "ns3/nnn-global-routing-helper.h"
+#include "ns3/nnn-icn-content-store.h"
+#include "ns3/nnn-l3-protocol.h"
+#include "ns3/nnn-link-control-helper.h"
+#include "ns3/nnn-net-device-face.h"
+#include "ns3/nnn-nnpt.h"
+#include "ns3/nnn-nnst.h"
+#include "ns3/nnn-pdus.h"
+#include "ns3/nnn-pit.h"
+#include "ns3/nnn-sector-hierarchy-helper.h"
+#include "ns3/nnn-stack-helper.h"
+#include "ns3/nnn-stage-profiler.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+static uint64_t g_events = 0;
+static uint64_t g_pdus = 0;
+static uint64_t g_controlPdus = 0;
+
+namespace ns3
+{
+  /**
+   * Default scheduler counting the events the simulator runs
+   */
+  class CountingScheduler : public MapScheduler
+  {
+  public:
+    static TypeId
+    GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::CountingScheduler")
+	.SetParent<MapScheduler> ()
+	.AddConstructor<CountingScheduler> ()
+	;
+      return tid;
+    }
+
+    virtual Scheduler::Event
+    RemoveNext (void)
+    {
+      g_events++;
+      return MapScheduler::RemoveNext ();
+    }
+  };
+
+  NS_OBJECT_ENSURE_REGISTERED (CountingScheduler);
+}
+
+static const std::string g_prefix = "/bench";
+
+template<class T>
+static void
+CountPDU (uint64_t *counter, Ptr<const T>, Ptr<const nnn::Face>)
+{
+  (*counter)++;
+}
+
+static Ptr<nnn::Face>
+FaceTowards (Ptr<Node> node, Ptr<Node> other)
+{
+  Ptr<nnn::L3Protocol> nnn = node->GetObject<nnn::L3Protocol> ();
+
+  for (uint32_t faceId = 0; faceId < nnn->GetNFaces (); faceId++)
+    {
+      Ptr<nnn::NetDeviceFace> face = DynamicCast<nnn::NetDeviceFace> (nnn->GetFace (faceId));
+      if (face == 0 || face->GetNetDevice ()->GetChannel () == 0)
+	continue;
+
+      Ptr<Channel> channel = face->GetNetDevice ()->GetChannel ();
+      for (uint32_t i = 0; i < channel->GetNDevices (); i++)
+	{
+	  if (channel->GetDevice (i)->GetNode () == other)
+	    return face;
+	}
+    }
+
+  return 0;
+}
+
+static std::string
+ChildName (const std::string &parent, uint32_t child)
+{
+  std::ostringstream name;
+  name << parent << "." << child;
+  return name.str ();
+}
+
+// Move a mobile node from one point of attachment to the other and come back
+// after the same time
+static void
+Handoff (Ptr<Node> mobile, Ptr<Node> from, Ptr<Node> to, Time every)
+{
+  nnn::LinkControlHelper::FailLink (mobile, from);
+  nnn::LinkControlHelper::UpLink (mobile, to);
+
+  Ptr<nnn::Face> oldFace = FaceTowards (mobile, from);
+  Ptr<nnn::Face> newFace = FaceTowards (mobile, to);
+
+  mobile->GetObject<nnn::Fib> ()->RemoveFromAll (oldFace);
+  nnn::NNNStackHelper::AddRoute (mobile, g_prefix, newFace, 1);
+  mobile->GetObject<nnn::ForwardingStrategy> ()->NotifyNewPoA (newFace);
+
+  Simulator::Schedule (every, &Handoff, mobile, to, from, every);
+}
+
+static void
+BuildLine (NodeContainer &nodes, uint32_t size, double frequency)
+{
+  NS_ABORT_MSG_IF (size < 2, "The line needs at least 2 nodes");
+
+  nodes.Create (size);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1ms"));
+
+  for (uint32_t i = 0; i + 1 < size; i++)
+    {
+      p2p.Install (nodes.Get (i), nodes.Get (i + 1));
+    }
+
+  nnn::NNNStackHelper stack;
+  stack.Install (nodes);
+
+  nnn::SectorHierarchyHelper hierarchy;
+  std::string name = "1";
+  for (uint32_t i = 0; i < size; i++)
+    {
+      hierarchy.AddNode (nodes.Get (i), name);
+      name = ChildName (name, 1);
+    }
+  hierarchy.Install ();
+
+  nnn::GlobalRoutingHelper routing;
+  routing.AddOrigin (g_prefix, nodes.Get (0));
+  routing.CalculateRoutes ();
+
+  nnn::AppHelper producer ("ns3::nnn::ICNProducer");
+  producer.SetPrefix (g_prefix);
+  producer.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producer.Install (nodes.Get (0));
+
+  nnn::AppHelper consumer ("ns3::nnn::ICNConsumerCbr");
+  consumer.SetPrefix (g_prefix);
+  consumer.SetAttribute ("Frequency", DoubleValue (frequency));
+  consumer.Install (nodes.Get (size - 1));
+}
+
+static void
+BuildTree (NodeContainer &nodes, uint32_t depth, double frequency, double handoff)
+{
+  NS_ABORT_MSG_IF (depth < 1, "The tree needs a depth of at least 1");
+
+  // Routers are numbered as a binary heap, router r has children 2r + 1 and
+  // 2r + 2. Mobile node m starts under the leaf router m / 2
+  uint32_t routers = (1 << (depth + 1)) - 1;
+  uint32_t firstLeaf = (1 << depth) - 1;
+  uint32_t leaves = routers - firstLeaf;
+
+  nodes.Create (routers + 2 * leaves);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1ms"));
+
+  for (uint32_t r = 1; r < routers; r++)
+    {
+      p2p.Install (nodes.Get ((r - 1) / 2), nodes.Get (r));
+    }
+
+  // Every mobile node is linked to its leaf router and to the next one
+  for (uint32_t m = 0; m < 2 * leaves; m++)
+    {
+      uint32_t leaf = firstLeaf + m / 2;
+      uint32_t other = firstLeaf + (m / 2 + 1) % leaves;
+      p2p.Install (nodes.Get (routers + m), nodes.Get (leaf));
+      if (other != leaf)
+	p2p.Install (nodes.Get (routers + m), nodes.Get (other));
+    }
+
+  nnn::NNNStackHelper stack;
+  stack.Install (nodes);
+
+  std::vector<std::string> names (routers + 2 * leaves);
+  names[0] = "1";
+  for (uint32_t r = 1; r < routers; r++)
+    {
+      names[r] = ChildName (names[(r - 1) / 2], 2 - r % 2);
+    }
+  for (uint32_t m = 0; m < 2 * leaves; m++)
+    {
+      names[routers + m] = ChildName (names[firstLeaf + m / 2], 1 + m % 2);
+    }
+
+  nnn::SectorHierarchyHelper hierarchy;
+  for (uint32_t i = 0; i < names.size (); i++)
+    {
+      hierarchy.AddNode (nodes.Get (i), names[i]);
+    }
+  hierarchy.Install ();
+
+  // The second point of attachment is down until the first handoff
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  for (uint32_t m = 0; m < 2 * leaves; m++)
+    {
+      Ptr<Node> mobile = nodes.Get (routers + m);
+      Ptr<Node> leaf = nodes.Get (firstLeaf + m / 2);
+      Ptr<Node> other = nodes.Get (firstLeaf + (m / 2 + 1) % leaves);
+      if (other == leaf)
+	continue;
+
+      nnn::LinkControlHelper::FailLink (mobile, other);
+      Simulator::Schedule (Seconds (random->GetValue (0, handoff)), &Handoff,
+			   mobile, leaf, other, Seconds (handoff));
+    }
+
+  nnn::GlobalRoutingHelper routing;
+  routing.AddOrigin (g_prefix, nodes.Get (0));
+  routing.CalculateRoutes ();
+
+  nnn::AppHelper producer ("ns3::nnn::ICNProducer");
+  producer.SetPrefix (g_prefix);
+  producer.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producer.Install (nodes.Get (0));
+
+  nnn::AppHelper consumer ("ns3::nnn::ICNConsumerCbr");
+  consumer.SetPrefix (g_prefix);
+  consumer.SetAttribute ("Frequency", DoubleValue (frequency));
+  for (uint32_t m = 0; m < 2 * leaves; m++)
+    {
+      consumer.Install (nodes.Get (routers + m));
+    }
+}
+
+static void
+BuildGrid (NodeContainer &nodes, uint32_t side, double frequency, uint32_t csSize, uint32_t contents)
+{
+  NS_ABORT_MSG_IF (side < 2, "The grid needs at least 2 nodes per side");
+
+  nodes.Create (side * side);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1ms"));
+
+  for (uint32_t r = 0; r < side; r++)
+    {
+      for (uint32_t c = 0; c < side; c++)
+	{
+	  if (c + 1 < side)
+	    p2p.Install (nodes.Get (r * side + c), nodes.Get (r * side + c + 1));
+	  if (r + 1 < side)
+	    p2p.Install (nodes.Get (r * side + c), nodes.Get ((r + 1) * side + c));
+	}
+    }
+
+  std::ostringstream maxSize;
+  maxSize << csSize;
+
+  nnn::NNNStackHelper stack;
+  stack.SetContentStore ("ns3::nnn::cs::Lru", "MaxSize", maxSize.str ());
+  stack.Install (nodes);
+
+  // Sectors follow the rows from the first column, which hangs from the corner
+  std::vector<std::string> names (side * side);
+  nnn::SectorHierarchyHelper hierarchy;
+  for (uint32_t r = 0; r < side; r++)
+    {
+      for (uint32_t c = 0; c < side; c++)
+	{
+	  uint32_t i = r * side + c;
+	  if (i == 0)
+	    names[i] = "1";
+	  else if (c == 0)
+	    names[i] = ChildName (names[i - side], 2);
+	  else
+	    names[i] = ChildName (names[i - 1], 1);
+
+	  hierarchy.AddNode (nodes.Get (i), names[i]);
+	}
+    }
+  hierarchy.Install ();
+
+  nnn::GlobalRoutingHelper routing;
+  routing.AddOrigin (g_prefix, nodes.Get (0));
+  routing.CalculateRoutes ();
+
+  nnn::AppHelper producer ("ns3::nnn::ICNProducer");
+  producer.SetPrefix (g_prefix);
+  producer.SetAttribute ("PayloadSize", StringValue ("1024"));
+  producer.Install (nodes.Get (0));
+
+  nnn::AppHelper consumer ("ns3::nnn::ICNConsumerZipfMandelbrot");
+  consumer.SetPrefix (g_prefix);
+  consumer.SetAttribute ("Frequency", DoubleValue (frequency));
+  consumer.SetAttribute ("NumberOfContents", UintegerValue (contents));
+  for (uint32_t c = 0; c < side; c++)
+    {
+      consumer.Install (nodes.Get ((side - 1) * side + c));
+    }
+}
+
+static void
+BuildStorm (NodeContainer &nodes, uint32_t size, double window)
+{
+  NS_ABORT_MSG_IF (size < 1, "The storm needs at least 1 enrolling node");
+
+  nodes.Create (size + 1);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1ms"));
+
+  for (uint32_t i = 1; i <= size; i++)
+    {
+      p2p.Install (nodes.Get (0), nodes.Get (i));
+    }
+
+  nnn::NNNStackHelper stack;
+  stack.Install (nodes);
+
+  nnn::SectorHierarchyHelper hierarchy;
+  hierarchy.AddNode (nodes.Get (0), "1");
+  hierarchy.Install ();
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 1; i <= size; i++)
+    {
+      Ptr<nnn::ForwardingStrategy> fw = nodes.Get (i)->GetObject<nnn::ForwardingStrategy> ();
+      Simulator::Schedule (Seconds (random->GetValue (0, window)), &nnn::ForwardingStrategy::Enroll, fw);
+    }
+}
+
+struct TableSize
+{
+  TableSize () : total (0), max (0) {}
+
+  void
+  Add (uint64_t size)
+  {
+    total += size;
+    max = std::max (max, size);
+  }
+
+  uint64_t total;
+  uint64_t max;
+};
+
+static std::ostream &
+operator << (std::ostream &os, const TableSize &size)
+{
+  return os << "{\"total\": " << size.total << ", \"max\": " << size.max << "}";
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string scenario = "line";
+  uint32_t size = 0;
+  double frequency = 100.0;
+  double stop = 20.0;
+  double handoff = 2.0;
+  double window = 0.01;
+  uint32_t csSize = 100;
+  uint32_t contents = 1000;
+  std::string stages;
+
+  CommandLine cmd;
+  cmd.AddValue ("scenario", "Scenario to run: line, tree, grid or storm", scenario);
+  cmd.AddValue ("size", "Nodes in the line, depth of the tree, side of the grid or nodes in the storm. 0 uses 16, 4, 8 and 256", size);
+  cmd.AddValue ("frequency", "Interests per second sent by every consumer", frequency);
+  cmd.AddValue ("stop", "Simulated seconds", stop);
+  cmd.AddValue ("handoff", "Seconds between two handoffs of a mobile node in the tree", handoff);
+  cmd.AddValue ("window", "Seconds within which the nodes of the storm enroll", window);
+  cmd.AddValue ("csSize", "Entries of every content store in the grid", csSize);
+  cmd.AddValue ("contents", "Size of the catalog requested in the grid", contents);
+  cmd.AddValue ("stages", "File for the time spent in every forwarding stage, needs --nnnsim-profile", stages);
+  cmd.Parse (argc, argv);
+
+  ObjectFactory scheduler;
+  scheduler.SetTypeId ("ns3::CountingScheduler");
+  Simulator::SetScheduler (scheduler);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+
+  NodeContainer nodes;
+  if (scenario == "line")
+    BuildLine (nodes, size ? size : 16, frequency);
+  else if (scenario == "tree")
+    BuildTree (nodes, size ? size : 4, frequency, handoff);
+  else if (scenario == "grid")
+    BuildGrid (nodes, size ? size : 8, frequency, csSize, contents);
+  else if (scenario == "storm")
+    BuildStorm (nodes, size ? size : 256, window);
+  else
+    NS_FATAL_ERROR ("Unknown scenario " << scenario);
+
+  int64_t setupMs = clock.End ();
+
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/OutNULLps",
+				 MakeBoundCallback (&CountPDU<nnn::NULLp>, &g_pdus));
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/OutSOs",
+				 MakeBoundCallback (&CountPDU<nnn::SO>, &g_pdus));
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/OutDOs",
+				 MakeBoundCallback (&CountPDU<nnn::DO>, &g_pdus));
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/OutDUs",
+				 MakeBoundCallback (&CountPDU<nnn::DU>, &g_pdus));
+
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/OutENs",
+				 MakeBoundCallback (&CountPDU<nnn::EN>, &g_controlPdus));
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/OutAENs",
+				 MakeBoundCallback (&CountPDU<nnn::AEN>, &g_controlPdus));
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/OutRENs",
+				 MakeBoundCallback (&CountPDU<nnn::REN>, &g_controlPdus));
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/OutDENs",
+				 MakeBoundCallback (&CountPDU<nnn::DEN>, &g_controlPdus));
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/OutOENs",
+				 MakeBoundCallback (&CountPDU<nnn::OEN>, &g_controlPdus));
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::nnn::ForwardingStrategy/OutINFs",
+				 MakeBoundCallback (&CountPDU<nnn::INF>, &g_controlPdus));
+
+  if (!stages.empty ())
+    nnn::StageProfiler::DumpAtEnd (stages);
+
+  Simulator::Stop (Seconds (stop));
+
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+
+  TableSize pit, fib, cs, nnst, nnpt;
+  for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+    {
+      pit.Add ((*node)->GetObject<nnn::Pit> ()->GetSize ());
+      fib.Add ((*node)->GetObject<nnn::Fib> ()->GetSize ());
+      cs.Add ((*node)->GetObject<nnn::ContentStore> ()->GetSize ());
+      nnst.Add ((*node)->GetObject<nnn::NNST> ()->GetSize ());
+      nnpt.Add ((*node)->GetObject<nnn::NNPT> ()->size ());
+    }
+
+  Simulator::Destroy ();
+
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+
+  double seconds = elapsed / 1000.0;
+
+  std::cout << "{\"scenario\": \"" << scenario << "\""
+	    << ", \"nodes\": " << nodes.GetN ()
+	    << ", \"sim_s\": " << stop
+	    << ", \"setup_ms\": " << setupMs
+	    << ", \"wall_ms\": " << elapsed
+	    << ", \"events\": " << g_events
+	    << ", \"events_per_s\": " << ((elapsed > 0) ? g_events / seconds : 0.0)
+	    << ", \"pdus_forwarded\": " << g_pdus
+	    << ", \"pdus_per_s\": " << ((elapsed > 0) ? g_pdus / seconds : 0.0)
+	    << ", \"control_pdus\": " << g_controlPdus
+	    << ", \"peak_rss_kb\": " << usage.ru_maxrss
+	    << ", \"tables\": {\"pit\": " << pit
+	    << ", \"fib\": " << fib
+	    << ", \"cs\": " << cs
+	    << ", \"nnst\": " << nnst
+	    << ", \"nnpt\": " << nnpt
+	    << "}}" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-single-radio-handoff.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-single-radio-handoff.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-single-radio-handoff.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+// Make-before-break handoff of a node with a single radio.
+//
+// The mobile node and the two points of attachment, A (1.1) and B (1.2),
+// share one CSMA segment, so the mobile node reaches both through the same
+// Face. A and B hang from the root (1) through point to point links.
+//
+//              1
+//             / \
+//           1.1  1.2
+//            |    |
+//   =========+====+========= CSMA
+//            |
+//          mobile
+//
+// The mobile node starts as 1.1.1. Every --handoff seconds it moves to the
+// other point of attachment: the one it leaves stops producing 3N names, as
+// it would once the mobile node is out of its coverage, and the strategy is
+// notified of the new PoA on the single Face. The DEN for the old 3N name
+// must still reach the old point of attachment. The first DEN is broadcast,
+// the 3N name loaded at t=0 has no known PoAs; later ones are addressed to
+// the node that gave the name.
+//
+// The example prints the DENs sent by the mobile node and received by each
+// point of attachment, and fails if a point of attachment that was left
+// never received one:
+//
+//   ./waf --run "nnn-single-radio-handoff --handoff=2 --stop=10"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/nnn-forwarding-strategy.h"
+#include "ns3/nnn-net-device-face.h"
+#include "ns3/nnn-l3-protocol.h"
+#include "ns3/nnn-pdus.h"
+#include "ns3/nnn-sector-hierarchy-helper.h"
+#include "ns3/nnn-stack-helper.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+static void
+CountDEN (uint32_t *counter, Ptr<const nnn::DEN>, Ptr<const nnn::Face>)
+{
+  (*counter)++;
+}
+
+static Ptr<nnn::Face>
+CsmaFace (Ptr<Node> node)
+{
+  Ptr<nnn::L3Protocol> nnn = node->GetObject<nnn::L3Protocol> ();
+
+  for (uint32_t faceId = 0; faceId < nnn->GetNFaces (); faceId++)
+    {
+      Ptr<nnn::NetDeviceFace> face = DynamicCast<nnn::NetDeviceFace> (nnn->GetFace (faceId));
+      if (face != 0 && DynamicCast<CsmaNetDevice> (face->GetNetDevice ()) != 0)
+	return face;
+    }
+
+  return 0;
+}
+
+// Leave the coverage of from and enter the one of to, then come back after
+// the same time
+static void
+Handoff (Ptr<Node> mobile, Ptr<Node> from, Ptr<Node> to, Time every)
+{
+  from->GetObject<nnn::ForwardingStrategy> ()->SetAttribute ("Produce3Nnames", BooleanValue (false));
+  to->GetObject<nnn::ForwardingStrategy> ()->SetAttribute ("Produce3Nnames", BooleanValue (true));
+
+  mobile->GetObject<nnn::ForwardingStrategy> ()->NotifyNewPoA (CsmaFace (mobile));
+
+  Simulator::Schedule (every, &Handoff, mobile, to, from, every);
+}
+
+int
+main (int argc, char *argv[])
+{
+  double handoff = 2.0;
+  double stop = 10.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("handoff", "Seconds between two handoffs of the mobile node", handoff);
+  cmd.AddValue ("stop", "Simulated seconds", stop);
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create (4);
+  Ptr<Node> root = nodes.Get (0);
+  Ptr<Node> poaA = nodes.Get (1);
+  Ptr<Node> poaB = nodes.Get (2);
+  Ptr<Node> mobile = nodes.Get (3);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1ms"));
+  p2p.Install (root, poaA);
+  p2p.Install (root, poaB);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", StringValue ("54Mbps"));
+  csma.SetChannelAttribute ("Delay", StringValue ("1ms"));
+  csma.Install (NodeContainer (poaA, poaB, mobile));
+
+  nnn::NNNStackHelper stack;
+  stack.SetForwardingStrategy ("ns3::nnn::ForwardingStrategy", "MakeBeforeBreak", "true");
+  stack.Install (nodes);
+
+  nnn::SectorHierarchyHelper hierarchy;
+  hierarchy.AddNode (root, "1");
+  hierarchy.AddNode (poaA, "1.1");
+  hierarchy.AddNode (poaB, "1.2");
+  hierarchy.AddNode (mobile, "1.1.1");
+  hierarchy.Install ();
+
+  // The mobile node starts in the coverage of A only
+  poaB->GetObject<nnn::ForwardingStrategy> ()->SetAttribute ("Produce3Nnames", BooleanValue (false));
+  Simulator::Schedule (Seconds (handoff), &Handoff, mobile, poaA, poaB, Seconds (handoff));
+
+  uint32_t sent = 0;
+  uint32_t receivedA = 0;
+  uint32_t receivedB = 0;
+  mobile->GetObject<nnn::ForwardingStrategy> ()->TraceConnectWithoutContext ("OutDENs", MakeBoundCallback (&CountDEN, &sent));
+  poaA->GetObject<nnn::ForwardingStrategy> ()->TraceConnectWithoutContext ("InDENs", MakeBoundCallback (&CountDEN, &receivedA));
+  poaB->GetObject<nnn::ForwardingStrategy> ()->TraceConnectWithoutContext ("InDENs", MakeBoundCallback (&CountDEN, &receivedB));
+
+  Simulator::Stop (Seconds (stop));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::cout << "DENs sent by the mobile node: " << sent << std::endl;
+  std::cout << "DENs received by 1.1: " << receivedA << std::endl;
+  std::cout << "DENs received by 1.2: " << receivedB << std::endl;
+
+  // A is left at the first handoff, B at the second. Only count the
+  // handoffs that had half a period to send their DEN
+  uint32_t handoffs = static_cast<uint32_t> ((stop - handoff / 2) / handoff);
+  NS_ABORT_MSG_IF (handoffs >= 1 && receivedA == 0, "1.1 was left without receiving a DEN");
+  NS_ABORT_MSG_IF (handoffs >= 2 && receivedB == 0, "1.2 was left without receiving a DEN");
+
+  return 0;
+}
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-distributed-helper.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-distributed-helper.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-distributed-helper.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+
+#ifdef NNNSIM_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+#include "nnn-distributed-helper.h"
+
+#include <sstream>
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.DistributedHelper");
+
+  namespace nnn
+  {
+    bool
+    DistributedHelper::IsEnabled ()
+    {
+      return GetSize () > 1;
+    }
+
+    uint32_t
+    DistributedHelper::GetRank ()
+    {
+#ifdef NNNSIM_MPI
+      if (MpiInterface::IsEnabled ())
+	return MpiInterface::GetSystemId ();
+#endif
+      return 0;
+    }
+
+    uint32_t
+    DistributedHelper::GetSize ()
+    {
+#ifdef NNNSIM_MPI
+      if (MpiInterface::IsEnabled ())
+	return MpiInterface::GetSize ();
+#endif
+      return 1;
+    }
+
+    bool
+    DistributedHelper::IsLocal (Ptr<Node> node)
+    {
+      return !IsEnabled () || node->GetSystemId () == GetRank ();
+    }
+
+    NodeContainer
+    DistributedHelper::GetLocalNodes (const NodeContainer &nodes)
+    {
+      NodeContainer local;
+      for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+	{
+	  if (IsLocal (*node))
+	    local.Add (*node);
+	}
+
+      NS_LOG_DEBUG ("Rank " << GetRank () << " simulates " << local.GetN () << " of " << nodes.GetN () << " nodes");
+      return local;
+    }
+
+    NodeContainer
+    DistributedHelper::GetLocalNodes ()
+    {
+      return GetLocalNodes (NodeContainer::GetGlobal ());
+    }
+
+    std::string
+    DistributedHelper::GetRankFileName (const std::string &file)
+    {
+      if (!IsEnabled () || file == "-")
+	return file;
+
+      std::ostringstream rank;
+      rank << "-rank" << GetRank ();
+
+      // The extension is what follows the last dot of the last path component
+      std::string::size_type slash = file.find_last_of ('/');
+      std::string::size_type dot = file.find_last_of ('.');
+      if (dot == std::string::npos || (slash != std::string::npos && dot < slash) || dot == slash + 1)
+	return file + rank.str ();
+
+      return file.substr (0, dot) + rank.str () + file.substr (dot);
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
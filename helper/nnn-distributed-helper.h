@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-distributed-helper.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-distributed-helper.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-distributed-helper.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_DISTRIBUTED_HELPER_H_
+#define NNN_DISTRIBUTED_HELPER_H_
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Partitions nnnSIM scenarios run with the ns-3 distributed simulator
+     *
+     * Under MPI every rank builds the whole topology, but only simulates the
+     * nodes whose system id is its rank. PDUs crossing point-to-point links
+     * between ranks travel serialized, so the Wire encoding of every 3N PDU
+     * is all the stack needs to work across them. What has to be partition
+     * aware is the per rank activity: applications, enrollment and tracers
+     * should only be installed on local nodes, and every rank writes its
+     * traces in its own file.
+     *
+     * The tracers do this on their own. Scenarios filter their nodes with
+     * GetLocalNodes:
+     *
+     * \code
+     *   NodeContainer consumers = DistributedHelper::GetLocalNodes (leaves);
+     *   consumerHelper.Install (consumers);
+     *   L3RateTracer::InstallAll ("rate-trace.txt", Seconds (1.0)); // rate-trace-rank<r>.txt
+     * \endcode
+     *
+     * Without MPI support (NNNSIM_MPI) or when MPI was not enabled, there is
+     * one rank and every node is local.
+     */
+    class DistributedHelper
+    {
+    public:
+      /**
+       * @brief Whether the simulation runs over more than one MPI rank
+       */
+      static bool
+      IsEnabled ();
+
+      /**
+       * @brief Rank of this process, 0 without MPI
+       */
+      static uint32_t
+      GetRank ();
+
+      /**
+       * @brief Number of ranks, 1 without MPI
+       */
+      static uint32_t
+      GetSize ();
+
+      /**
+       * @brief Whether the node is simulated by this rank
+       */
+      static bool
+      IsLocal (Ptr<Node> node);
+
+      /**
+       * @brief Nodes of the container simulated by this rank
+       */
+      static NodeContainer
+      GetLocalNodes (const NodeContainer &nodes);
+
+      /**
+       * @brief Nodes of the NodeList simulated by this rank
+       */
+      static NodeContainer
+      GetLocalNodes ();
+
+      /**
+       * @brief Name of the file this rank should write instead of file
+       *
+       * With more than one rank "-rank<r>" is inserted before the extension,
+       * "rate-trace.txt" becoming "rate-trace-rank1.txt" on rank 1. The name
+       * is kept as is with one rank or when it is "-" (standard output).
+       */
+      static std::string
+      GetRankFileName (const std::string &file);
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_DISTRIBUTED_HELPER_H_ */
@@ -0,0 +1,342 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-global-routing-helper.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-global-routing-helper.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-global-routing-helper.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/assert.h"
+#include "ns3/callback.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/names.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/system-wall-clock-ms.h"
+#ifdef NNNSIM_THREADS
+#include "ns3/system-thread.h"
+#endif
+
+#include "nnn-global-routing-helper.h"
+
+#include "../model/nnn-l3-protocol.h"
+#include "../model/nnn-net-device-face.h"
+#include "../model/fib/nnn-fib.h"
+#include "../model/naming/nnn-icn-name.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.GlobalRoutingHelper");
+
+  namespace nnn
+  {
+    static const uint32_t UNREACHABLE = std::numeric_limits<uint32_t>::max ();
+
+    GlobalRoutingHelper::GlobalRoutingHelper ()
+    : m_threads    (1)
+    , m_nodes      (0)
+    , m_entries    (0)
+    , m_graphMs    (0)
+    , m_dijkstraMs (0)
+    , m_installMs  (0)
+    {
+    }
+
+    void
+    GlobalRoutingHelper::AddOrigin (const std::string &prefix, Ptr<Node> node)
+    {
+      NS_ASSERT (node != 0);
+
+      std::vector<uint32_t> &origins = m_origins[prefix];
+      if (std::find (origins.begin (), origins.end (), node->GetId ()) == origins.end ())
+	origins.push_back (node->GetId ());
+    }
+
+    void
+    GlobalRoutingHelper::AddOrigin (const std::string &prefix, const std::string &nodeName)
+    {
+      Ptr<Node> node = Names::Find<Node> (nodeName);
+      NS_ASSERT_MSG (node != 0, "Node [" << nodeName << "] does not exist");
+
+      AddOrigin (prefix, node);
+    }
+
+    void
+    GlobalRoutingHelper::AddOrigins (const std::string &prefix, const NodeContainer &nodes)
+    {
+      for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+	{
+	  AddOrigin (prefix, *node);
+	}
+    }
+
+    void
+    GlobalRoutingHelper::SetThreads (uint32_t threads)
+    {
+      m_threads = std::max<uint32_t> (threads, 1);
+    }
+
+    uint32_t
+    GlobalRoutingHelper::CalculateRoutes ()
+    {
+      NS_LOG_FUNCTION (this);
+
+      SystemWallClockMs clock;
+
+      clock.Start ();
+      BuildGraph ();
+      m_graphMs = clock.End ();
+
+      // Every node producing at least one prefix is the root of one shortest path tree
+      m_originNodes.clear ();
+      for (std::map<std::string, std::vector<uint32_t> >::iterator prefix = m_origins.begin ();
+	  prefix != m_origins.end (); prefix++)
+	{
+	  m_originNodes.insert (m_originNodes.end (), prefix->second.begin (), prefix->second.end ());
+	}
+      std::sort (m_originNodes.begin (), m_originNodes.end ());
+      m_originNodes.erase (std::unique (m_originNodes.begin (), m_originNodes.end ()), m_originNodes.end ());
+
+      m_dist.assign (m_originNodes.size (), std::vector<uint32_t> ());
+      m_nextEdge.assign (m_originNodes.size (), std::vector<uint32_t> ());
+
+      clock.Start ();
+      uint32_t threads = std::min<uint32_t> (m_threads, std::max<size_t> (m_originNodes.size (), 1));
+#ifdef NNNSIM_THREADS
+      if (threads > 1)
+	{
+	  // The workers only touch the plain arrays of the graph and their own
+	  // slots of m_dist and m_nextEdge
+	  std::vector<Ptr<SystemThread> > workers;
+	  for (uint32_t i = 0; i < threads; i++)
+	    {
+	      workers.push_back (Create<SystemThread> (MakeBoundCallback (&GlobalRoutingHelper::RunWorker, this, i, threads)));
+	      workers.back ()->Start ();
+	    }
+	  for (uint32_t i = 0; i < threads; i++)
+	    {
+	      workers[i]->Join ();
+	    }
+	}
+      else
+	{
+	  RunDijkstra (0, 1);
+	}
+#else
+      if (threads > 1)
+	{
+	  NS_LOG_WARN ("ns-3 was built without threading support, computing routes in one thread");
+	}
+      RunDijkstra (0, 1);
+#endif
+      m_dijkstraMs = clock.End ();
+
+      clock.Start ();
+      m_entries = InstallRoutes ();
+      m_installMs = clock.End ();
+
+      NS_LOG_INFO ("Installed " << m_entries << " FIB entries for " << m_origins.size () << " prefixes on "
+		   << m_nodes << " nodes in " << (m_graphMs + m_dijkstraMs + m_installMs) << " ms");
+
+      return m_entries;
+    }
+
+    void
+    GlobalRoutingHelper::BuildGraph ()
+    {
+      m_nodes = NodeList::GetNNodes ();
+      m_edgeFrom.clear ();
+      m_edgeTo.clear ();
+      m_edgeMetric.clear ();
+      m_edgeFaces.clear ();
+      m_fibs.assign (m_nodes, 0);
+
+      for (uint32_t id = 0; id < m_nodes; id++)
+	{
+	  Ptr<Node> node = NodeList::GetNode (id);
+	  Ptr<L3Protocol> nnn = node->GetObject<L3Protocol> ();
+	  if (nnn == 0)
+	    continue;
+
+	  m_fibs[id] = node->GetObject<Fib> ();
+
+	  for (uint32_t faceId = 0; faceId < nnn->GetNFaces (); faceId++)
+	    {
+	      Ptr<NetDeviceFace> face = DynamicCast<NetDeviceFace> (nnn->GetFace (faceId));
+	      if (face == 0 || !face->IsUp ())
+		continue;
+
+	      Ptr<NetDevice> device = face->GetNetDevice ();
+	      Ptr<Channel> channel = device->GetChannel ();
+	      if (channel == 0)
+		continue;
+
+	      // One edge to every other 3N node on the channel
+	      for (uint32_t i = 0; i < channel->GetNDevices (); i++)
+		{
+		  Ptr<NetDevice> other = channel->GetDevice (i);
+		  if (other == device || other->GetNode ()->GetObject<L3Protocol> () == 0)
+		    continue;
+
+		  m_edgeFrom.push_back (id);
+		  m_edgeTo.push_back (other->GetNode ()->GetId ());
+		  m_edgeMetric.push_back (face->GetMetric ());
+		  m_edgeFaces.push_back (face);
+		}
+	    }
+	}
+
+      // Group the edges by the node they enter
+      m_inStart.assign (m_nodes + 1, 0);
+      for (size_t e = 0; e < m_edgeTo.size (); e++)
+	{
+	  m_inStart[m_edgeTo[e] + 1]++;
+	}
+      for (uint32_t v = 0; v < m_nodes; v++)
+	{
+	  m_inStart[v + 1] += m_inStart[v];
+	}
+
+      std::vector<uint32_t> fill (m_inStart.begin (), m_inStart.end () - 1);
+      m_inEdges.resize (m_edgeTo.size ());
+      for (size_t e = 0; e < m_edgeTo.size (); e++)
+	{
+	  m_inEdges[fill[m_edgeTo[e]]++] = e;
+	}
+    }
+
+    void
+    GlobalRoutingHelper::RunWorker (GlobalRoutingHelper *helper, uint32_t first, uint32_t step)
+    {
+      helper->RunDijkstra (first, step);
+    }
+
+    void
+    GlobalRoutingHelper::RunDijkstra (uint32_t first, uint32_t step)
+    {
+      typedef std::pair<uint32_t, uint32_t> QueueItem; // distance, node
+
+      for (uint32_t o = first; o < m_originNodes.size (); o += step)
+	{
+	  std::vector<uint32_t> &dist = m_dist[o];
+	  std::vector<uint32_t> &nextEdge = m_nextEdge[o];
+	  dist.assign (m_nodes, UNREACHABLE);
+	  nextEdge.assign (m_nodes, UNREACHABLE);
+
+	  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem> > queue;
+
+	  uint32_t origin = m_originNodes[o];
+	  dist[origin] = 0;
+	  queue.push (QueueItem (0, origin));
+
+	  // Walk the edges backwards: nextEdge[u] is the edge leaving u on its
+	  // shortest path to the origin
+	  while (!queue.empty ())
+	    {
+	      QueueItem top = queue.top ();
+	      queue.pop ();
+
+	      uint32_t v = top.second;
+	      if (top.first != dist[v])
+		continue;
+
+	      for (uint32_t i = m_inStart[v]; i < m_inStart[v + 1]; i++)
+		{
+		  uint32_t e = m_inEdges[i];
+		  uint32_t u = m_edgeFrom[e];
+		  uint32_t d = dist[v] + m_edgeMetric[e];
+
+		  if (d < dist[u])
+		    {
+		      dist[u] = d;
+		      nextEdge[u] = e;
+		      queue.push (QueueItem (d, u));
+		    }
+		}
+	    }
+	}
+    }
+
+    uint32_t
+    GlobalRoutingHelper::InstallRoutes ()
+    {
+      uint32_t entries = 0;
+
+      for (std::map<std::string, std::vector<uint32_t> >::iterator prefix = m_origins.begin ();
+	  prefix != m_origins.end (); prefix++)
+	{
+	  Ptr<const icn::Name> name = Create<icn::Name> (prefix->first);
+
+	  // Shortest path trees of the origins of this prefix
+	  std::vector<uint32_t> trees;
+	  for (size_t i = 0; i < prefix->second.size (); i++)
+	    {
+	      trees.push_back (std::lower_bound (m_originNodes.begin (), m_originNodes.end (), prefix->second[i]) - m_originNodes.begin ());
+	    }
+
+	  for (uint32_t u = 0; u < m_nodes; u++)
+	    {
+	      if (m_fibs[u] == 0)
+		continue;
+
+	      // Route towards the closest origin, the origins themselves are served by their applications
+	      uint32_t best = UNREACHABLE;
+	      uint32_t bestEdge = UNREACHABLE;
+	      for (size_t t = 0; t < trees.size (); t++)
+		{
+		  if (m_dist[trees[t]][u] < best)
+		    {
+		      best = m_dist[trees[t]][u];
+		      bestEdge = m_nextEdge[trees[t]][u];
+		    }
+		}
+
+	      if (bestEdge == UNREACHABLE)
+		continue;
+
+	      NS_LOG_LOGIC ("[" << u << "]$ route add " << prefix->first << " via " << *m_edgeFaces[bestEdge] << " metric " << best);
+	      m_fibs[u]->Add (name, m_edgeFaces[bestEdge], best);
+	      entries++;
+	    }
+	}
+
+      return entries;
+    }
+
+    void
+    GlobalRoutingHelper::PrintCost (std::ostream &os) const
+    {
+      os << "nodes\t" << m_nodes << std::endl
+	  << "edges\t" << m_edgeFrom.size () << std::endl
+	  << "prefixes\t" << m_origins.size () << std::endl
+	  << "origins\t" << m_originNodes.size () << std::endl
+	  << "threads\t" << m_threads << std::endl
+	  << "fib_entries\t" << m_entries << std::endl
+	  << "graph_ms\t" << m_graphMs << std::endl
+	  << "dijkstra_ms\t" << m_dijkstraMs << std::endl
+	  << "install_ms\t" << m_installMs << std::endl;
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-global-routing-helper.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-global-routing-helper.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-global-routing-helper.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_GLOBAL_ROUTING_HELPER_H_
+#define NNN_GLOBAL_ROUTING_HELPER_H_
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+
+#include <stdint.h>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    class Face;
+    class Fib;
+
+    /**
+     * @brief Computes shortest path routes over the channels between nodes and fills the FIBs
+     *
+     * Every Face of a node with the 3N stack installed is an edge to the
+     * other nodes attached to its channel, weighted by the Face metric. One
+     * Dijkstra is run per origin, that is per node producing a prefix, so the
+     * cost grows with the number of producers and not with the square of the
+     * number of nodes. The runs are independent and are spread over
+     * SetThreads worker threads when ns-3 was built with threading support.
+     *
+     * Every node gets one FIB entry per prefix, through the Face on the
+     * shortest path to the closest origin and with the path cost as metric.
+     *
+     * \code
+     *   GlobalRoutingHelper routing;
+     *   routing.AddOrigins ("/prefix", producers);
+     *   routing.CalculateRoutes ();
+     * \endcode
+     */
+    class GlobalRoutingHelper
+    {
+    public:
+      GlobalRoutingHelper ();
+
+      /**
+       * @brief Announce that a node produces a prefix
+       */
+      void
+      AddOrigin (const std::string &prefix, Ptr<Node> node);
+
+      /**
+       * @brief Announce that a node produces a prefix
+       * @param nodeName node name (refer to ns3::Names)
+       */
+      void
+      AddOrigin (const std::string &prefix, const std::string &nodeName);
+
+      /**
+       * @brief Announce that every node of the container produces a prefix
+       */
+      void
+      AddOrigins (const std::string &prefix, const NodeContainer &nodes);
+
+      /**
+       * @brief Set the number of threads running the shortest path computations
+       *
+       * Only honoured when ns-3 was built with threading support
+       */
+      void
+      SetThreads (uint32_t threads);
+
+      /**
+       * @brief Compute the shortest paths to every origin and install the FIB entries
+       *
+       * The graph is built from the nodes and Faces present at the time of
+       * the call, so call it after the stack has been installed everywhere.
+       *
+       * @returns number of FIB entries installed
+       */
+      uint32_t
+      CalculateRoutes ();
+
+      /**
+       * @brief Print the size of the last computation and the wall clock time of each of its stages
+       */
+      void
+      PrintCost (std::ostream &os) const;
+
+    private:
+      void
+      BuildGraph ();
+
+      void
+      RunDijkstra (uint32_t first, uint32_t step);
+
+      static void
+      RunWorker (GlobalRoutingHelper *helper, uint32_t first, uint32_t step);
+
+      uint32_t
+      InstallRoutes ();
+
+    private:
+      std::map<std::string, std::vector<uint32_t> > m_origins; ///< @brief Node ids producing every prefix
+      uint32_t m_threads;
+
+      // Graph of the last computation. Edge e goes from m_edgeFrom[e] to
+      // m_edgeTo[e] through m_edgeFaces[e] on the first node. m_inEdges holds
+      // the edges entering node v between m_inStart[v] and m_inStart[v + 1]
+      uint32_t m_nodes;
+      std::vector<uint32_t> m_edgeFrom;
+      std::vector<uint32_t> m_edgeTo;
+      std::vector<uint32_t> m_edgeMetric;
+      std::vector<Ptr<Face> > m_edgeFaces;
+      std::vector<uint32_t> m_inStart;
+      std::vector<uint32_t> m_inEdges;
+      std::vector<Ptr<Fib> > m_fibs;
+
+      // Shortest path tree towards every origin node
+      std::vector<uint32_t> m_originNodes;
+      std::vector<std::vector<uint32_t> > m_dist;
+      std::vector<std::vector<uint32_t> > m_nextEdge;
+
+      uint32_t m_entries;
+      int64_t m_graphMs;
+      int64_t m_dijkstraMs;
+      int64_t m_installMs;
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_GLOBAL_ROUTING_HELPER_H_ */
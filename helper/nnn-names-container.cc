@@ -195,6 +195,18 @@ namespace ns3
       return container.size();
     }
 
+    NamesContainer::names_set::const_iterator
+    NamesContainer::Begin () const
+    {
+      return container.begin ();
+    }
+
+    NamesContainer::names_set::const_iterator
+    NamesContainer::End () const
+    {
+      return container.end ();
+    }
+
     bool
     NamesContainer::isEmpty()
     {
@@ -146,6 +146,15 @@ namespace ns3
       void
       printByLease ();
 
+      /**
+       * @brief First entry of the container, in lease order
+       */
+      names_set::const_iterator
+      Begin () const;
+
+      names_set::const_iterator
+      End () const;
+
     private:
       names_set container;         ///< \brief Internal structure holding the 3N names
       Time defaultRenewal;         ///< \brief Default negative default time to fire renewal callback
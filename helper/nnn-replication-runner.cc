@@ -0,0 +1,358 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-replication-runner.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-replication-runner.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-replication-runner.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/abort.h"
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include "nnn-replication-runner.h"
+
+#include "../utils/tracers/nnn-l3-binary-trace.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.ReplicationRunner");
+
+  namespace nnn
+  {
+    static int64_t
+    NowMs ()
+    {
+      struct timeval tv;
+      gettimeofday (&tv, 0);
+      return static_cast<int64_t> (tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+    }
+
+    static void
+    MakeDirectory (const std::string &directory)
+    {
+      if (mkdir (directory.c_str (), 0755) != 0 && errno != EEXIST)
+	NS_FATAL_ERROR ("Cannot create directory " << directory);
+    }
+
+    ReplicationRunner::ReplicationRunner ()
+    : m_jobs      (0)
+    , m_directory (".")
+    , m_firstRun  (1)
+    , m_runs      (1)
+    {
+    }
+
+    void
+    ReplicationRunner::SetScenario (ScenarioCallback scenario)
+    {
+      m_scenario = scenario;
+    }
+
+    void
+    ReplicationRunner::SetJobs (uint32_t jobs)
+    {
+      m_jobs = jobs;
+    }
+
+    void
+    ReplicationRunner::SetOutputDirectory (const std::string &directory)
+    {
+      m_directory = directory;
+    }
+
+    void
+    ReplicationRunner::SetRuns (uint32_t first, uint32_t runs)
+    {
+      m_firstRun = first;
+      m_runs = runs;
+    }
+
+    void
+    ReplicationRunner::AddParameter (const std::string &attribute, const std::string &values)
+    {
+      std::vector<std::string> list;
+      std::istringstream is (values);
+      std::string value;
+
+      while (std::getline (is, value, ','))
+	{
+	  if (!value.empty ())
+	    list.push_back (value);
+	}
+
+      NS_ABORT_MSG_IF (list.empty (), "No values given for " << attribute);
+
+      m_parameters.push_back (std::make_pair (attribute, list));
+    }
+
+    uint32_t
+    ReplicationRunner::Run ()
+    {
+      NS_LOG_FUNCTION (this);
+
+      NS_ABORT_MSG_IF (m_scenario.IsNull (), "No scenario set");
+      NS_ABORT_MSG_IF (NodeList::GetNNodes () != 0, "Build the scenario in the callback given to SetScenario, not before Run");
+
+      uint32_t jobs = m_jobs;
+      if (jobs == 0)
+	jobs = std::max<long> (sysconf (_SC_NPROCESSORS_ONLN), 1);
+
+      MakeDirectory (m_directory);
+
+      // Every combination of parameter values, with the first parameter changing the slowest
+      uint32_t combinations = 1;
+      for (size_t p = 0; p < m_parameters.size (); p++)
+	{
+	  combinations *= m_parameters[p].second.size ();
+	}
+
+      m_replicas.clear ();
+      for (uint32_t c = 0; c < combinations; c++)
+	{
+	  std::vector<uint32_t> values (m_parameters.size ());
+	  uint32_t rest = c;
+	  for (size_t p = m_parameters.size (); p > 0; p--)
+	    {
+	      values[p - 1] = rest % m_parameters[p - 1].second.size ();
+	      rest /= m_parameters[p - 1].second.size ();
+	    }
+
+	  for (uint32_t r = 0; r < m_runs; r++)
+	    {
+	      Replica replica;
+	      replica.m_run = m_firstRun + r;
+	      replica.m_values = values;
+	      replica.m_status = -1;
+	      replica.m_wallMs = 0;
+
+	      std::ostringstream directory;
+	      directory << m_directory << "/replica-" << m_replicas.size ();
+	      replica.m_directory = directory.str ();
+
+	      m_replicas.push_back (replica);
+	    }
+	}
+
+      NS_LOG_INFO ("Running " << m_replicas.size () << " replicas, " << jobs << " at a time");
+
+      std::map<pid_t, size_t> running;
+      std::vector<int64_t> start (m_replicas.size ());
+      size_t next = 0;
+      uint32_t failed = 0;
+
+      while (next < m_replicas.size () || !running.empty ())
+	{
+	  while (running.size () < jobs && next < m_replicas.size ())
+	    {
+	      MakeDirectory (m_replicas[next].m_directory);
+
+	      // Buffered output would otherwise be written by the parent and the child
+	      std::cout.flush ();
+	      std::cerr.flush ();
+	      std::fflush (0);
+
+	      pid_t pid = fork ();
+	      if (pid < 0)
+		NS_FATAL_ERROR ("Cannot fork replica " << next);
+
+	      if (pid == 0)
+		{
+		  RunReplica (m_replicas[next]);
+		  std::exit (0);
+		}
+
+	      NS_LOG_DEBUG ("Replica " << next << " (RngRun " << m_replicas[next].m_run << ") is process " << pid);
+
+	      start[next] = NowMs ();
+	      running[pid] = next;
+	      next++;
+	    }
+
+	  int status;
+	  pid_t pid = waitpid (-1, &status, 0);
+	  if (pid < 0)
+	    {
+	      if (errno == EINTR)
+		continue;
+	      NS_FATAL_ERROR ("Lost track of the replicas");
+	    }
+
+	  std::map<pid_t, size_t>::iterator item = running.find (pid);
+	  if (item == running.end ())
+	    continue;
+
+	  Replica &replica = m_replicas[item->second];
+	  replica.m_wallMs = NowMs () - start[item->second];
+	  replica.m_status = WIFEXITED (status) ? WEXITSTATUS (status) : 128 + WTERMSIG (status);
+
+	  if (replica.m_status != 0)
+	    {
+	      NS_LOG_WARN ("Replica " << item->second << " (RngRun " << replica.m_run << ") failed with status " << replica.m_status);
+	      failed++;
+	    }
+
+	  running.erase (item);
+	}
+
+      std::ofstream summary ((m_directory + "/replicas.txt").c_str ());
+      WriteSummary (summary);
+
+      Aggregate ();
+
+      return failed;
+    }
+
+    void
+    ReplicationRunner::RunReplica (const Replica &replica) const
+    {
+      RngSeedManager::SetRun (replica.m_run);
+
+      for (size_t p = 0; p < m_parameters.size (); p++)
+	{
+	  Config::SetDefault (m_parameters[p].first, StringValue (m_parameters[p].second[replica.m_values[p]]));
+	}
+
+      m_scenario (replica.m_directory);
+
+      // In case the scenario left it running, flushes the tracers too
+      Simulator::Destroy ();
+    }
+
+    std::string
+    ReplicationRunner::Columns (uint32_t index) const
+    {
+      const Replica &replica = m_replicas[index];
+
+      std::ostringstream os;
+      os << index << "\t" << replica.m_run;
+      for (size_t p = 0; p < m_parameters.size (); p++)
+	{
+	  os << "\t" << m_parameters[p].second[replica.m_values[p]];
+	}
+      return os.str ();
+    }
+
+    void
+    ReplicationRunner::WriteSummary (std::ostream &os) const
+    {
+      os << "Replica\tRun";
+      for (size_t p = 0; p < m_parameters.size (); p++)
+	{
+	  os << "\t" << m_parameters[p].first;
+	}
+      os << "\tStatus\tWallMs\tDirectory\n";
+
+      for (uint32_t i = 0; i < m_replicas.size (); i++)
+	{
+	  os << Columns (i) << "\t" << m_replicas[i].m_status << "\t"
+	      << m_replicas[i].m_wallMs << "\t" << m_replicas[i].m_directory << "\n";
+	}
+    }
+
+    void
+    ReplicationRunner::Aggregate () const
+    {
+      // Text files written by any successful replica
+      std::vector<std::string> files;
+      for (uint32_t i = 0; i < m_replicas.size (); i++)
+	{
+	  if (m_replicas[i].m_status != 0)
+	    continue;
+
+	  DIR *dir = opendir (m_replicas[i].m_directory.c_str ());
+	  if (dir == 0)
+	    continue;
+
+	  struct dirent *entry;
+	  while ((entry = readdir (dir)) != 0)
+	    {
+	      std::string name = entry->d_name;
+	      std::string path = m_replicas[i].m_directory + "/" + name;
+	      struct stat info;
+
+	      if (stat (path.c_str (), &info) != 0 || !S_ISREG (info.st_mode) || L3BinaryTraceWriter::IsBinaryFile (name))
+		continue;
+
+	      if (std::find (files.begin (), files.end (), name) == files.end ())
+		files.push_back (name);
+	    }
+	  closedir (dir);
+	}
+
+      std::string columns = "Replica\tRun";
+      for (size_t p = 0; p < m_parameters.size (); p++)
+	{
+	  columns += "\t" + m_parameters[p].first;
+	}
+
+      // The first line of every file is its header, written once
+      for (size_t f = 0; f < files.size (); f++)
+	{
+	  std::ofstream os ((m_directory + "/" + files[f]).c_str ());
+	  bool header = false;
+
+	  for (uint32_t i = 0; i < m_replicas.size (); i++)
+	    {
+	      if (m_replicas[i].m_status != 0)
+		continue;
+
+	      std::ifstream is ((m_replicas[i].m_directory + "/" + files[f]).c_str ());
+	      std::string line;
+
+	      if (!std::getline (is, line))
+		continue;
+
+	      if (!header)
+		{
+		  os << columns << "\t" << line << "\n";
+		  header = true;
+		}
+
+	      std::string prefix = Columns (i);
+	      while (std::getline (is, line))
+		{
+		  if (!line.empty ())
+		    os << prefix << "\t" << line << "\n";
+		}
+	    }
+
+	  NS_LOG_INFO ("Aggregated " << files[f] << " in " << m_directory);
+	}
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-replication-runner.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-replication-runner.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-replication-runner.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_REPLICATION_RUNNER_H_
+#define NNN_REPLICATION_RUNNER_H_
+
+#include "ns3/callback.h"
+
+#include <stdint.h>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Runs independent replicas of a scenario in parallel processes
+     *
+     * A replica is one combination of the swept attribute values with one
+     * RngRun. Every replica runs in its own process, forked from the calling
+     * one, so replicas share no simulator, node list or tracer state. Up to
+     * SetJobs replicas run at the same time, one per online core by default.
+     *
+     * The scenario callback builds the topology, installs its tracers, runs
+     * and destroys the simulator. It gets the directory where the replica
+     * should write its outputs, "<output>/replica-<n>":
+     *
+     * \code
+     *   static void
+     *   Scenario (const std::string &dir)
+     *   {
+     *     // ... topology and applications
+     *     L3RateTracer::InstallAll (dir + "/rate-trace.txt", Seconds (1.0));
+     *     Simulator::Stop (Seconds (20.0));
+     *     Simulator::Run ();
+     *     Simulator::Destroy ();
+     *   }
+     *
+     *   ReplicationRunner runner;
+     *   runner.SetScenario (MakeCallback (&Scenario));
+     *   runner.SetOutputDirectory ("results");
+     *   runner.SetRuns (1, 10);
+     *   runner.AddParameter ("ns3::nnn::ForwardingStrategy::RetxTimer", "50ms,100ms");
+     *   runner.AddParameter ("ns3::nnn::cs::Lru::MaxSize", "100,1000");
+     *   runner.Run ();
+     * \endcode
+     *
+     * Nothing should be simulated in the calling process before Run. Once
+     * every replica is over, "<output>/replicas.txt" lists the run, attribute
+     * values, exit status and wall clock time of every replica, and every
+     * text file written by the replicas is concatenated into a file of the
+     * same name in the output directory, with the replica, run and attribute
+     * values prepended to every line.
+     */
+    class ReplicationRunner
+    {
+    public:
+      typedef Callback<void, const std::string &> ScenarioCallback;
+
+      ReplicationRunner ();
+
+      /**
+       * @brief Set the function building and running one replica
+       */
+      void
+      SetScenario (ScenarioCallback scenario);
+
+      /**
+       * @brief Set the number of replicas running at the same time, 0 for one per online core
+       */
+      void
+      SetJobs (uint32_t jobs);
+
+      /**
+       * @brief Set the directory holding the directories of the replicas and the aggregated outputs
+       */
+      void
+      SetOutputDirectory (const std::string &directory);
+
+      /**
+       * @brief Run every combination of attribute values with RngRun first, first + 1, ..., first + runs - 1
+       */
+      void
+      SetRuns (uint32_t first, uint32_t runs);
+
+      /**
+       * @brief Sweep an attribute over a set of values
+       *
+       * The values are set with Config::SetDefault in every replica before the scenario is built
+       *
+       * @param attribute attribute name, as given to Config::SetDefault
+       * @param values comma separated values
+       */
+      void
+      AddParameter (const std::string &attribute, const std::string &values);
+
+      /**
+       * @brief Run every replica and aggregate their outputs
+       * @returns number of replicas that did not exit successfully
+       */
+      uint32_t
+      Run ();
+
+    private:
+      struct Replica
+      {
+	uint32_t m_run;
+	std::vector<uint32_t> m_values; ///< @brief Index of the value of every parameter
+	std::string m_directory;
+	int m_status;
+	int64_t m_wallMs;
+      };
+
+      void
+      RunReplica (const Replica &replica) const;
+
+      void
+      WriteSummary (std::ostream &os) const;
+
+      void
+      Aggregate () const;
+
+      std::string
+      Columns (uint32_t index) const;
+
+    private:
+      ScenarioCallback m_scenario;
+      uint32_t m_jobs;
+      std::string m_directory;
+      uint32_t m_firstRun;
+      uint32_t m_runs;
+      std::vector<std::pair<std::string, std::vector<std::string> > > m_parameters;
+      std::vector<Replica> m_replicas;
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_REPLICATION_RUNNER_H_ */
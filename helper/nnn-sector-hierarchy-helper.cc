@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-sector-hierarchy-helper.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-sector-hierarchy-helper.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-sector-hierarchy-helper.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/assert.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/names.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include "nnn-sector-hierarchy-helper.h"
+
+#include "../model/nnn-l3-protocol.h"
+#include "../model/nnn-net-device-face.h"
+#include "../model/nnn-naming.h"
+#include "../model/fw/nnn-forwarding-strategy.h"
+#include "../model/nnst/nnn-nnst.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.SectorHierarchyHelper");
+
+  namespace nnn
+  {
+    SectorHierarchyHelper::SectorHierarchyHelper ()
+    : m_lease  (Seconds (365 * 24 * 3600))
+    , m_fixed  (true)
+    , m_metric (6)
+    {
+    }
+
+    void
+    SectorHierarchyHelper::SetLease (Time lease, bool fixed)
+    {
+      m_lease = lease;
+      m_fixed = fixed;
+    }
+
+    void
+    SectorHierarchyHelper::SetMetric (int32_t metric)
+    {
+      m_metric = metric;
+    }
+
+    void
+    SectorHierarchyHelper::AddNode (Ptr<Node> node, const std::string &name)
+    {
+      NS_ASSERT (node != 0);
+      NS_ASSERT_MSG (!NNNAddress (name).isEmpty (), "Node " << node->GetId () << " needs a non empty 3N name");
+
+      m_names[node->GetId ()] = name;
+    }
+
+    void
+    SectorHierarchyHelper::AddNode (const std::string &nodeName, const std::string &name)
+    {
+      Ptr<Node> node = Names::Find<Node> (nodeName);
+
+      if (node == 0 && nodeName.find_first_not_of ("0123456789") == std::string::npos)
+	{
+	  uint32_t id = std::strtoul (nodeName.c_str (), 0, 10);
+	  if (id < NodeList::GetNNodes ())
+	    node = NodeList::GetNode (id);
+	}
+
+      NS_ASSERT_MSG (node != 0, "Node [" << nodeName << "] does not exist");
+
+      AddNode (node, name);
+    }
+
+    uint32_t
+    SectorHierarchyHelper::Load (std::istream &is)
+    {
+      uint32_t read = 0;
+      std::string line;
+
+      while (std::getline (is, line))
+	{
+	  std::istringstream fields (line);
+	  std::string nodeName, name;
+
+	  if (!(fields >> nodeName) || nodeName[0] == '#')
+	    continue;
+
+	  if (!(fields >> name))
+	    NS_FATAL_ERROR ("No 3N name given for node [" << nodeName << "]");
+
+	  AddNode (nodeName, name);
+	  read++;
+	}
+
+      return read;
+    }
+
+    uint32_t
+    SectorHierarchyHelper::Load (const std::string &file)
+    {
+      std::ifstream is (file.c_str ());
+      if (!is.is_open ())
+	NS_FATAL_ERROR ("Cannot open sector hierarchy description " << file);
+
+      return Load (is);
+    }
+
+    uint32_t
+    SectorHierarchyHelper::Install () const
+    {
+      NS_LOG_FUNCTION (this);
+
+      Time lease = Simulator::Now () + m_lease;
+      uint32_t entries = 0;
+
+      std::map<uint32_t, Ptr<const NNNAddress> > names;
+      for (std::map<uint32_t, std::string>::const_iterator it = m_names.begin (); it != m_names.end (); it++)
+	{
+	  Ptr<const NNNAddress> name = Create<const NNNAddress> (it->second);
+	  names[it->first] = name;
+
+	  Ptr<ForwardingStrategy> fw = NodeList::GetNode (it->first)->GetObject<ForwardingStrategy> ();
+	  NS_ASSERT_MSG (fw != 0, "3N stack should be installed on node " << it->first);
+
+	  fw->SetNode3NName (name, lease, m_fixed);
+	}
+
+      // Link every node with the neighbour whose name is its sector, as an
+      // EN/OEN/AEN exchange between the two would have
+      for (std::map<uint32_t, Ptr<const NNNAddress> >::iterator child = names.begin (); child != names.end (); child++)
+	{
+	  NNNAddress sector = child->second->getSectorName ();
+	  if (sector.isEmpty ())
+	    continue;
+
+	  Ptr<Node> node = NodeList::GetNode (child->first);
+	  Ptr<L3Protocol> nnn = node->GetObject<L3Protocol> ();
+	  bool linked = false;
+
+	  for (uint32_t faceId = 0; faceId < nnn->GetNFaces () && !linked; faceId++)
+	    {
+	      Ptr<NetDeviceFace> face = DynamicCast<NetDeviceFace> (nnn->GetFace (faceId));
+	      if (face == 0 || face->GetNetDevice ()->GetChannel () == 0)
+		continue;
+
+	      Ptr<NetDevice> device = face->GetNetDevice ();
+	      Ptr<Channel> channel = device->GetChannel ();
+
+	      for (uint32_t i = 0; i < channel->GetNDevices () && !linked; i++)
+		{
+		  Ptr<NetDevice> other = channel->GetDevice (i);
+		  if (other == device)
+		    continue;
+
+		  std::map<uint32_t, Ptr<const NNNAddress> >::iterator parent = names.find (other->GetNode ()->GetId ());
+		  if (parent == names.end () || *parent->second != sector)
+		    continue;
+
+		  Ptr<Node> parentNode = other->GetNode ();
+		  Ptr<Face> parentFace = parentNode->GetObject<L3Protocol> ()->GetFaceByNetDevice (other);
+		  if (parentFace == 0)
+		    continue;
+
+		  NS_LOG_INFO ("Linking (" << *child->second << ") on node " << child->first << " with ("
+			       << *parent->second << ") on node " << parent->first);
+
+		  node->GetObject<NNST> ()->Add (parent->second, face, other->GetAddress (), lease, m_metric);
+		  parentNode->GetObject<NNST> ()->Add (child->second, parentFace, device->GetAddress (), lease, m_metric);
+		  parentNode->GetObject<ForwardingStrategy> ()->AddLeasedName (child->second, lease, m_fixed);
+
+		  entries += 2;
+		  linked = true;
+		}
+	    }
+
+	  if (!linked)
+	    {
+	      NS_LOG_WARN ("No neighbour of node " << child->first << " goes by (" << sector << "), (" << *child->second << ") is not linked");
+	    }
+	}
+
+      return entries;
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-sector-hierarchy-helper.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-sector-hierarchy-helper.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-sector-hierarchy-helper.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_SECTOR_HIERARCHY_HELPER_H_
+#define NNN_SECTOR_HIERARCHY_HELPER_H_
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+
+#include <stdint.h>
+#include <istream>
+#include <map>
+#include <string>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Loads the 3N names and NNST entries of a static sector hierarchy at the start of a simulation
+     *
+     * The enrollment protocol leaves every node with its 3N name, an NNST
+     * entry towards the node that gave it the name and, on that node, an
+     * NNST entry and a leased name record for it. This helper writes the
+     * same state directly from a list of configured names, so large runs
+     * start forwarding at t=0 instead of spending their first seconds
+     * enrolling.
+     *
+     * Two nodes are linked in the hierarchy when they share a channel and
+     * the name of one is the sector of the name of the other. Nodes that are
+     * not configured enroll at runtime as usual.
+     *
+     * The description read by Load has one node per line, the node name
+     * (refer to ns3::Names) or id followed by its 3N name. Empty lines and
+     * lines starting with # are skipped:
+     *
+     * \code
+     *   # node   3N name
+     *   core     1
+     *   edge-1   1.1
+     *   edge-2   1.2
+     * \endcode
+     */
+    class SectorHierarchyHelper
+    {
+    public:
+      SectorHierarchyHelper ();
+
+      /**
+       * @brief Set the lease of the loaded names and NNST entries
+       *
+       * @param lease lease time, relative to the time Install is called
+       * @param fixed whether the names are never renewed (default true)
+       */
+      void
+      SetLease (Time lease, bool fixed);
+
+      /**
+       * @brief Set the metric of the loaded NNST entries
+       */
+      void
+      SetMetric (int32_t metric);
+
+      /**
+       * @brief Configure the 3N name of a node
+       */
+      void
+      AddNode (Ptr<Node> node, const std::string &name);
+
+      /**
+       * @brief Configure the 3N name of a node
+       * @param nodeName node name (refer to ns3::Names) or id
+       */
+      void
+      AddNode (const std::string &nodeName, const std::string &name);
+
+      /**
+       * @brief Configure the 3N names listed in a description
+       * @returns number of nodes read
+       */
+      uint32_t
+      Load (std::istream &is);
+
+      /**
+       * @brief Configure the 3N names listed in a description file
+       * @returns number of nodes read
+       */
+      uint32_t
+      Load (const std::string &file);
+
+      /**
+       * @brief Give every configured node its 3N name and fill the NNSTs between neighbouring sectors
+       *
+       * Call once the 3N stack is installed, normally before the simulation starts
+       *
+       * @returns number of NNST entries added
+       */
+      uint32_t
+      Install () const;
+
+    private:
+      std::map<uint32_t, std::string> m_names; ///< @brief 3N name of every configured node id
+      Time m_lease;
+      bool m_fixed;
+      int32_t m_metric;
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_SECTOR_HIERARCHY_HELPER_H_ */
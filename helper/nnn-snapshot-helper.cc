@@ -0,0 +1,517 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-snapshot-helper.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-snapshot-helper.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-snapshot-helper.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/address.h"
+#include "ns3/buffer.h"
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+#include "nnn-snapshot-helper.h"
+#include "nnn-names-container.h"
+
+#include "../model/nnn-l3-protocol.h"
+#include "../model/nnn-net-device-face.h"
+#include "../model/cs/nnn-icn-content-store.h"
+#include "../model/fib/nnn-fib.h"
+#include "../model/fib/nnn-fib-entry.h"
+#include "../model/fw/nnn-forwarding-strategy.h"
+#include "../model/nnpt/nnn-nnpt.h"
+#include "../model/nnpt/nnn-nnpt-entry.h"
+#include "../model/nnst/nnn-nnst.h"
+#include "../model/nnst/nnn-nnst-entry.h"
+#include "../model/wire/icn-wire.h"
+#include "../model/wire/nnn-wire.h"
+#include "../model/wire/wire-nnnsim.h"
+#include "../model/wire/wire-nnnsim-icn.h"
+#include "../utils/nnn-mapped-file.h"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.SnapshotHelper");
+
+  namespace nnn
+  {
+    static const char g_magic[8] = { 'N', 'N', 'N', 'S', 'N', 'A', 'P', '1' };
+
+    // Magic, time and node count, then 20 bytes per node in the index
+    static const size_t HEADER_SIZE = 8 + 8 + 4;
+    static const size_t INDEX_ENTRY_SIZE = 4 + 8 + 8;
+
+    static void
+    PutInt (std::string &buf, uint64_t value, int bytes)
+    {
+      for (int i = 0; i < bytes; i++)
+	{
+	  buf.push_back (static_cast<char> (value & 0xFF));
+	  value >>= 8;
+	}
+    }
+
+    static void
+    PutBytes (std::string &buf, const std::string &bytes)
+    {
+      PutInt (buf, bytes.size (), 4);
+      buf.append (bytes);
+    }
+
+    static void
+    PutAddress (std::string &buf, const Address &address)
+    {
+      uint8_t raw[Address::MAX_SIZE + 2];
+      uint32_t len = address.CopyAllTo (raw, sizeof (raw));
+
+      PutInt (buf, len, 1);
+      buf.append (reinterpret_cast<const char *> (raw), len);
+    }
+
+    // Lease left at the time of the snapshot
+    static void
+    PutLease (std::string &buf, Time expire)
+    {
+      PutInt (buf, static_cast<uint64_t> ((expire - Simulator::Now ()).GetNanoSeconds ()), 8);
+    }
+
+    /**
+     * @brief Bounds checked reader over the mapped snapshot
+     */
+    class SnapshotReader
+    {
+    public:
+      SnapshotReader (const char *data, size_t size)
+      : m_data (data)
+      , m_size (size)
+      , m_pos  (0)
+      {
+      }
+
+      void
+      Seek (size_t pos)
+      {
+	if (pos > m_size)
+	  NS_FATAL_ERROR ("Snapshot is truncated at byte " << m_size);
+	m_pos = pos;
+      }
+
+      uint64_t
+      GetInt (int bytes)
+      {
+	Need (bytes);
+
+	uint64_t value = 0;
+	for (int i = bytes - 1; i >= 0; i--)
+	  {
+	    value = (value << 8) | static_cast<uint8_t> (m_data[m_pos + i]);
+	  }
+	m_pos += bytes;
+	return value;
+      }
+
+      // ns-3 Buffers own their memory, so every record is copied once from
+      // the mapping into the Buffer or Packet it is decoded from
+      Ptr<NNNAddress>
+      GetName ()
+      {
+	Buffer buffer = GetBuffer ();
+	Buffer::Iterator i = buffer.Begin ();
+	return wire::NnnSim::DeserializeName (i);
+      }
+
+      Ptr<icn::Name>
+      GetPrefix ()
+      {
+	Buffer buffer = GetBuffer ();
+	Buffer::Iterator i = buffer.Begin ();
+	return icn::wire::IcnSim::DeserializeName (i);
+      }
+
+      Ptr<Packet>
+      GetPacket ()
+      {
+	size_t len = GetInt (4);
+	Need (len);
+
+	Ptr<Packet> packet = Create<Packet> (reinterpret_cast<const uint8_t *> (m_data + m_pos), len);
+	m_pos += len;
+	return packet;
+      }
+
+      Address
+      GetAddress ()
+      {
+	uint8_t len = GetInt (1);
+	Need (len);
+
+	Address address;
+	address.CopyAllFrom (reinterpret_cast<const uint8_t *> (m_data + m_pos), len);
+	m_pos += len;
+	return address;
+      }
+
+      Time
+      GetLease ()
+      {
+	return NanoSeconds (static_cast<int64_t> (GetInt (8)));
+      }
+
+    private:
+      Buffer
+      GetBuffer ()
+      {
+	size_t len = GetInt (4);
+	Need (len);
+
+	Buffer buffer;
+	buffer.AddAtStart (len);
+	Buffer::Iterator i = buffer.Begin ();
+	i.Write (reinterpret_cast<const uint8_t *> (m_data + m_pos), len);
+	m_pos += len;
+	return buffer;
+      }
+
+      void
+      Need (size_t bytes) const
+      {
+	if (m_pos + bytes > m_size)
+	  NS_FATAL_ERROR ("Snapshot is truncated at byte " << m_pos);
+      }
+
+      const char *m_data;
+      size_t m_size;
+      size_t m_pos;
+    };
+
+    static bool
+    IsSaved (Ptr<Face> face)
+    {
+      return DynamicCast<NetDeviceFace> (face) != 0;
+    }
+
+    static uint32_t
+    SaveNames (std::string &buf, Ptr<const NamesContainer> names)
+    {
+      uint32_t count = 0;
+      std::string records;
+
+      for (NamesContainer::names_set::const_iterator it = names->Begin (); it != names->End (); it++)
+	{
+	  if (it->m_lease_expire <= Simulator::Now () && !it->m_fixed)
+	    continue;
+
+	  PutBytes (records, Wire::FromName (it->m_name));
+	  PutLease (records, it->m_lease_expire);
+	  PutInt (records, it->m_fixed ? 1 : 0, 1);
+	  count++;
+	}
+
+      PutInt (buf, count, 4);
+      buf.append (records);
+      return count;
+    }
+
+    static uint32_t
+    SaveNode (std::string &buf, Ptr<Node> node)
+    {
+      Ptr<ForwardingStrategy> fw = node->GetObject<ForwardingStrategy> ();
+      NS_ASSERT_MSG (fw != 0, "3N stack should be installed on node " << node->GetId ());
+
+      uint32_t saved = 0;
+      saved += SaveNames (buf, fw->GetNodeNames ());
+      saved += SaveNames (buf, fw->GetLeasedNames ());
+
+      uint32_t count = 0;
+      std::string records;
+
+      Ptr<NNST> nnst = node->GetObject<NNST> ();
+      for (Ptr<nnst::Entry> entry = nnst->Begin (); entry != nnst->End (); entry = nnst->Next (entry))
+	{
+	  std::string name = Wire::FromName (entry->GetAddressPtr ());
+
+	  for (nnst::fmtr_set::iterator fm = entry->m_faces.begin (); fm != entry->m_faces.end (); fm++)
+	    {
+	      if (!IsSaved (fm->GetFace ()) || fm->GetExpireTime () <= Simulator::Now ())
+		continue;
+
+	      PutBytes (records, name);
+	      PutInt (records, fm->GetFace ()->GetId (), 4);
+	      PutAddress (records, fm->GetAddress ());
+	      PutLease (records, fm->GetExpireTime ());
+	      PutInt (records, static_cast<uint32_t> (fm->GetRoutingCost ()), 4);
+	      count++;
+	    }
+	}
+      PutInt (buf, count, 4);
+      buf.append (records);
+      saved += count;
+
+      count = 0;
+      records.clear ();
+
+      Ptr<NNPT> nnpt = node->GetObject<NNPT> ();
+      for (NNPT::pair_set::iterator it = nnpt->container.begin (); it != nnpt->container.end (); it++)
+	{
+	  if (it->m_lease_expire <= Simulator::Now ())
+	    continue;
+
+	  PutBytes (records, Wire::FromName (it->m_oldName));
+	  PutBytes (records, Wire::FromName (it->m_newName));
+	  PutLease (records, it->m_lease_expire);
+	  count++;
+	}
+      PutInt (buf, count, 4);
+      buf.append (records);
+      saved += count;
+
+      count = 0;
+      records.clear ();
+
+      Ptr<Fib> fib = node->GetObject<Fib> ();
+      for (Ptr<const fib::Entry> entry = fib->Begin (); entry != fib->End (); entry = fib->Next (entry))
+	{
+	  std::string prefix = icn::Wire::FromName (entry->m_prefix);
+
+	  for (fib::FaceMetricContainer::type::const_iterator fm = entry->m_faces.begin (); fm != entry->m_faces.end (); fm++)
+	    {
+	      if (!IsSaved (fm->GetFace ()))
+		continue;
+
+	      PutBytes (records, prefix);
+	      PutInt (records, fm->GetFace ()->GetId (), 4);
+	      PutInt (records, static_cast<uint32_t> (fm->GetRoutingCost ()), 4);
+	      count++;
+	    }
+	}
+      PutInt (buf, count, 4);
+      buf.append (records);
+      saved += count;
+
+      count = 0;
+      records.clear ();
+
+      Ptr<ContentStore> cs = node->GetObject<ContentStore> ();
+      if (cs != 0)
+	{
+	  for (Ptr<cs::Entry> entry = cs->Begin (); entry != cs->End (); entry = cs->Next (entry))
+	    {
+	      PutBytes (records, icn::Wire::FromDataStr (entry->GetData ()));
+	      count++;
+	    }
+	}
+      PutInt (buf, count, 4);
+      buf.append (records);
+      saved += count;
+
+      return saved;
+    }
+
+    static void
+    SaveAll (std::string file)
+    {
+      SnapshotHelper::Save (file);
+    }
+
+    uint32_t
+    SnapshotHelper::Save (const std::string &file)
+    {
+      return Save (file, NodeContainer::GetGlobal ());
+    }
+
+    uint32_t
+    SnapshotHelper::Save (const std::string &file, const NodeContainer &nodes)
+    {
+      NS_LOG_FUNCTION (file << nodes.GetN ());
+
+      std::string header (g_magic, sizeof (g_magic));
+      PutInt (header, static_cast<uint64_t> (Simulator::Now ().GetNanoSeconds ()), 8);
+      PutInt (header, nodes.GetN (), 4);
+
+      std::string index;
+      std::string sections;
+      uint64_t offset = HEADER_SIZE + INDEX_ENTRY_SIZE * nodes.GetN ();
+      uint32_t saved = 0;
+
+      for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+	{
+	  std::string section;
+	  saved += SaveNode (section, *node);
+
+	  PutInt (index, (*node)->GetId (), 4);
+	  PutInt (index, offset, 8);
+	  PutInt (index, section.size (), 8);
+
+	  sections.append (section);
+	  offset += section.size ();
+	}
+
+      std::ofstream os (file.c_str (), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+      if (!os.is_open ())
+	NS_FATAL_ERROR ("Cannot open snapshot " << file << " for writing");
+
+      os.write (header.data (), header.size ());
+      os.write (index.data (), index.size ());
+      os.write (sections.data (), sections.size ());
+
+      NS_LOG_INFO ("Saved " << saved << " records of " << nodes.GetN () << " nodes in " << file);
+      return saved;
+    }
+
+    void
+    SnapshotHelper::SaveAt (Time at, const std::string &file)
+    {
+      NS_ASSERT (at >= Simulator::Now ());
+
+      Simulator::Schedule (at - Simulator::Now (), &SaveAll, file);
+    }
+
+    static Ptr<Face>
+    FindFace (Ptr<Node> node, uint32_t faceId)
+    {
+      Ptr<Face> face = node->GetObject<L3Protocol> ()->GetFaceById (faceId);
+      NS_ABORT_MSG_IF (face == 0, "Node " << node->GetId () << " has no face " << faceId
+		       << ", the snapshot was taken on another topology");
+      return face;
+    }
+
+    static uint32_t
+    LoadNode (SnapshotReader &reader, Ptr<Node> node)
+    {
+      Ptr<ForwardingStrategy> fw = node->GetObject<ForwardingStrategy> ();
+      NS_ASSERT_MSG (fw != 0, "3N stack should be installed on node " << node->GetId ());
+
+      Time now = Simulator::Now ();
+      uint32_t loaded = 0;
+
+      for (uint32_t count = reader.GetInt (4); count > 0; count--, loaded++)
+	{
+	  Ptr<const NNNAddress> name = reader.GetName ();
+	  Time lease = now + reader.GetLease ();
+	  bool fixed = reader.GetInt (1) != 0;
+
+	  fw->SetNode3NName (name, lease, fixed);
+	}
+
+      for (uint32_t count = reader.GetInt (4); count > 0; count--, loaded++)
+	{
+	  Ptr<const NNNAddress> name = reader.GetName ();
+	  Time lease = now + reader.GetLease ();
+	  bool fixed = reader.GetInt (1) != 0;
+
+	  fw->AddLeasedName (name, lease, fixed);
+	}
+
+      Ptr<NNST> nnst = node->GetObject<NNST> ();
+      for (uint32_t count = reader.GetInt (4); count > 0; count--, loaded++)
+	{
+	  Ptr<const NNNAddress> name = reader.GetName ();
+	  Ptr<Face> face = FindFace (node, reader.GetInt (4));
+	  Address poa = reader.GetAddress ();
+	  Time lease = now + reader.GetLease ();
+	  int32_t metric = static_cast<int32_t> (reader.GetInt (4));
+
+	  nnst->Add (name, face, poa, lease, metric);
+	}
+
+      Ptr<NNPT> nnpt = node->GetObject<NNPT> ();
+      for (uint32_t count = reader.GetInt (4); count > 0; count--, loaded++)
+	{
+	  Ptr<const NNNAddress> oldName = reader.GetName ();
+	  Ptr<const NNNAddress> newName = reader.GetName ();
+	  Time lease = now + reader.GetLease ();
+
+	  nnpt->addEntry (oldName, newName, lease);
+	}
+
+      Ptr<Fib> fib = node->GetObject<Fib> ();
+      for (uint32_t count = reader.GetInt (4); count > 0; count--, loaded++)
+	{
+	  Ptr<const icn::Name> prefix = reader.GetPrefix ();
+	  Ptr<Face> face = FindFace (node, reader.GetInt (4));
+	  int32_t metric = static_cast<int32_t> (reader.GetInt (4));
+
+	  fib->Add (prefix, face, metric);
+	}
+
+      Ptr<ContentStore> cs = node->GetObject<ContentStore> ();
+      for (uint32_t count = reader.GetInt (4); count > 0; count--)
+	{
+	  Ptr<Packet> data = reader.GetPacket ();
+	  if (cs == 0)
+	    continue;
+
+	  cs->Add (icn::Wire::ToData (data));
+	  loaded++;
+	}
+
+      return loaded;
+    }
+
+    uint32_t
+    SnapshotHelper::Load (const std::string &file)
+    {
+      NS_LOG_FUNCTION (file);
+
+      MappedFile mapped;
+      if (!mapped.Open (file))
+	NS_FATAL_ERROR ("Cannot open snapshot " << file);
+
+      if (mapped.GetSize () < HEADER_SIZE || std::memcmp (mapped.GetData (), g_magic, sizeof (g_magic)) != 0)
+	NS_FATAL_ERROR (file << " is not a 3N snapshot");
+
+      SnapshotReader header (mapped.GetData (), mapped.GetSize ());
+      header.Seek (sizeof (g_magic));
+      Time taken = NanoSeconds (static_cast<int64_t> (header.GetInt (8)));
+      uint32_t nodes = header.GetInt (4);
+
+      NS_LOG_INFO ("Loading snapshot of " << nodes << " nodes taken at " << taken.GetSeconds () << "s");
+
+      uint32_t loaded = 0;
+      for (uint32_t n = 0; n < nodes; n++)
+	{
+	  uint32_t id = header.GetInt (4);
+	  uint64_t offset = header.GetInt (8);
+	  uint64_t length = header.GetInt (8);
+
+	  if (id >= NodeList::GetNNodes ())
+	    {
+	      NS_LOG_WARN ("Node " << id << " of the snapshot does not exist, skipped");
+	      continue;
+	    }
+
+	  if (offset + length > mapped.GetSize ())
+	    NS_FATAL_ERROR ("Snapshot " << file << " is truncated");
+
+	  // Sections are read from the mapping, see SnapshotReader for the copies
+	  SnapshotReader section (mapped.GetData () + offset, length);
+	  loaded += LoadNode (section, NodeList::GetNode (id));
+	}
+
+      NS_LOG_INFO ("Loaded " << loaded << " records from " << file);
+      return loaded;
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-snapshot-helper.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-snapshot-helper.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-snapshot-helper.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_SNAPSHOT_HELPER_H_
+#define NNN_SNAPSHOT_HELPER_H_
+
+#include "ns3/nstime.h"
+#include "ns3/node-container.h"
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Saves the 3N and ICN tables of a simulation to load them at the start of later runs
+     *
+     * A snapshot holds, per node, the 3N names of the node, the names it
+     * leased to its neighbours, the NNST, NNPT, FIB and content store. Runs
+     * building the same topology with the same stack can load it at t=0
+     * instead of going through enrollment, route population and cache
+     * warm-up again:
+     *
+     * \code
+     *   // Warm-up run
+     *   SnapshotHelper::SaveAt (Seconds (60.0), "warm.snap");
+     *
+     *   // Later runs, after installing the stack
+     *   SnapshotHelper::Load ("warm.snap");
+     * \endcode
+     *
+     * Faces are referred to by their id, so the loading run must create the
+     * nodes, devices and stacks in the same order. Only entries over
+     * NetDeviceFaces are kept, the entries of application faces are made
+     * again by the applications when they start. Leases are stored as the
+     * time they had left when saved and count from the time they are loaded.
+     *
+     * The file is made to be read through a memory mapping. It starts with
+     * the magic string "NNNSNAP1", the time of the snapshot (8 byte
+     * nanoseconds) and the number of nodes (4 bytes), followed by an index
+     * of node id (4 bytes), offset and length (8 bytes each) of the section
+     * of every node. A section holds six tables, each a 4 byte record count
+     * followed by its records:
+     *
+     *  - Node names and leased names: name, lease left, fixed flag (1 byte)
+     *  - NNST: name, face id, PoA, lease left, metric
+     *  - NNPT: old name, new name, lease left
+     *  - FIB: ICN prefix, face id, metric
+     *  - Content store: Data
+     *
+     * Names, prefixes and Data are stored in their Wire format as a 4 byte
+     * length followed by the bytes, PoAs as the serialized ns3::Address, lease
+     * times as 8 byte nanoseconds. All fields are little endian.
+     *
+     * Load decodes the sections from the mapping, each name and Data is
+     * copied once into the ns-3 Buffer or Packet it is decoded from.
+     */
+    class SnapshotHelper
+    {
+    public:
+      /**
+       * @brief Save the tables of every node now
+       * @returns number of records saved
+       */
+      static uint32_t
+      Save (const std::string &file);
+
+      /**
+       * @brief Save the tables of the given nodes now
+       * @returns number of records saved
+       */
+      static uint32_t
+      Save (const std::string &file, const NodeContainer &nodes);
+
+      /**
+       * @brief Save the tables of every node at an absolute simulation time
+       */
+      static void
+      SaveAt (Time at, const std::string &file);
+
+      /**
+       * @brief Load a snapshot into the nodes of the simulation
+       *
+       * The stack should be installed on every node of the snapshot. Nodes
+       * of the snapshot that do not exist are skipped with a warning.
+       *
+       * @returns number of records loaded
+       */
+      static uint32_t
+      Load (const std::string &file);
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_SNAPSHOT_HELPER_H_ */
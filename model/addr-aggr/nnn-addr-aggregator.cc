@@ -24,6 +24,8 @@
 
 #include "nnn-addr-aggregator.h"
 
+#include "../../utils/nnn-fast-path.h"
+
 namespace ns3
 {
   NS_LOG_COMPONENT_DEFINE("nnn.AddrAggregator");
@@ -23,6 +23,10 @@
 #ifndef NNN_ADDR_AGGREGATOR_H_
 #define NNN_ADDR_AGGREGATOR_H_
 
+#include "ns3/address.h"
+#include "ns3/callback.h"
+
+#include "../nnn-face.h"
 #include "../naming/nnn-address.h"
 #include "../../utils/trie/trie-with-policy.h"
 #include "../../utils/trie/counting-policy.h"
@@ -31,10 +35,35 @@ namespace ns3
 {
   namespace nnn
   {
+    /**
+     * @brief Forwarding decision cached for one aggregated 3N destination
+     *
+     * The sector and destination are maintained as addresses are added and
+     * removed. The remaining fields are filled by the forwarding strategy and
+     * are only valid for the generation recorded in the owning NNNAddrEntry
+     */
+    struct NNNAddrResolution
+    {
+      NNNAddrResolution ()
+      : m_redirect (false)
+      , m_buffered (false)
+      {
+      }
+
+      Ptr<NNNAddress> m_label;        ///< \brief Last label of the destination
+      Ptr<NNNAddress> m_destination;  ///< \brief Complete 3N name of the destination
+      Ptr<const NNNAddress> m_newdst; ///< \brief Destination after NNPT redirection
+      bool m_redirect;                ///< \brief NNPT holds a newer name for the destination
+      bool m_buffered;                ///< \brief PDUs to the destination must be buffered
+      Ptr<Face> m_outFace;            ///< \brief Next hop Face chosen from the NNST
+      Address m_destAddr;             ///< \brief Next hop PoA chosen from the NNST
+    };
 
     class NNNAddrEntry : public Object
     {
     public:
+      typedef Callback<void, NNNAddrResolution &> ResolveCallback;
+
       typedef nnnSIM::trie_with_policy<
 	  NNNAddress,
 	  nnnSIM::smart_pointer_payload_traits<NNNAddrEntry>,
@@ -52,6 +81,8 @@ namespace ns3
       : m_sector (Create<NNNAddress> ())
       , m_addresses (std::set<Ptr<NNNAddress>, PtrNNNComp> ())
       , m_totaladdr (0)
+      , m_resolved_valid (false)
+      , m_resolved_generation (0)
       , item_ (0)
       {
       }
@@ -66,6 +97,12 @@ namespace ns3
       SetSector(Ptr<NNNAddress> sector)
       {
 	m_sector = sector;
+
+	for (size_t i = 0; i < m_resolved.size (); i++)
+	  {
+	    m_resolved[i].m_destination = Create<NNNAddress> (*m_sector + *m_resolved[i].m_label);
+	  }
+	m_resolved_valid = false;
       }
 
       void
@@ -113,7 +150,14 @@ namespace ns3
       {
 	if (addr->isOneLabel ())
 	  {
-	    m_addresses.insert(addr);
+	    if (m_addresses.insert(addr).second)
+	      {
+		NNNAddrResolution res;
+		res.m_label = addr;
+		res.m_destination = Create<NNNAddress> (*m_sector + *addr);
+		m_resolved.push_back (res);
+		m_resolved_valid = false;
+	      }
 	    m_totaladdr++;
 	  }
       }
@@ -128,7 +172,42 @@ namespace ns3
 	  {
 	    m_addresses.erase(lastlabel);
 	    m_totaladdr--;
+
+	    for (std::vector<NNNAddrResolution>::iterator it = m_resolved.begin (); it != m_resolved.end (); ++it)
+	      {
+		if (*it->m_label == *lastlabel)
+		  {
+		    m_resolved.erase (it);
+		    break;
+		  }
+	      }
+	  }
+      }
+
+      /**
+       * \brief Obtain the complete destinations of this sector with their forwarding decision
+       *
+       * The decision is only recomputed, through resolve, when the set of
+       * destinations changed or the generation differs from the one used in
+       * the last computation
+       *
+       * \param generation Generation of the tables the decision depends on
+       * \param resolve Callback filling the forwarding decision of one destination
+       */
+      const std::vector<NNNAddrResolution> &
+      GetResolvedAddresses (uint64_t generation, ResolveCallback resolve) const
+      {
+	if (!m_resolved_valid || m_resolved_generation != generation)
+	  {
+	    for (size_t i = 0; i < m_resolved.size (); i++)
+	      {
+		resolve (m_resolved[i]);
+	      }
+	    m_resolved_valid = true;
+	    m_resolved_generation = generation;
 	  }
+
+	return m_resolved;
       }
 
       bool
@@ -162,6 +241,9 @@ namespace ns3
       Ptr<NNNAddress> m_sector;
       std::set<Ptr<NNNAddress>, PtrNNNComp> m_addresses;
       uint16_t m_totaladdr;
+      mutable std::vector<NNNAddrResolution> m_resolved;
+      mutable bool m_resolved_valid;
+      mutable uint64_t m_resolved_generation;
       trie::iterator item_;
     };
 
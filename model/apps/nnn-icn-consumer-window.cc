@@ -0,0 +1,307 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-icn-consumer-window.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-icn-consumer-window.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-icn-consumer-window.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "nnn-icn-consumer-window.h"
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/integer.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.ICNConsumerWindow");
+
+  namespace nnn
+  {
+    NS_OBJECT_ENSURE_REGISTERED (ConsumerWindow);
+
+    TypeId
+    ConsumerWindow::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::ICNConsumerWindow")
+	.SetGroupName ("Nnn")
+	.SetParent<Consumer> ()
+	.AddConstructor<ConsumerWindow> ()
+	.AddAttribute ("Window", "Initial size of the window, also used after a timeout",
+		       UintegerValue (1),
+		       MakeUintegerAccessor (&ConsumerWindow::m_initialWindow),
+		       MakeUintegerChecker<uint32_t> (1))
+	.AddAttribute ("MaxWindow", "Maximum size of the window",
+		       DoubleValue (1000.0),
+		       MakeDoubleAccessor (&ConsumerWindow::m_maxWindow),
+		       MakeDoubleChecker<double> (1.0))
+	.AddAttribute ("Beta", "Multiplicative decrease factor of the AIMD window",
+		       DoubleValue (0.5),
+		       MakeDoubleAccessor (&ConsumerWindow::m_beta),
+		       MakeDoubleChecker<double> (0.0, 1.0))
+	.AddAttribute ("InitialWindowOnTimeout", "Set the window to its initial size on timeouts instead of decreasing it",
+		       BooleanValue (true),
+		       MakeBooleanAccessor (&ConsumerWindow::m_resetOnTimeout),
+		       MakeBooleanChecker ())
+	.AddAttribute ("FreezeOnHandoff", "Do not decrease the window for Interests sent before a 3N name change",
+		       BooleanValue (true),
+		       MakeBooleanAccessor (&ConsumerWindow::m_freezeOnHandoff),
+		       MakeBooleanChecker ())
+	.AddAttribute ("UseCubic", "Grow the window with the CUBIC function instead of AIMD",
+		       BooleanValue (false),
+		       MakeBooleanAccessor (&ConsumerWindow::m_useCubic),
+		       MakeBooleanChecker ())
+	.AddAttribute ("CubicBeta", "Multiplicative decrease factor of the CUBIC window",
+		       DoubleValue (0.7),
+		       MakeDoubleAccessor (&ConsumerWindow::m_cubicBeta),
+		       MakeDoubleChecker<double> (0.0, 1.0))
+	.AddAttribute ("CubicC", "Scaling constant of the CUBIC function",
+		       DoubleValue (0.4),
+		       MakeDoubleAccessor (&ConsumerWindow::m_cubicC),
+		       MakeDoubleChecker<double> (0.0))
+	.AddAttribute ("MaxSeq",
+		       "Maximum sequence number to request",
+		       IntegerValue (std::numeric_limits<uint32_t>::max ()),
+		       MakeIntegerAccessor (&ConsumerWindow::m_seqMax),
+		       MakeIntegerChecker<uint32_t> ())
+	.AddTraceSource ("WindowTrace", "Window that controls how many outstanding Interests are allowed",
+			 MakeTraceSourceAccessor (&ConsumerWindow::m_window),
+			 "ns3::TracedValue::DoubleCallback")
+	.AddTraceSource ("InFlight", "Current number of outstanding Interests",
+			 MakeTraceSourceAccessor (&ConsumerWindow::m_inFlight),
+			 "ns3::TracedValue::Uint32Callback")
+	;
+      return tid;
+    }
+
+    ConsumerWindow::ConsumerWindow ()
+    : m_initialWindow   (1)
+    , m_maxWindow       (1000.0)
+    , m_beta            (0.5)
+    , m_resetOnTimeout  (true)
+    , m_freezeOnHandoff (true)
+    , m_useCubic        (false)
+    , m_cubicBeta       (0.7)
+    , m_cubicC          (0.4)
+    , m_cubicWmax       (0.0)
+    , m_ssthresh        (1000.0)
+    , m_recoverySeq     (0)
+    , m_lastHandoff     (Seconds (-1.0))
+    , m_window          (1.0)
+    , m_inFlight        (0)
+    {
+      NS_LOG_FUNCTION_NOARGS ();
+      m_seqMax = std::numeric_limits<uint32_t>::max ();
+    }
+
+    ConsumerWindow::~ConsumerWindow ()
+    {
+    }
+
+    void
+    ConsumerWindow::StartApplication ()
+    {
+      NS_LOG_FUNCTION_NOARGS ();
+
+      m_window = m_initialWindow;
+      m_ssthresh = m_maxWindow;
+      m_cubicWmax = 0.0;
+      m_cubicEpoch = Simulator::Now ();
+      m_recoverySeq = 0;
+
+      Consumer::StartApplication ();
+    }
+
+    void
+    ConsumerWindow::ScheduleNextPacket ()
+    {
+      m_inFlight = GetOutstanding ();
+
+      if (m_sendEvent.IsRunning ())
+	return;
+
+      if (m_inFlight >= static_cast<uint32_t> (m_window))
+	return; // OnData, OnNack or OnTimeout will open the window
+
+      // A number drawn while its slot was busy is sent before m_seq
+      uint32_t next = (m_pendingSeq != std::numeric_limits<uint32_t>::max ()) ? m_pendingSeq : m_seq;
+      if (!HasQueuedRetx () && (m_seq >= m_seqMax || !IsRetxSlotFree (next)))
+	return; // nothing left to request or no room in the ring buffer
+
+      m_sendEvent = Simulator::ScheduleNow (&Consumer::SendPacket, this);
+    }
+
+    void
+    ConsumerWindow::OnData (Ptr<const Data> contentObject)
+    {
+      if (!m_active) return;
+
+      uint32_t seq = contentObject->GetName ().get (-1).toSeqNum ();
+
+      // Only the first Data of each sequence number counts towards the window
+      bool first = IsUnsatisfied (seq);
+
+      Consumer::OnData (contentObject);
+
+      if (first)
+	IncreaseWindow ();
+
+      ScheduleNextPacket ();
+    }
+
+    void
+    ConsumerWindow::OnNack (Ptr<const Interest> interest)
+    {
+      if (!m_active) return;
+
+      DecreaseWindow (interest->GetName ().get (-1).toSeqNum (), false);
+
+      Consumer::OnNack (interest);
+    }
+
+    void
+    ConsumerWindow::OnTimeout (uint32_t sequenceNumber)
+    {
+      DecreaseWindow (sequenceNumber, true);
+
+      Consumer::OnTimeout (sequenceNumber);
+    }
+
+    void
+    ConsumerWindow::WillSendOutInterest (uint32_t sequenceNumber)
+    {
+      Consumer::WillSendOutInterest (sequenceNumber);
+
+      m_inFlight = GetOutstanding ();
+    }
+
+    void
+    ConsumerWindow::GotName ()
+    {
+      Ptr<const NNNAddress> old = m_current3Nname;
+      bool had = m_has3Nname;
+
+      Consumer::GotName ();
+
+      if (!had || !old || *old != *m_current3Nname)
+	{
+	  m_lastHandoff = Simulator::Now ();
+	}
+    }
+
+    void
+    ConsumerWindow::NoName ()
+    {
+      Consumer::NoName ();
+
+      m_lastHandoff = Simulator::Now ();
+    }
+
+    void
+    ConsumerWindow::IncreaseWindow ()
+    {
+      double window = m_window;
+
+      if (window < m_ssthresh)
+	{
+	  // Slow start
+	  window += 1.0;
+	}
+      else if (m_useCubic)
+	{
+	  double rtt = m_rtt->GetCurrentEstimate ().GetSeconds ();
+	  double t = (Simulator::Now () - m_cubicEpoch).GetSeconds ();
+	  double k = std::pow (m_cubicWmax * (1.0 - m_cubicBeta) / m_cubicC, 1.0 / 3.0);
+
+	  // Window the CUBIC function reaches one RTT from now
+	  double target = m_cubicC * std::pow (t + rtt - k, 3.0) + m_cubicWmax;
+
+	  // Never grow slower than AIMD would have from the same decrease
+	  if (rtt > 0)
+	    {
+	      double aimd = m_cubicWmax * m_cubicBeta +
+		  3.0 * (1.0 - m_cubicBeta) / (1.0 + m_cubicBeta) * (t / rtt);
+	      target = std::max (target, aimd);
+	    }
+
+	  if (target > window)
+	    window += (target - window) / window;
+	  else
+	    window += 0.01 / window;
+	}
+      else
+	{
+	  // Congestion avoidance
+	  window += 1.0 / window;
+	}
+
+      m_window = std::min (window, m_maxWindow);
+    }
+
+    void
+    ConsumerWindow::DecreaseWindow (uint32_t sequenceNumber, bool timeout)
+    {
+      if (m_freezeOnHandoff && SentBeforeHandoff (sequenceNumber))
+	{
+	  NS_LOG_INFO ("Seq " << std::dec << sequenceNumber << " lost to a 3N name change, window kept at " << m_window);
+	  return;
+	}
+
+      if (sequenceNumber < m_recoverySeq)
+	return; // Already reacted to a loss in this window
+
+      m_recoverySeq = m_seq;
+
+      double window = m_window;
+      if (m_useCubic)
+	{
+	  m_cubicWmax = window;
+	  m_cubicEpoch = Simulator::Now ();
+	  m_ssthresh = std::max (2.0, window * m_cubicBeta);
+	}
+      else
+	{
+	  m_ssthresh = std::max (2.0, window * m_beta);
+	}
+
+      if (timeout && m_resetOnTimeout)
+	m_window = m_initialWindow;
+      else
+	m_window = std::max (1.0, m_ssthresh);
+
+      NS_LOG_INFO ("Loss of seq " << std::dec << sequenceNumber << (timeout ? " (timeout)" : " (NACK)")
+		   << ", window " << window << " -> " << m_window << ", ssthresh " << m_ssthresh);
+    }
+
+    bool
+    ConsumerWindow::SentBeforeHandoff (uint32_t sequenceNumber) const
+    {
+      Time sent;
+      if (!GetLastSendTime (sequenceNumber, sent))
+	return false;
+
+      return sent <= m_lastHandoff;
+    }
+  } // namespace nnn
+} // namespace ns3
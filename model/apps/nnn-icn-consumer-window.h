@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-icn-consumer-window.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-icn-consumer-window.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-icn-consumer-window.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_CONSUMER_WINDOW_H
+#define NNN_CONSUMER_WINDOW_H
+
+#include "ns3/traced-value.h"
+
+#include "nnn-icn-consumer.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @ingroup nnn-apps
+     * @brief Nnn application for sending out Interest packets controlled by a congestion window
+     *
+     * The window grows by one per Data in slow start and by 1/window per Data
+     * afterwards (AIMD) or following the CUBIC function when UseCubic is set.
+     * Timeouts and NACKs are treated as loss events and decrease the window at
+     * most once per window of Interests.
+     *
+     * Interests that were last sent before the node lost or changed its 3N
+     * name are lost to the handoff and not to congestion, so with
+     * FreezeOnHandoff set their loss does not decrease the window.
+     */
+    class ConsumerWindow: public Consumer
+    {
+    public:
+      static TypeId GetTypeId ();
+
+      /**
+       * \brief Default constructor
+       */
+      ConsumerWindow ();
+      virtual ~ConsumerWindow ();
+
+      virtual void
+      OnData (Ptr<const Data> contentObject);
+
+      virtual void
+      OnNack (Ptr<const Interest> interest);
+
+      virtual void
+      OnTimeout (uint32_t sequenceNumber);
+
+      virtual void
+      WillSendOutInterest (uint32_t sequenceNumber);
+
+      virtual void
+      GotName ();
+
+      virtual void
+      NoName ();
+
+    protected:
+      // from App
+      virtual void
+      StartApplication ();
+
+      /**
+       * \brief Sends the next Interest if the window allows it
+       */
+      virtual void
+      ScheduleNextPacket ();
+
+      /**
+       * @brief Grow the window after a Data packet was received
+       */
+      void
+      IncreaseWindow ();
+
+      /**
+       * @brief Shrink the window after a loss
+       * @param sequenceNumber lost sequence number
+       * @param timeout true if the loss was detected by a retransmission timeout
+       */
+      void
+      DecreaseWindow (uint32_t sequenceNumber, bool timeout);
+
+      /**
+       * @brief Whether the last transmission of the sequence number happened before the last 3N name change
+       */
+      bool
+      SentBeforeHandoff (uint32_t sequenceNumber) const;
+
+    protected:
+      uint32_t             m_initialWindow;   ///< @brief Window at the start and after a timeout
+      double               m_maxWindow;       ///< @brief Upper bound of the window
+      double               m_beta;            ///< @brief AIMD multiplicative decrease factor
+      bool                 m_resetOnTimeout;  ///< @brief Go back to the initial window on timeouts
+      bool                 m_freezeOnHandoff; ///< @brief Do not decrease the window for handoff losses
+
+      bool                 m_useCubic;        ///< @brief Use CUBIC window growth
+      double               m_cubicBeta;       ///< @brief CUBIC multiplicative decrease factor
+      double               m_cubicC;          ///< @brief CUBIC scaling constant
+      double               m_cubicWmax;       ///< @brief Window before the last CUBIC decrease
+      Time                 m_cubicEpoch;      ///< @brief Time of the last CUBIC decrease
+
+      double               m_ssthresh;        ///< @brief Slow start threshold
+      uint32_t             m_recoverySeq;     ///< @brief Losses of lower sequence numbers do not decrease the window again
+      Time                 m_lastHandoff;     ///< @brief Time of the last 3N name change
+
+      TracedValue<double>   m_window;         ///< @brief Current window
+      TracedValue<uint32_t> m_inFlight;       ///< @brief Interests sent and not yet satisfied, NACKed or timed out
+    };
+  } // namespace nnn
+} // namespace ns3
+
+#endif
@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-icn-consumer-zipf-mandelbrot.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-icn-consumer-zipf-mandelbrot.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-icn-consumer-zipf-mandelbrot.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "nnn-icn-consumer-zipf-mandelbrot.h"
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.ICNConsumerZipfMandelbrot");
+
+  namespace nnn
+  {
+    NS_OBJECT_ENSURE_REGISTERED (ConsumerZipfMandelbrot);
+
+    TypeId
+    ConsumerZipfMandelbrot::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::ICNConsumerZipfMandelbrot")
+	.SetGroupName ("Nnn")
+	.SetParent<ConsumerCbr> ()
+	.AddConstructor<ConsumerZipfMandelbrot> ()
+	.AddAttribute ("NumberOfContents", "Number of contents in the catalog",
+		       UintegerValue (100),
+		       MakeUintegerAccessor (&ConsumerZipfMandelbrot::m_numOfContents),
+		       MakeUintegerChecker<uint32_t> (1))
+	.AddAttribute ("q", "Parameter q of the Zipf-Mandelbrot distribution",
+		       DoubleValue (0.7),
+		       MakeDoubleAccessor (&ConsumerZipfMandelbrot::m_q),
+		       MakeDoubleChecker<double> (0.0))
+	.AddAttribute ("s", "Parameter s of the Zipf-Mandelbrot distribution",
+		       DoubleValue (0.7),
+		       MakeDoubleAccessor (&ConsumerZipfMandelbrot::m_s),
+		       MakeDoubleChecker<double> (0.0))
+	.AddAttribute ("TraceFile", "File with the sequence numbers to request, one per line. Empty uses the catalog",
+		       StringValue (""),
+		       MakeStringAccessor (&ConsumerZipfMandelbrot::m_traceFile),
+		       MakeStringChecker ())
+	.AddAttribute ("TraceLoop", "Replay the trace from the beginning once it is over",
+		       BooleanValue (true),
+		       MakeBooleanAccessor (&ConsumerZipfMandelbrot::m_traceLoop),
+		       MakeBooleanChecker ())
+	;
+      return tid;
+    }
+
+    ConsumerZipfMandelbrot::ConsumerZipfMandelbrot ()
+    : m_numOfContents (100)
+    , m_q             (0.7)
+    , m_s             (0.7)
+    , m_seqRng        (CreateObject<UniformRandomVariable> ())
+    , m_traceLoop     (true)
+    , m_tracePos      (0)
+    {
+      NS_LOG_FUNCTION_NOARGS ();
+    }
+
+    ConsumerZipfMandelbrot::~ConsumerZipfMandelbrot ()
+    {
+    }
+
+    void
+    ConsumerZipfMandelbrot::StartApplication ()
+    {
+      NS_LOG_FUNCTION_NOARGS ();
+
+      if (m_traceFile.empty ())
+	{
+	  BuildCdf ();
+	}
+      else
+	{
+	  if (!m_trace.Open (m_traceFile))
+	    NS_FATAL_ERROR ("Cannot read request trace " << m_traceFile);
+
+	  m_tracePos = 0;
+	}
+
+      ConsumerCbr::StartApplication ();
+    }
+
+    void
+    ConsumerZipfMandelbrot::StopApplication ()
+    {
+      NS_LOG_FUNCTION_NOARGS ();
+
+      ConsumerCbr::StopApplication ();
+
+      m_trace.Close ();
+    }
+
+    void
+    ConsumerZipfMandelbrot::BuildCdf ()
+    {
+      m_cdf.resize (m_numOfContents + 1);
+
+      m_cdf[0] = 0.0;
+      for (uint32_t k = 1; k <= m_numOfContents; k++)
+	{
+	  m_cdf[k] = m_cdf[k - 1] + 1.0 / std::pow (k + m_q, m_s);
+	}
+
+      double total = m_cdf[m_numOfContents];
+      for (uint32_t k = 1; k <= m_numOfContents; k++)
+	{
+	  m_cdf[k] /= total;
+	}
+
+      NS_LOG_DEBUG ("Catalog of " << m_numOfContents << " contents, P(1) = " << m_cdf[1]);
+    }
+
+    uint32_t
+    ConsumerZipfMandelbrot::NextSequenceNumber ()
+    {
+      if (!m_traceFile.empty ())
+	return NextTraceSequenceNumber ();
+
+      double p = m_seqRng->GetValue (0.0, 1.0);
+
+      // Smallest rank whose cumulative probability reaches p
+      std::vector<double>::const_iterator rank = std::lower_bound (m_cdf.begin () + 1, m_cdf.end (), p);
+      if (rank == m_cdf.end ())
+	return m_numOfContents;
+
+      return rank - m_cdf.begin ();
+    }
+
+    uint32_t
+    ConsumerZipfMandelbrot::NextTraceSequenceNumber ()
+    {
+      const char *data = m_trace.GetData ();
+      size_t size = m_trace.GetSize ();
+
+      for (int pass = 0; pass < 2; pass++)
+	{
+	  while (m_tracePos < size)
+	    {
+	      size_t pos = m_tracePos;
+	      size_t end = pos;
+	      while (end < size && data[end] != '\n')
+		end++;
+
+	      m_tracePos = (end < size) ? end + 1 : size;
+
+	      while (pos < end && (data[pos] == ' ' || data[pos] == '\t'))
+		pos++;
+
+	      if (pos == end || data[pos] == '#' || data[pos] == '\r')
+		continue;
+
+	      uint64_t seq = 0;
+	      size_t digits = pos;
+	      while (digits < end && data[digits] >= '0' && data[digits] <= '9')
+		{
+		  seq = seq * 10 + (data[digits] - '0');
+		  digits++;
+		}
+
+	      if (digits == pos || seq >= std::numeric_limits<uint32_t>::max ())
+		{
+		  NS_LOG_WARN ("Skipping invalid line in request trace " << m_traceFile);
+		  continue;
+		}
+
+	      return seq;
+	    }
+
+	  if (!m_traceLoop)
+	    break;
+
+	  m_tracePos = 0;
+	}
+
+      return std::numeric_limits<uint32_t>::max ();
+    }
+  } // namespace nnn
+} // namespace ns3
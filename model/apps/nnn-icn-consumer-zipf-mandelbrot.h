@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-icn-consumer-zipf-mandelbrot.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-icn-consumer-zipf-mandelbrot.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-icn-consumer-zipf-mandelbrot.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_CONSUMER_ZIPF_MANDELBROT_H
+#define NNN_CONSUMER_ZIPF_MANDELBROT_H
+
+#include "nnn-icn-consumer-cbr.h"
+
+#include "../../utils/nnn-mapped-file.h"
+
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @ingroup nnn-apps
+     * @brief Nnn application requesting contents with Zipf-Mandelbrot popularity or from a request trace
+     *
+     * Interests are sent at the rate of ConsumerCbr. The sequence number of each new
+     * Interest is the rank k (1..NumberOfContents) of the requested content, drawn with
+     * probability proportional to 1 / (k + q)^s from a cumulative table built when the
+     * application starts.
+     *
+     * When TraceFile is set the sequence numbers are read from the file instead, one
+     * per line, in order. Empty lines and lines starting with # are skipped. The file
+     * is memory mapped and parsed as the Interests are sent.
+     *
+     * MaxSeq limits the number of Interests sent, not the sequence numbers.
+     */
+    class ConsumerZipfMandelbrot: public ConsumerCbr
+    {
+    public:
+      static TypeId GetTypeId ();
+
+      /**
+       * \brief Default constructor
+       */
+      ConsumerZipfMandelbrot ();
+      virtual ~ConsumerZipfMandelbrot ();
+
+    protected:
+      // from App
+      virtual void
+      StartApplication ();
+
+      virtual void
+      StopApplication ();
+
+      virtual uint32_t
+      NextSequenceNumber ();
+
+      /**
+       * @brief Fill the cumulative probability table of the catalog
+       */
+      void
+      BuildCdf ();
+
+      /**
+       * @brief Next sequence number of the request trace
+       * @returns std::numeric_limits<uint32_t>::max () at the end of a trace that is not looped
+       */
+      uint32_t
+      NextTraceSequenceNumber ();
+
+    protected:
+      uint32_t            m_numOfContents; ///< @brief Size of the catalog
+      double              m_q;             ///< @brief Plateau of the Zipf-Mandelbrot distribution
+      double              m_s;             ///< @brief Exponent of the Zipf-Mandelbrot distribution
+      std::vector<double> m_cdf;           ///< @brief m_cdf[k] is the probability of requesting rank k or lower
+
+      Ptr<UniformRandomVariable> m_seqRng; ///< @brief Random variable used to sample the catalog
+
+      std::string         m_traceFile;     ///< @brief Request trace to replay instead of the catalog
+      bool                m_traceLoop;     ///< @brief Start the trace again once it is over
+      MappedFile          m_trace;
+      size_t              m_tracePos;      ///< @brief Offset of the next line in the trace
+    };
+  } // namespace nnn
+} // namespace ns3
+
+#endif
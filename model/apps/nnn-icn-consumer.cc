@@ -48,6 +48,8 @@ namespace ns3
   {
     NS_OBJECT_ENSURE_REGISTERED (Consumer);
 
+    static const uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max ();
+
     TypeId
     Consumer::GetTypeId (void)
     {
@@ -71,6 +73,12 @@ namespace ns3
 			 StringValue ("50ms"),
 			 MakeTimeAccessor (&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
 			 MakeTimeChecker ())
+	  .AddAttribute ("RetxRingSize",
+			 "Number of outstanding sequence numbers kept in a ring buffer with a single timer for the earliest "
+			 "retransmission deadline. 0 checks the timeouts every RetxTimer",
+			 UintegerValue (0),
+			 MakeUintegerAccessor (&Consumer::m_retxRingSize),
+			 MakeUintegerChecker<uint32_t> ())
 	  .AddTraceSource ("LastRetransmittedInterestDataDelay", "Delay between last retransmitted Interest and received Data",
 			 MakeTraceSourceAccessor (&Consumer::m_lastRetransmittedInterestDataDelay),
 			 "ns3::nnn::ICNConsumer::LastRetransmittedInterestDataDelayTracedCallback")
@@ -85,6 +93,13 @@ namespace ns3
     : m_rand   (CreateObject<UniformRandomVariable> ())
     , m_seq    (0)
     , m_seqMax (0) // don't request anything
+    , m_pendingSeq (std::numeric_limits<uint32_t>::max ())
+    , m_retxRingSize (0)
+    , m_retxHead (NO_SLOT)
+    , m_retxTail (NO_SLOT)
+    , m_retxPending (0)
+    , m_retxQueueHead (NO_SLOT)
+    , m_retxQueueTail (NO_SLOT)
     {
       NS_LOG_FUNCTION_NOARGS ();
 
@@ -118,6 +133,9 @@ namespace ns3
     void
     Consumer::CheckRetxTimeout ()
     {
+      if (m_retxRingSize > 0)
+	return; // The ring buffer schedules its own timer
+
       Time now = Simulator::Now ();
 
       Time rto = m_rtt->RetransmitTimeout ();
@@ -141,6 +159,167 @@ namespace ns3
 					 &Consumer::CheckRetxTimeout, this);
     }
 
+    uint32_t
+    Consumer::NextSequenceNumber ()
+    {
+      return m_seq;
+    }
+
+    void
+    Consumer::CheckRetxRing ()
+    {
+      Time now = Simulator::Now ();
+      Time rto = m_rtt->RetransmitTimeout ();
+
+      while (m_retxHead != NO_SLOT)
+	{
+	  RetxRecord &entry = m_retxRing[m_retxHead];
+	  if (entry.lastSent + rto > now)
+	    break; // All later slots were sent after this one
+
+	  uint32_t seqNo = entry.seq;
+	  UnlinkRetxSlot (m_retxHead);
+	  OnTimeout (seqNo);
+	}
+
+      ArmRetxRing ();
+    }
+
+    void
+    Consumer::ArmRetxRing ()
+    {
+      if (m_retxHead == NO_SLOT)
+	return;
+
+      Time deadline = m_retxRing[m_retxHead].lastSent + m_rtt->RetransmitTimeout ();
+
+      // A timer firing before the deadline only re-arms itself, so it is kept
+      if (m_retxRingEvent.IsRunning () && m_retxRingDeadline <= deadline)
+	return;
+
+      Simulator::Cancel (m_retxRingEvent);
+
+      Time now = Simulator::Now ();
+      m_retxRingDeadline = deadline;
+      m_retxRingEvent = Simulator::Schedule ((deadline > now) ? deadline - now : Seconds (0),
+					     &Consumer::CheckRetxRing, this);
+    }
+
+    void
+    Consumer::UnlinkRetxSlot (uint32_t slot)
+    {
+      RetxRecord &entry = m_retxRing[slot];
+
+      if (entry.prev != NO_SLOT)
+	m_retxRing[entry.prev].next = entry.next;
+      else
+	m_retxHead = entry.next;
+
+      if (entry.next != NO_SLOT)
+	m_retxRing[entry.next].prev = entry.prev;
+      else
+	m_retxTail = entry.prev;
+
+      entry.pending = false;
+      m_retxPending--;
+    }
+
+    void
+    Consumer::QueueRetxSlot (uint32_t slot)
+    {
+      RetxRecord &entry = m_retxRing[slot];
+      if (entry.queued)
+	return;
+
+      entry.queued = true;
+      entry.prev = m_retxQueueTail;
+      entry.next = NO_SLOT;
+      if (m_retxQueueTail != NO_SLOT)
+	m_retxRing[m_retxQueueTail].next = slot;
+      else
+	m_retxQueueHead = slot;
+      m_retxQueueTail = slot;
+    }
+
+    void
+    Consumer::UnqueueRetxSlot (uint32_t slot)
+    {
+      RetxRecord &entry = m_retxRing[slot];
+
+      if (entry.prev != NO_SLOT)
+	m_retxRing[entry.prev].next = entry.next;
+      else
+	m_retxQueueHead = entry.next;
+
+      if (entry.next != NO_SLOT)
+	m_retxRing[entry.next].prev = entry.prev;
+      else
+	m_retxQueueTail = entry.prev;
+
+      entry.queued = false;
+    }
+
+    bool
+    Consumer::HasQueuedRetx () const
+    {
+      if (m_retxRingSize > 0)
+	return m_retxQueueHead != NO_SLOT;
+
+      return !m_retxSeqs.empty ();
+    }
+
+    bool
+    Consumer::IsRetxSlotFree (uint32_t sequenceNumber) const
+    {
+      if (m_retxRingSize == 0)
+	return true;
+
+      const RetxRecord &entry = m_retxRing[sequenceNumber % m_retxRingSize];
+      return !entry.used || entry.seq == sequenceNumber;
+    }
+
+    uint32_t
+    Consumer::GetOutstanding () const
+    {
+      if (m_retxRingSize > 0)
+	return m_retxPending;
+
+      return m_seqTimeouts.size ();
+    }
+
+    bool
+    Consumer::IsUnsatisfied (uint32_t sequenceNumber) const
+    {
+      if (m_retxRingSize > 0)
+	{
+	  const RetxRecord &entry = m_retxRing[sequenceNumber % m_retxRingSize];
+	  return entry.used && entry.seq == sequenceNumber;
+	}
+
+      return m_seqFullDelay.find (sequenceNumber) != m_seqFullDelay.end ();
+    }
+
+    bool
+    Consumer::GetLastSendTime (uint32_t sequenceNumber, Time &time) const
+    {
+      if (m_retxRingSize > 0)
+	{
+	  const RetxRecord &entry = m_retxRing[sequenceNumber % m_retxRingSize];
+	  if (!entry.used || entry.seq != sequenceNumber)
+	    return false;
+
+	  time = entry.lastSent;
+	  return true;
+	}
+
+      SeqTimeoutsContainer::const_iterator entry = m_seqLastDelay.find (sequenceNumber);
+      if (entry == m_seqLastDelay.end ())
+	return false;
+
+      time = entry->time;
+      return true;
+    }
+
     // Application Methods
     void
     Consumer::StartApplication () // Called at time specified by Start
@@ -150,6 +329,16 @@ namespace ns3
       // do base stuff
       ICNApp::StartApplication ();
 
+      if (m_retxRingSize > 0)
+	{
+	  m_retxRing.assign (m_retxRingSize, RetxRecord ());
+	  m_retxHead = NO_SLOT;
+	  m_retxTail = NO_SLOT;
+	  m_retxPending = 0;
+	  m_retxQueueHead = NO_SLOT;
+	  m_retxQueueTail = NO_SLOT;
+	}
+
       ScheduleNextPacket ();
     }
 
@@ -160,6 +349,7 @@ namespace ns3
 
       // cancel periodic packet generation
       Simulator::Cancel (m_sendEvent);
+      Simulator::Cancel (m_retxRingEvent);
 
       // cleanup base stuff
       ICNApp::StopApplication ();
@@ -175,13 +365,23 @@ namespace ns3
       uint32_t seq=std::numeric_limits<uint32_t>::max (); //invalid
       bool retransmission = false;
 
-      while (m_retxSeqs.size ())
+      if (m_retxRingSize > 0)
 	{
-	  seq = *m_retxSeqs.begin ();
-	  m_retxSeqs.erase (m_retxSeqs.begin ());
-	  retransmission = true;
-	  break;
+	  if (m_retxQueueHead != NO_SLOT)
+	    {
+	      seq = m_retxRing[m_retxQueueHead].seq;
+	      UnqueueRetxSlot (m_retxQueueHead);
+	      retransmission = true;
+	    }
 	}
+      else
+	while (m_retxSeqs.size ())
+	  {
+	    seq = *m_retxSeqs.begin ();
+	    m_retxSeqs.erase (m_retxSeqs.begin ());
+	    retransmission = true;
+	    break;
+	  }
 
       if (seq == std::numeric_limits<uint32_t>::max ())
 	{
@@ -193,7 +393,27 @@ namespace ns3
 		}
 	    }
 
-	  seq = m_seq++;
+	  // A number drawn earlier goes first, so none is skipped
+	  if (m_pendingSeq != std::numeric_limits<uint32_t>::max ())
+	    seq = m_pendingSeq;
+	  else
+	    seq = NextSequenceNumber ();
+
+	  if (seq == std::numeric_limits<uint32_t>::max ())
+	    {
+	      return; // nothing left to request
+	    }
+
+	  if (!IsRetxSlotFree (seq))
+	    {
+	      NS_LOG_DEBUG ("Seq " << std::dec << seq << " waits for its slot in the ring buffer");
+	      m_pendingSeq = seq;
+	      ScheduleNextPacket ();
+	      return;
+	    }
+
+	  m_pendingSeq = std::numeric_limits<uint32_t>::max ();
+	  m_seq++;
 	}
 
       if (retransmission)
@@ -370,6 +590,41 @@ namespace ns3
 	  hopCount = hopCountTag.Get ();
 	}
 
+      if (m_retxRingSize > 0)
+	{
+	  uint32_t slot = seq % m_retxRingSize;
+	  RetxRecord &record = m_retxRing[slot];
+	  if (record.used && record.seq == seq)
+	    {
+	      m_lastRetransmittedInterestDataDelay (this, seq, Simulator::Now () - record.lastSent, hopCount);
+
+	      Time delay = Simulator::Now () - record.firstSent;
+	      NS_LOG_INFO ("< DATA for " << seq << " delay: " << delay.GetSeconds());
+	      m_firstInterestDataDelay (this, seq, delay, record.retxCount, hopCount);
+
+	      // The slot holds the send time, so the sample goes to the estimator
+	      // without its history of sequence numbers. Like AckSeq, Data for an
+	      // Interest sent more than once, or already timed out, is no sample
+	      if (record.retxCount == 1 && !record.queued)
+		{
+		  m_rtt->Measurement (delay);
+		  m_rtt->ResetMultiplier ();
+		}
+
+	      if (record.pending)
+		UnlinkRetxSlot (slot);
+	      if (record.queued)
+		UnqueueRetxSlot (slot);
+	      record.used = false;
+	      // A later request for seq, as Zipf draws do, starts a new count
+	      record.retxCount = 0;
+	    }
+
+	  // The new RTT sample can shrink the RTO and so move the deadline of the head earlier
+	  ArmRetxRing ();
+	  return;
+	}
+
       SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find (seq);
       if (entry != m_seqLastDelay.end ())
 	{
@@ -502,11 +757,23 @@ namespace ns3
       // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << "NACK for " << seq << "\n";
 
       // put in the queue of interests to be retransmitted
-      // NS_LOG_INFO ("Before: " << m_retxSeqs.size ());
-      m_retxSeqs.insert (seq);
-      // NS_LOG_INFO ("After: " << m_retxSeqs.size ());
-
-      m_seqTimeouts.erase (seq);
+      if (m_retxRingSize > 0)
+	{
+	  uint32_t slot = seq % m_retxRingSize;
+	  if (m_retxRing[slot].used && m_retxRing[slot].seq == seq)
+	    {
+	      if (m_retxRing[slot].pending)
+		UnlinkRetxSlot (slot);
+	      QueueRetxSlot (slot);
+	    }
+	}
+      else
+	{
+	  // NS_LOG_INFO ("Before: " << m_retxSeqs.size ());
+	  m_retxSeqs.insert (seq);
+	  // NS_LOG_INFO ("After: " << m_retxSeqs.size ());
+	  m_seqTimeouts.erase (seq);
+	}
 
       m_rtt->IncreaseMultiplier ();             // Double the next RTO ??
       ScheduleNextPacket ();
@@ -519,14 +786,67 @@ namespace ns3
       // std::cout << Simulator::Now () << ", TO: " << sequenceNumber << ", current RTO: " << m_rtt->RetransmitTimeout ().ToDouble (Time::S) << "s\n";
 
       m_rtt->IncreaseMultiplier ();             // Double the next RTO
-      m_rtt->SentSeq (SequenceNumber32 (sequenceNumber), 1); // make sure to disable RTT calculation for this sample
-      m_retxSeqs.insert (sequenceNumber);
+
+      if (m_retxRingSize > 0)
+	{
+	  // CheckRetxRing took the slot off the timer list, being queued
+	  // keeps its Data from giving an RTT sample
+	  uint32_t slot = sequenceNumber % m_retxRingSize;
+	  if (m_retxRing[slot].used && m_retxRing[slot].seq == sequenceNumber)
+	    QueueRetxSlot (slot);
+	}
+      else
+	{
+	  m_rtt->SentSeq (SequenceNumber32 (sequenceNumber), 1); // make sure to disable RTT calculation for this sample
+	  m_retxSeqs.insert (sequenceNumber);
+	}
       ScheduleNextPacket ();
     }
 
     void
     Consumer::WillSendOutInterest (uint32_t sequenceNumber)
     {
+      if (m_retxRingSize > 0)
+	{
+	  uint32_t slot = sequenceNumber % m_retxRingSize;
+	  RetxRecord &record = m_retxRing[slot];
+	  Time now = Simulator::Now ();
+
+	  NS_ASSERT_MSG (IsRetxSlotFree (sequenceNumber), "Slot of seq " << sequenceNumber << " is in use");
+
+	  if (!record.used)
+	    {
+	      record.seq = sequenceNumber;
+	      record.used = true;
+	      record.firstSent = now;
+	      record.retxCount = 0;
+	    }
+	  else
+	    {
+	      if (record.pending)
+		UnlinkRetxSlot (slot);
+	      if (record.queued)
+		UnqueueRetxSlot (slot);
+	    }
+
+	  record.lastSent = now;
+	  record.retxCount++;
+
+	  // Sent last, so it has the latest deadline
+	  record.pending = true;
+	  record.prev = m_retxTail;
+	  record.next = NO_SLOT;
+	  if (m_retxTail != NO_SLOT)
+	    m_retxRing[m_retxTail].next = slot;
+	  else
+	    m_retxHead = slot;
+	  m_retxTail = slot;
+	  m_retxPending++;
+
+	  ArmRetxRing ();
+	  return;
+	}
+
       NS_LOG_DEBUG ("Trying to add " << std::dec << sequenceNumber << " with " << Simulator::Now () << ". already " << m_seqTimeouts.size () << " items");
 
       m_seqTimeouts.insert (SeqTimeout (sequenceNumber, Simulator::Now ()));
@@ -28,6 +28,7 @@
 
 #include <set>
 #include <map>
+#include <vector>
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/tag.hpp>
@@ -119,6 +120,17 @@ namespace ns3
       virtual void
       ScheduleNextPacket () = 0;
 
+      /**
+       * \brief Sequence number of the next Interest that is not a retransmission
+       *
+       * Called before each new Interest is sent, m_seq counts the new Interests already sent.
+       * The default requests consecutive sequence numbers.
+       *
+       * \return std::numeric_limits<uint32_t>::max () when there is nothing left to request
+       */
+      virtual uint32_t
+      NextSequenceNumber ();
+
       /**
        * \brief Checks if the packet need to be retransmitted becuase of retransmission timer expiration
        */
@@ -139,6 +151,71 @@ namespace ns3
       Time
       GetRetxTimer () const;
 
+      /**
+       * \brief Fires at the earliest retransmission deadline of the ring buffer of outstanding sequence numbers
+       */
+      void
+      CheckRetxRing ();
+
+      /**
+       * \brief Schedules the ring buffer timer for the earliest retransmission deadline
+       *
+       * Must be called whenever that deadline can move earlier: a new head
+       * of the timer list or a shorter RTO after an RTT sample. A later
+       * deadline keeps the timer, which re-arms itself when it fires early
+       */
+      void
+      ArmRetxRing ();
+
+      /**
+       * \brief Removes a slot of the ring buffer from the timer list
+       */
+      void
+      UnlinkRetxSlot (uint32_t slot);
+
+      /**
+       * \brief Appends a slot of the ring buffer to the retransmission queue
+       */
+      void
+      QueueRetxSlot (uint32_t slot);
+
+      /**
+       * \brief Removes a slot of the ring buffer from the retransmission queue
+       */
+      void
+      UnqueueRetxSlot (uint32_t slot);
+
+      /**
+       * \brief Whether sequence numbers are waiting to be sent again
+       */
+      bool
+      HasQueuedRetx () const;
+
+      /**
+       * \brief Whether the ring buffer has room to send the sequence number for the first time
+       */
+      bool
+      IsRetxSlotFree (uint32_t sequenceNumber) const;
+
+      /**
+       * \brief Number of Interests sent and not yet satisfied, NACKed or timed out
+       */
+      uint32_t
+      GetOutstanding () const;
+
+      /**
+       * \brief Whether Data for the sequence number is still expected
+       */
+      bool
+      IsUnsatisfied (uint32_t sequenceNumber) const;
+
+      /**
+       * \brief Time the Interest for the sequence number was last sent
+       * \return false if the sequence number is not being requested
+       */
+      bool
+      GetLastSendTime (uint32_t sequenceNumber, Time &time) const;
+
       typedef void (* LastRetransmittedInterestDataDelayTracedCallback)
 	  (const Ptr<App>, const uint32_t, const Time, const int32_t);
 
@@ -150,6 +227,7 @@ namespace ns3
 
       uint32_t        m_seq;  ///< @brief currently requested sequence number
       uint32_t        m_seqMax;    ///< @brief maximum number of sequence number
+      uint32_t        m_pendingSeq; ///< @brief new sequence number drawn while its ring buffer slot was busy, max if none
       EventId         m_sendEvent; ///< @brief EventId of pending "send packet" event
       Time            m_retxTimer; ///< @brief Currently estimated retransmission timer
       EventId         m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
@@ -209,6 +287,34 @@ namespace ns3
       SeqTimeoutsContainer m_seqFullDelay;
       std::map<uint32_t, uint32_t> m_seqRetxCounts;
 
+      /**
+       * \struct Outstanding sequence number kept in the ring buffer, slot seq % RetxRingSize
+       */
+      struct RetxRecord
+      {
+	RetxRecord () : seq (0), used (false), pending (false), queued (false), retxCount (0), prev (0), next (0) { }
+
+	uint32_t seq;
+	bool used;           ///< \brief Data for seq is still expected
+	bool pending;        ///< \brief Sent and waiting for Data, linked in the timer list
+	bool queued;         ///< \brief Timed out or NACKed, linked in the retransmission queue
+	Time firstSent;
+	Time lastSent;
+	uint32_t retxCount;  ///< \brief Times seq was sent, only a single send gives an RTT sample
+	uint32_t prev;       ///< \brief Timer list ordered by lastSent, or retransmission queue
+	uint32_t next;
+      };
+
+      uint32_t                m_retxRingSize;  ///< \brief Ring buffer size, 0 uses the multi-index containers
+      std::vector<RetxRecord> m_retxRing;      ///< \brief Ring buffer of outstanding sequence numbers
+      uint32_t                m_retxHead;      ///< \brief Slot with the earliest retransmission deadline
+      uint32_t                m_retxTail;      ///< \brief Slot sent last
+      uint32_t                m_retxPending;   ///< \brief Number of slots in the timer list
+      uint32_t                m_retxQueueHead; ///< \brief Slot to be sent again first
+      uint32_t                m_retxQueueTail;
+      EventId                 m_retxRingEvent; ///< \brief Timer for the earliest retransmission deadline
+      Time                    m_retxRingDeadline;
+
       TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */,
       Time /* delay */, int32_t /*hop count*/> m_lastRetransmittedInterestDataDelay;
       TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */,
@@ -20,6 +20,7 @@
  *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
  */
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -77,11 +78,16 @@ namespace ns3
 		       icn::NameValue (),
 		       MakeNameAccessor (&Producer::m_keyLocator),
 		       icn::MakeNameChecker ())
+	.AddAttribute ("DataTemplate", "Encode Data from a template built when the application starts and reuse the 3N PDUs",
+		       BooleanValue (false),
+		       MakeBooleanAccessor (&Producer::m_useTemplate),
+		       MakeBooleanChecker ())
 	;
       return tid;
     }
 
     Producer::Producer ()
+    : m_useTemplate (false)
     {
       // NS_LOG_FUNCTION_NOARGS ();
     }
@@ -103,6 +109,21 @@ namespace ns3
 
       fibEntry->UpdateStatus (m_face, fib::FaceMetric::NDN_FIB_GREEN);
 
+      if (m_useTemplate)
+	{
+	  Ptr<Data> prototype = Create<Data> (Create<Packet> (m_virtualPayloadSize));
+	  prototype->SetName (m_prefix);
+	  prototype->SetFreshness (m_freshness);
+	  prototype->SetSignature (m_signature);
+	  if (m_keyLocator.size () > 0)
+	    {
+	      prototype->SetKeyLocator (Create<icn::Name> (m_keyLocator));
+	    }
+
+	  m_dataTemplate = Create<icn::wire::icnSIM::DataTemplate> (prototype);
+	  m_traceData = prototype;
+	}
+
       // // make face green, so it will be used primarily
       // StaticCast<fib::FibImpl> (fib)->modify (fibEntry,
       //                                        ll::bind (&fib::Entry::UpdateStatus,
@@ -160,6 +181,34 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this << interest);
 
+      if (m_dataTemplate != 0)
+	{
+	  Ptr<icn::Name> dataName = Create<icn::Name> (interest->GetName ());
+	  dataName->append (m_postfix);
+
+	  Ptr<Packet> wire = m_dataTemplate->ToWire (*dataName, Simulator::Now ());
+
+	  NS_LOG_INFO ("Responding with Data: " << *dataName << " seq: " << std::dec << dataName->get (-1).toSeqNum ());
+
+	  // Echo back FwHopCountTag if exists
+	  FwHopCountTag hopCountTag;
+	  if (interest->GetPayload ()->PeekPacketTag (hopCountTag))
+	    {
+	      wire->AddPacketTag (hopCountTag);
+	    }
+
+	  // The traced Data is reused unless a trace sink kept it
+	  if (m_traceData->GetReferenceCount () > 1)
+	    {
+	      m_traceData = Create<Data> (*m_traceData);
+	    }
+	  m_traceData->SetName (dataName);
+	  m_traceData->SetTimestamp (Simulator::Now ());
+
+	  m_transmittedDatas (m_traceData, this, m_face);
+	  return wire;
+	}
+
       Ptr<Data> data = Create<Data> (Create<Packet> (m_virtualPayloadSize));
       Ptr<icn::Name> dataName = Create<icn::Name> (interest->GetName ());
       dataName->append (m_postfix);
@@ -225,7 +274,7 @@ namespace ns3
 		    {
 		      NS_LOG_INFO ("Responding NULLp with SO from (" << *m_current3Nname << ")");
 		      // We don't have all the information for a DU, so send a SO
-		      Ptr<SO> so_o = Create<SO> ();
+		      Ptr<SO> so_o = GetResponsePDU (m_so);
 		      so_o->SetPDUPayloadType (pdutype);
 		      so_o->SetLifetime (m_3n_lifetime);
 		      so_o->SetName (*m_current3Nname);
@@ -237,7 +286,7 @@ namespace ns3
 		  else
 		    {
 		      NS_LOG_INFO ("Responding NULLp with NULLp");
-		      Ptr<NULLp> nullp_o = Create<NULLp> ();
+		      Ptr<NULLp> nullp_o = GetResponsePDU (m_nullp);
 		      nullp_o->SetPDUPayloadType (pdutype);
 		      nullp_o->SetLifetime (m_3n_lifetime);
 		      nullp_o->SetPayload (retPkt);
@@ -295,7 +344,7 @@ namespace ns3
 		    {
 		      NS_LOG_INFO ("Responding SO with DU from (" << *m_current3Nname << ") to (" << soObject->GetName () << ")");
 		      // We can use DU packets now
-		      Ptr<DU> du_o = Create<DU> ();
+		      Ptr<DU> du_o = GetResponsePDU (m_du);
 		      du_o->SetPDUPayloadType(pdutype);
 		      du_o->SetSrcName(*m_current3Nname);
 		      du_o->SetDstName(soObject->GetName ());
@@ -308,7 +357,7 @@ namespace ns3
 		  else
 		    {
 		      NS_LOG_INFO ("Responding SO with DO to (" << soObject->GetName () << ")");
-		      Ptr<DO> do_o = Create<DO> ();
+		      Ptr<DO> do_o = GetResponsePDU (m_do);
 
 		      do_o->SetName (soObject->GetName ());
 		      do_o->SetPDUPayloadType (pdutype);
@@ -359,7 +408,7 @@ namespace ns3
 		  if (m_isMobile && m_has3Nname)
 		    {
 		      NS_LOG_INFO ("Responding DO with SO from (" << *m_current3Nname << ")");
-		      Ptr<SO> so_o = Create<SO> ();
+		      Ptr<SO> so_o = GetResponsePDU (m_so);
 		      so_o->SetLifetime (m_3n_lifetime);
 		      so_o->SetPDUPayloadType (pdutype);
 		      so_o->SetName (*m_current3Nname);
@@ -370,7 +419,7 @@ namespace ns3
 		  else
 		    {
 		      NS_LOG_INFO ("Responding DO with NULLp");
-		      Ptr<NULLp> nullp_o = Create<NULLp> ();
+		      Ptr<NULLp> nullp_o = GetResponsePDU (m_nullp);
 		      nullp_o->SetLifetime (m_3n_lifetime);
 		      nullp_o->SetPDUPayloadType (pdutype);
 		      nullp_o->SetPayload (retPkt);
@@ -423,7 +472,7 @@ namespace ns3
 		  Ptr<Packet> retPkt = CreateReturnData(interest);
 
 		  NS_LOG_INFO ("Responding DU with DU");
-		  Ptr<DU> du_o = Create<DU> ();
+		  Ptr<DU> du_o = GetResponsePDU (m_du);
 		  du_o->SetLifetime (m_3n_lifetime);
 		  if (m_has3Nname)
 		    du_o->SetSrcName(*m_current3Nname);
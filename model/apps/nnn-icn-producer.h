@@ -26,6 +26,7 @@
 #include "ns3/ptr.h"
 
 #include "nnn-icn-app.h"
+#include "../wire/nnnsim/icn/data/nnnsim-icn-data.h"
 
 namespace ns3
 {
@@ -72,6 +73,16 @@ namespace ns3
       virtual void
       StopApplication ();     // Called at time specified by Stop
 
+      /**
+       * @brief PDU to respond with
+       *
+       * With DataTemplate set the PDU of the previous response is reused once
+       * nobody else holds a reference to it, otherwise a new PDU is created.
+       */
+      template<class T>
+      Ptr<T>
+      GetResponsePDU (Ptr<T> &previous);
+
     private:
       icn::Name m_prefix;
       icn::Name m_postfix;
@@ -80,8 +91,30 @@ namespace ns3
 
       uint32_t m_signature;
       icn::Name m_keyLocator;
+
+      bool m_useTemplate;                                   ///< @brief Encode Data from a pre-encoded template
+      Ptr<icn::wire::icnSIM::DataTemplate> m_dataTemplate;  ///< @brief Built when the application starts
+      Ptr<Data> m_traceData;                                ///< @brief Data given to TransmittedDatas in template mode
+
+      Ptr<NULLp> m_nullp;
+      Ptr<SO> m_so;
+      Ptr<DO> m_do;
+      Ptr<DU> m_du;
     };
 
+    template<class T>
+    Ptr<T>
+    Producer::GetResponsePDU (Ptr<T> &previous)
+    {
+      if (!m_useTemplate)
+	return Create<T> ();
+
+      if (previous == 0 || previous->GetReferenceCount () > 1)
+	previous = Create<T> ();
+
+      return previous;
+    }
+
   } // namespace nnn
 } // namespace ns3
 
@@ -45,7 +45,7 @@ namespace ns3
     void
     PDUQueue::clear ()
     {
-      std::queue<std::pair<Time, Ptr<Packet> > > empty;
+      std::queue<Item> empty;
 
       std::swap(buffer, empty);
     }
@@ -53,39 +53,69 @@ namespace ns3
     Ptr<Packet>
     PDUQueue::pop ()
     {
-      Ptr<Packet> tmp = buffer.front ().second;
+      Ptr<Packet> tmp = buffer.front ().m_pdu;
+      buffer.pop();
+      return tmp;
+    }
+
+    Ptr<Packet>
+    PDUQueue::pop (Time &arrival, Time &expiry)
+    {
+      Item &item = buffer.front ();
+      Ptr<Packet> tmp = item.m_pdu;
+      arrival = item.m_arrival;
+      expiry = item.m_expiry;
       buffer.pop();
       return tmp;
     }
 
+    void
+    PDUQueue::pushItem (Ptr<Packet> pdu, Time retx)
+    {
+      Item item;
+      item.m_arrival = Simulator::Now ();
+      item.m_expiry = item.m_arrival + retx;
+      item.m_pdu = pdu;
+      buffer.push (item);
+    }
+
     void
     PDUQueue::push (Ptr<Packet> pdu, Time retx)
     {
-      buffer.push (std::make_pair((Simulator::Now () + retx), pdu));
+      pushItem (pdu, retx);
     }
 
     void
     PDUQueue::pushSO (Ptr<const SO> so_p, Time retx)
     {
-      buffer.push(std::make_pair((Simulator::Now () + retx), Wire::FromSO(so_p, Wire::WIRE_FORMAT_NNNSIM)));
+      pushItem (Wire::FromSO(so_p, Wire::WIRE_FORMAT_NNNSIM), retx);
     }
 
     void
     PDUQueue::pushDO (Ptr<const DO> do_p, Time retx)
     {
-      buffer.push(std::make_pair((Simulator::Now () + retx), Wire::FromDO(do_p, Wire::WIRE_FORMAT_NNNSIM)));
+      pushItem (Wire::FromDO(do_p, Wire::WIRE_FORMAT_NNNSIM), retx);
     }
 
     void
     PDUQueue::pushDU (Ptr<const DU> du_p, Time retx)
     {
-      buffer.push(std::make_pair((Simulator::Now () + retx), Wire::FromDU(du_p, Wire::WIRE_FORMAT_NNNSIM)));
+      pushItem (Wire::FromDU(du_p, Wire::WIRE_FORMAT_NNNSIM), retx);
     }
 
     std::queue<std::pair<Time, Ptr<Packet> > >
     PDUQueue::popQueue ()
     {
-      return buffer;
+      std::queue<std::pair<Time, Ptr<Packet> > > ret;
+      std::queue<Item> tmp = buffer;
+
+      while (!tmp.empty ())
+	{
+	  ret.push (std::make_pair (tmp.front ().m_expiry, tmp.front ().m_pdu));
+	  tmp.pop ();
+	}
+
+      return ret;
     }
 
     uint
@@ -48,6 +48,15 @@ namespace ns3
       Ptr<Packet>
       pop ();
 
+      /**
+       * @brief Remove the PDU at the front of the queue
+       *
+       * @param arrival set to the time the PDU was buffered
+       * @param expiry set to the time the PDU stops being worth forwarding
+       */
+      Ptr<Packet>
+      pop (Time &arrival, Time &expiry);
+
       void
       push (Ptr<Packet> pdu, Time retx);
 
@@ -67,7 +76,17 @@ namespace ns3
       size ();
 
     private:
-      std::queue<std::pair<Time,Ptr<Packet> > > buffer;
+      struct Item
+      {
+	Time m_arrival;
+	Time m_expiry;
+	Ptr<Packet> m_pdu;
+      };
+
+      void
+      pushItem (Ptr<Packet> pdu, Time retx);
+
+      std::queue<Item> buffer;
     };
   } /* namespace nnn */
 } /* namespace ns3 */
@@ -25,6 +25,8 @@
 
 #include "nnn-pdu-buffer.h"
 
+#include "../../utils/nnn-fast-path.h"
+
 namespace ns3
 {
   NS_LOG_COMPONENT_DEFINE ("nnn.PDUBuffer");
@@ -70,6 +72,8 @@ namespace ns3
 	    {
 	      NS_LOG_INFO("New buffer for : " << addr);
 
+	      m_stats.m_inserts++;
+
 	      result.first->set_payload(Create<PDUQueue> ());
 	    }
 	}
@@ -93,6 +97,7 @@ namespace ns3
       if (item != super::end ())
 	{
 	  super::erase(item);
+	  m_stats.m_erases++;
 	}
     }
 
@@ -107,6 +112,7 @@ namespace ns3
     {
       NS_LOG_FUNCTION(this << addr);
       super::iterator item = super::find_exact(addr);
+      m_stats.Lookup (item != super::end (), addr.size ());
 
       return (item != super::end());
     }
@@ -125,6 +131,7 @@ namespace ns3
       NS_LOG_INFO ("PushPDU SO Looking for " << addr);
 
       super::iterator item = super::find_exact(addr);
+      m_stats.Lookup (item != super::end (), addr.size ());
 
       if (item != super::end ())
 	{
@@ -149,6 +156,7 @@ namespace ns3
       NS_LOG_INFO ("PushPDU DO Looking for " << addr);
 
       super::iterator item = super::find_exact(addr);
+      m_stats.Lookup (item != super::end (), addr.size ());
 
       if (item != super::end ())
 	{
@@ -173,6 +181,7 @@ namespace ns3
       NS_LOG_INFO ("PushPDU DU Looking for " << addr);
 
       super::iterator item = super::find_exact(addr);
+      m_stats.Lookup (item != super::end (), addr.size ());
 
       if (item != super::end ())
 	{
@@ -197,6 +206,7 @@ namespace ns3
       NS_LOG_INFO ("Looking for (" << addr << ")");
 
       super::iterator item = super::find_exact(addr);
+      m_stats.Lookup (item != super::end (), addr.size ());
 
       std::queue<Ptr<Packet> > pdu_queue;
       uint32_t pushed = 0;
@@ -256,6 +266,40 @@ namespace ns3
       return PopQueue (*addr);
     }
 
+    Ptr<Packet>
+    PDUBuffer::PopPDU (const NNNAddress &addr, Time &arrival)
+    {
+      NS_LOG_FUNCTION(this << addr);
+
+      super::iterator item = super::find_exact(addr);
+      m_stats.Lookup (item != super::end (), addr.size ());
+
+      if (item == super::end () || item->payload() == 0)
+	return 0;
+
+      Ptr<PDUQueue> queue = item->payload();
+      Time now = Simulator::Now ();
+      Time expiry;
+
+      while (!queue->isEmpty ())
+	{
+	  Ptr<Packet> pdu = queue->pop (arrival, expiry);
+
+	  if (now <= expiry)
+	    return pdu;
+
+	  NS_LOG_DEBUG ("Now is " << now << " PDU has expiry of " << expiry << " discarding PDU");
+	}
+
+      return 0;
+    }
+
+    Ptr<Packet>
+    PDUBuffer::PopPDU (Ptr<NNNAddress> addr, Time &arrival)
+    {
+      return PopPDU (*addr, arrival);
+    }
+
     uint
     PDUBuffer::QueueSize (const NNNAddress &addr)
     {
@@ -264,6 +308,7 @@ namespace ns3
       NS_LOG_INFO ("Looking for " << addr);
 
       super::iterator item = super::find_exact(addr);
+      m_stats.Lookup (item != super::end (), addr.size ());
 
       if (item == super::end ())
 	return 0;
@@ -300,5 +345,15 @@ namespace ns3
     {
       return m_retx;
     }
+
+    TableStats
+    PDUBuffer::GetStats () const
+    {
+      TableStats stats = m_stats;
+      stats.m_entries = super::getPolicy ().size ();
+      stats.m_nodes = super::getTrie ().node_count ();
+      stats.m_bytes = stats.m_entries * sizeof (PDUQueue) + stats.m_nodes * sizeof (super::parent_trie);
+      return stats;
+    }
   } /* namespace nnn */
 } /* namespace ns3 */
@@ -33,6 +33,7 @@
 #include "../../utils/trie/trie.h"
 #include "../../utils/trie/counting-policy.h"
 #include "../../utils/trie/trie-with-policy.h"
+#include "../../utils/nnn-table-stats.h"
 
 #include "nnn-pdu-buffer-queue.h"
 
@@ -105,6 +106,21 @@ namespace ns3
       std::queue<Ptr<Packet> >
       PopQueue (Ptr<NNNAddress> addr);
 
+      /**
+       * @brief Remove the oldest PDU buffered for a destination that has not hit the retransmission time
+       *
+       * PDUs that have hit the retransmission time on the way are discarded
+       *
+       * @param addr destination
+       * @param arrival set to the time the returned PDU was buffered
+       * @returns 0 once no PDU is left for the destination
+       */
+      Ptr<Packet>
+      PopPDU (const NNNAddress &addr, Time &arrival);
+
+      Ptr<Packet>
+      PopPDU (Ptr<NNNAddress> addr, Time &arrival);
+
       uint
       QueueSize (const NNNAddress &addr);
 
@@ -117,8 +133,15 @@ namespace ns3
       Time
       GetReTX () const;
 
+      /**
+       * @brief Usage counters of the buffer, read without walking it
+       */
+      TableStats
+      GetStats () const;
+
     private:
       Time m_retx;
+      TableStats m_stats;
     };
 
     std::ostream& operator<< (std::ostream& os, const PDUBuffer &buffer);
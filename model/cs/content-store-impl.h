@@ -123,6 +123,9 @@ namespace ns3
 	virtual Ptr<Entry>
 	Next (Ptr<Entry>);
 
+	virtual TableStats
+	GetStats () const;
+
 	const typename super::policy_container &
 	GetPolicy () const { return super::getPolicy (); }
 
@@ -214,6 +217,8 @@ namespace ns3
 							     isNotExcluded (*interest->GetExclude ()));
 	  }
 
+	this->m_stats.Lookup (node != this->end (), interest->GetName ().size ());
+
 	if (node != this->end ())
 	  {
 	    this->m_cacheHitsTrace (interest, node->payload ()->GetData ());
@@ -236,12 +241,16 @@ namespace ns3
 	NS_LOG_FUNCTION (this << data->GetName ());
 
 	Ptr< entry > newEntry = Create< entry > (this, data);
+	size_t before = this->getPolicy ().size ();
 	std::pair< typename super::iterator, bool > result = super::insert (data->GetName (), newEntry);
 
 	if (result.first != super::end ())
 	  {
 	    if (result.second)
 	      {
+		this->m_stats.m_inserts++;
+		// A full store evicts an entry to make room
+		this->m_stats.m_erases += before + 1 - this->getPolicy ().size ();
 		newEntry->SetTrie (result.first);
 
 		m_didAddEntry (newEntry);
@@ -291,6 +300,16 @@ namespace ns3
 	return this->getPolicy ().size ();
       }
 
+      template<class Policy>
+      TableStats
+      ContentStoreImpl<Policy>::GetStats () const
+      {
+	TableStats stats = ContentStore::GetStats ();
+	stats.m_nodes = super::getTrie ().node_count ();
+	stats.m_bytes = stats.m_entries * sizeof (entry) + stats.m_nodes * sizeof (typename super::parent_trie);
+	return stats;
+      }
+
       template<class Policy>
       Ptr<Entry>
       ContentStoreImpl<Policy>::Begin ()
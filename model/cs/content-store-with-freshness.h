@@ -158,6 +158,8 @@ namespace ns3
 	    if (freshness_policy_container::policy_base::get_freshness (&(*entry)) <= now) // is the record stale?
 	      {
 		super::erase (&(*entry));
+		this->m_stats.m_expired++;
+		this->m_stats.m_erases++;
 	      }
 	    else
 	      break; // nothing else to do. All later records will not be stale
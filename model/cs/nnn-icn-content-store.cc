@@ -61,6 +61,14 @@ namespace ns3
     {
     }
 
+    TableStats
+    ContentStore::GetStats () const
+    {
+      TableStats stats = m_stats;
+      stats.m_entries = GetSize ();
+      return stats;
+    }
+
     namespace cs {
 
       //////////////////////////////////////////////////////////////////////
@@ -29,6 +29,8 @@
 
 #include <boost/tuple/tuple.hpp>
 
+#include "../../utils/nnn-table-stats.h"
+
 namespace ns3 {
 
   class Packet;
@@ -187,6 +189,12 @@ namespace ns3 {
       virtual Ptr<cs::Entry>
       Next (Ptr<cs::Entry>) = 0;
 
+      /**
+       * @brief Usage counters of the content store, read without walking it
+       */
+      virtual TableStats
+      GetStats () const;
+
       ////////////////////////////////////////////////////////////////////////////
       ////////////////////////////////////////////////////////////////////////////
       ////////////////////////////////////////////////////////////////////////////
@@ -208,6 +216,8 @@ namespace ns3 {
       Ptr<const Data> > m_cacheHitsTrace; ///< @brief trace of cache hits
 
       TracedCallback<Ptr<const Interest> > m_cacheMissesTrace; ///< @brief trace of cache misses
+
+      TableStats m_stats; ///< @brief Usage counters, kept by the implementations
     };
 
     inline std::ostream&
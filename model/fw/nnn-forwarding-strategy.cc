@@ -44,6 +44,8 @@
 #include "../../helper/nnn-face-container.h"
 #include "../buffers/nnn-pdu-buffer.h"
 #include "../addr-aggr/nnn-addr-aggregator.h"
+#include "nnn-name-allocator.h"
+#include "nnn-nexthop-cache.h"
 #include "../../helper/nnn-header-helper.h"
 #include "../../helper/nnn-face-container.h"
 
@@ -54,6 +56,7 @@
 #include "../nnn-nnnsim-icn-wire.h"
 #include "../cs/nnn-icn-content-store.h"
 #include "../../helper/icn-header-helper.h"
+#include "../../utils/nnn-stage-profiler.h"
 
 #include <boost/ref.hpp>
 #include <boost/foreach.hpp>
@@ -72,6 +75,7 @@
 #include "ns3/string.h"
 #include "ns3/type-id.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
 #include "ns3/nstime.h"
 
 #include <sys/types.h>
@@ -86,6 +90,8 @@
 #include <utility>
 #include <vector>
 
+#include "../../utils/nnn-fast-path.h"
+
 namespace ll = boost::lambda;
 
 // Max label
@@ -330,6 +336,82 @@ namespace ns3
 	                 MakeTimeAccessor (&ForwardingStrategy::GetRetxTimer, &ForwardingStrategy::SetRetxTimer),
 	                 MakeTimeChecker ())
 
+	  .AddAttribute ("NextHopCacheSize", "Number of slots in the next hop cache for DO and DU destinations (0 disables the cache)",
+	                 UintegerValue (64),
+	                 MakeUintegerAccessor (&ForwardingStrategy::GetNextHopCacheSize, &ForwardingStrategy::SetNextHopCacheSize),
+	                 MakeUintegerChecker<uint32_t> ())
+
+	  .AddAttribute ("3NLabelWidth", "Number of bits of the label appended to the node's 3N name for produced 3N names (Only in use if Produce3Nnames is used)",
+	                 UintegerValue (32),
+	                 MakeUintegerAccessor (&ForwardingStrategy::m_3n_label_width),
+	                 MakeUintegerChecker<uint32_t> (1, 32))
+
+	  .AddAttribute ("EnrollmentBatchWindow", "ENs arriving within this time are answered together with 3N names from a reserved block (0 answers every EN when it arrives)",
+	                 StringValue ("0s"),
+	                 MakeTimeAccessor (&ForwardingStrategy::m_enroll_batch_window),
+	                 MakeTimeChecker ())
+
+	  .AddAttribute ("EnrollmentNameBlock", "Number of 3N names reserved at once for batched enrollments",
+	                 UintegerValue (16),
+	                 MakeUintegerAccessor (&ForwardingStrategy::m_enroll_name_block),
+	                 MakeUintegerChecker<uint32_t> (1))
+
+	  .AddAttribute ("MakeBeforeBreak", "On a new PoA, obtain the new 3N name before sending the DEN for the old one",
+	                 BooleanValue (false),
+	                 MakeBooleanAccessor (&ForwardingStrategy::m_make_before_break),
+	                 MakeBooleanChecker ())
+
+	  .AddAttribute ("MakeBeforeBreakHold", "Time the old attachment is kept after the new 3N name is acknowledged (Only in use if MakeBeforeBreak is used)",
+	                 StringValue ("50ms"),
+	                 MakeTimeAccessor (&ForwardingStrategy::m_mbb_hold),
+	                 MakeTimeChecker ())
+
+	  .AddAttribute ("MakeBeforeBreakRetries", "RENs sent for the new 3N name before falling back to break before make (Only in use if MakeBeforeBreak is used)",
+	                 UintegerValue (3),
+	                 MakeUintegerAccessor (&ForwardingStrategy::m_mbb_max_retries),
+	                 MakeUintegerChecker<uint32_t> (1))
+
+	  .AddAttribute ("StreamBufferedPDUs", "Once the new 3N name of a node is known, forward the PDUs buffered for it a few at a time instead of all at once",
+	                 BooleanValue (false),
+	                 MakeBooleanAccessor (&ForwardingStrategy::m_stream_buffer),
+	                 MakeBooleanChecker ())
+
+	  .AddAttribute ("StreamInterval", "Time between bursts of streamed buffered PDUs (Only in use if StreamBufferedPDUs is used)",
+	                 StringValue ("1ms"),
+	                 MakeTimeAccessor (&ForwardingStrategy::m_stream_interval),
+	                 MakeTimeChecker ())
+
+	  .AddAttribute ("StreamBurst", "Number of buffered PDUs forwarded in every burst (Only in use if StreamBufferedPDUs is used)",
+	                 UintegerValue (4),
+	                 MakeUintegerAccessor (&ForwardingStrategy::m_stream_burst),
+	                 MakeUintegerChecker<uint32_t> (1))
+
+	  .AddAttribute ("BufferHistogramBinWidth", "Width of the bins of the time in buffer histogram",
+	                 StringValue ("10ms"),
+	                 MakeTimeAccessor (&ForwardingStrategy::m_buffer_histogram_bin),
+	                 MakeTimeChecker ())
+
+	  .AddAttribute ("BufferHistogramBins", "Number of bins of the time in buffer histogram, the last one has no upper bound",
+	                 UintegerValue (20),
+	                 MakeUintegerAccessor (&ForwardingStrategy::SetBufferHistogramBins, &ForwardingStrategy::GetBufferHistogramBins),
+	                 MakeUintegerChecker<uint32_t> (1))
+
+	  .AddTraceSource ("TimeInBuffer", "Traces the time every buffered PDU spent in the buffer before being forwarded to the new 3N name",
+			   MakeTraceSourceAccessor (&ForwardingStrategy::m_timeInBuffer),
+			   "ns3::nnn::ForwardingStrategy::BufferTimeTracedCallback")
+
+	  .AddTraceSource ("BufferHistogram", "Traces the time in buffer histogram of the PDUs of a destination once all have been forwarded",
+			   MakeTraceSourceAccessor (&ForwardingStrategy::m_bufferHistogram),
+			   "ns3::nnn::ForwardingStrategy::BufferHistogramTracedCallback")
+
+	  .AddTraceSource ("HandoffInterruption", "Traces the time PDUs to a node that left were held before being redirected to its new 3N name",
+			   MakeTraceSourceAccessor (&ForwardingStrategy::m_handoffInterruption),
+			   "ns3::nnn::ForwardingStrategy::HandoffTracedCallback")
+
+	  .AddTraceSource ("EnrollmentTime", "Traces the time from the first EN of a node to the AEN that completed its enrollment",
+			   MakeTraceSourceAccessor (&ForwardingStrategy::m_enrollmentTime),
+			   "ns3::nnn::ForwardingStrategy::EnrollmentTimeTracedCallback")
+
 	  .AddTraceSource ("Got3NName", "Traces when the forwarding strategy has a 3N name",
 			   MakeTraceSourceAccessor (&ForwardingStrategy::m_got3Nname),
 			   "ns3::nnn::ForwardingStrategy::NNNAddrTracedCallback")
@@ -338,6 +420,10 @@ namespace ns3
 			   MakeTraceSourceAccessor (&ForwardingStrategy::m_no3Nname),
 			   "ns3::nnn::ForwardingStrategy::NNNAddrTracedCallback")
 
+	  .AddTraceSource ("NextHopCache", "Traces every next hop cache lookup with the hit rate so far",
+			   MakeTraceSourceAccessor (&ForwardingStrategy::m_nexthopCache),
+			   "ns3::nnn::ForwardingStrategy::NextHopCacheTracedCallback")
+
 	  // Required for testing at this moment
 	  .AddConstructor <ForwardingStrategy> ()
 	  ;
@@ -350,15 +436,30 @@ namespace ns3
     , m_node_names           (Create<NamesContainer> ())
     , m_leased_names         (Create<NamesContainer> ())
     , m_node_pdu_buffer      (Create<PDUBuffer> ())
-    , m_producedNameNumber   (0)
+    , m_3n_label_width       (32)
+    , m_nexthop_generation   (0)
+    , m_nexthop_cache        (Create<NextHopCache> ())
     , m_on_ren_oen           (false)
     , m_sent_ren             (false)
+    , m_enroll_batch_window  (Seconds (0))
+    , m_enroll_name_block    (16)
+    , m_make_before_break    (false)
+    , m_mbb_hold             (MilliSeconds (50))
+    , m_mbb_max_retries      (3)
+    , m_mbb_retries          (0)
+    , m_stream_buffer        (false)
+    , m_stream_interval      (MilliSeconds (1))
+    , m_stream_burst         (4)
+    , m_buffer_histogram_bin (MilliSeconds (10))
+    , m_buffer_histogram     (20, 0)
     {
       m_node_names->RegisterCallbacks(
 	  MakeCallback (&ForwardingStrategy::Reenroll, this),
 	  MakeCallback (&ForwardingStrategy::Enroll, this)
       );
 
+      m_resolve = MakeCallback (&ForwardingStrategy::ResolveDestination, this);
+
       // This forces the seconds to be printed in non-scientific notation
       NS_LOG_INFO (std::fixed);
     }
@@ -378,6 +479,14 @@ namespace ns3
       m_got3Nname ();
     }
 
+    void
+    ForwardingStrategy::AddLeasedName (Ptr<const NNNAddress> name, Time lease, bool fixed)
+    {
+      NS_LOG_FUNCTION (this << *name << lease);
+
+      m_leased_names->addEntry (name, lease, fixed);
+    }
+
     const NNNAddress&
     ForwardingStrategy::GetNode3NName ()
     {
@@ -390,50 +499,117 @@ namespace ns3
       return m_node_names->findNewestName();
     }
 
+    Ptr<const NamesContainer>
+    ForwardingStrategy::GetNodeNames () const
+    {
+      return m_node_names;
+    }
+
+    Ptr<const NamesContainer>
+    ForwardingStrategy::GetLeasedNames () const
+    {
+      return m_leased_names;
+    }
+
+    Ptr<PDUBuffer>
+    ForwardingStrategy::GetPDUBuffer () const
+    {
+      return m_node_pdu_buffer;
+    }
+
     Ptr<NNNAddress>
     ForwardingStrategy::produce3NName ()
     {
       NS_LOG_FUNCTION (this);
-      bool produced = false;
 
-      Ptr<NNNAddress> final;
+      if (!Has3NName ())
+	return 0;
+
+      Ptr<NameAllocator> allocator = GetNameAllocator (GetNode3NName ());
 
-      if (Has3NName ())
+      while (true)
 	{
-	  // Get this nodes currently functioning 3N name and copy it to a new variable
-	  NNNAddress base = GetNode3NName ();
+	  Ptr<NNNAddress> ret = allocator->Allocate ();
+	  if (ret == 0)
+	    {
+	      NS_LOG_INFO ("No 3N names left under (" << allocator->GetSector () << ")");
+	      return 0;
+	    }
 
-	  while (!produced)
+	  // Check if by unfortunate circumstances the created name has already been leased
+	  bool leased = m_leased_names->foundName (ret);
+	  if (! (leased || (m_node_lease_times.find (ret) != m_node_lease_times.end ())))
 	    {
-	      // Create an empty container for the 3N name
-	      Ptr<NNNAddress> ret;
+	      NS_LOG_INFO("Produced a 3N name (" << *ret << ")");
+	      return ret;
+	    }
+
+	  // Leased before the allocator tracked it, keep the label until the lease is over
+	  NS_LOG_INFO ("We have already produced (" << *ret << ") cycling through");
+	  Time check = leased ? m_leased_names->findNameExpireTime (ret) : Simulator::Now () + m_3n_lease_ack_timeout;
+	  Simulator::Schedule (std::max (check - Simulator::Now (), Seconds (0)), &ForwardingStrategy::CheckNameRelease, this, Ptr<const NNNAddress> (ret));
+	}
+    }
 
-	      // Create a random numerical component
-	      name::Component tmp = name::Component ();
-	      // Add the information
-	      tmp.fromNumber(m_producedNameNumber);
+    Ptr<NameAllocator>
+    ForwardingStrategy::GetNameAllocator (const NNNAddress &sector)
+    {
+      Ptr<const NNNAddress> key = Create<const NNNAddress> (sector);
 
-	      // Create a NNNAddress with base
-	      ret = Create <NNNAddress> (base.toDotHex());
-	      // Append the new component
-	      ret->append(tmp);
+      std::map<Ptr<const NNNAddress>, Ptr<NameAllocator>, PtrNNNComp>::iterator it = m_name_allocators.find (key);
+      if (it != m_name_allocators.end ())
+	return it->second;
 
-	      // Check if by unfortunate circumstances the created name has already been leased
-	      if (! (m_leased_names->foundName(ret) || (m_node_lease_times.find (ret) != m_node_lease_times.end ())))
-		{
-		  produced = true;
-		  final = ret;
-		}
-	      else
-		{
-		  NS_LOG_INFO ("We have already produced (" << *ret << ") cycling through");
-		  m_producedNameNumber++;
-		}
+      NS_LOG_INFO ("Creating a " << m_3n_label_width << " bit 3N name allocator for (" << sector << ")");
+      Ptr<NameAllocator> allocator = Create<NameAllocator> (sector, m_3n_label_width);
+      m_name_allocators[key] = allocator;
+      return allocator;
+    }
+
+    void
+    ForwardingStrategy::ReleaseName (Ptr<const NNNAddress> name)
+    {
+      Ptr<const NNNAddress> sector = Create<const NNNAddress> (name->getSectorName ());
+
+      std::map<Ptr<const NNNAddress>, Ptr<NameAllocator>, PtrNNNComp>::iterator it = m_name_allocators.find (sector);
+      if (it != m_name_allocators.end ())
+	it->second->Release (*name);
+    }
+
+    void
+    ForwardingStrategy::CheckNameRelease (Ptr<const NNNAddress> name)
+    {
+      // The offer was acknowledged by now or will not be, an AEN has already
+      // taken the start of a completed enrollment
+      m_enroll_start.erase (name);
+
+      if (m_leased_names->foundName (name))
+	{
+	  Time expire = m_leased_names->findNameExpireTime (name);
+	  if (expire > Simulator::Now ())
+	    {
+	      Simulator::Schedule (expire - Simulator::Now (), &ForwardingStrategy::CheckNameRelease, this, name);
+	      return;
 	    }
+	}
 
-	  NS_LOG_INFO("Produced a 3N name (" << *final << ")");
+      NS_LOG_INFO ("(" << *name << ") is no longer offered or leased, releasing it");
+
+      // Offers that were never acknowledged leave their lease record behind
+      m_node_lease_times.erase (name);
+      ReleaseName (name);
+    }
+
+    void
+    ForwardingStrategy::PrintNameOccupancy (std::ostream &os) const
+    {
+      os << "Sector\tLabelWidth\tAllocated\tPeak\tCapacity\tOccupancy\tAllocations\tReleases" << std::endl;
+
+      std::map<Ptr<const NNNAddress>, Ptr<NameAllocator>, PtrNNNComp>::const_iterator it;
+      for (it = m_name_allocators.begin (); it != m_name_allocators.end (); it++)
+	{
+	  os << *it->second << std::endl;
 	}
-      return final;
     }
 
     bool
@@ -460,6 +636,18 @@ namespace ns3
       return m_node_pdu_buffer->GetReTX();
     }
 
+    void
+    ForwardingStrategy::SetNextHopCacheSize (uint32_t size)
+    {
+      m_nexthop_cache->SetSize (size);
+    }
+
+    uint32_t
+    ForwardingStrategy::GetNextHopCacheSize () const
+    {
+      return m_nexthop_cache->GetSize ();
+    }
+
     void
     ForwardingStrategy::flushBuffer(Ptr<Face> face, Ptr<NNNAddress> oldName, Ptr<NNNAddress> newName)
     {
@@ -467,92 +655,225 @@ namespace ns3
       NNNAddress myAddr = GetNode3NName ();
       if (m_node_pdu_buffer->DestinationExists(oldName))
 	{
+	  // Traffic to the node was held from the DEN until now
+	  std::map<Ptr<const NNNAddress>, Time, PtrNNNComp>::iterator start = m_buffer_start.find (oldName);
+	  if (start != m_buffer_start.end ())
+	    {
+	      m_handoffInterruption (oldName, newName, Simulator::Now () - start->second);
+	      m_buffer_start.erase (start);
+	    }
+
+	  if (m_stream_buffer)
+	    {
+	      // New PDUs for oldName are redirected by the NNPT from now on, the
+	      // queued ones follow a few at a time
+	      if (m_buffer_streams.find (oldName) == m_buffer_streams.end ())
+		{
+		  NS_LOG_INFO ("On (" << myAddr << ") streaming the queue for (" << *oldName << ") to (" << *newName << ")");
+		  m_buffer_streams[oldName] = newName;
+		  Simulator::ScheduleNow (&ForwardingStrategy::StreamBuffer, this, oldName);
+		}
+	      return;
+	    }
 
 	  NS_LOG_INFO ("On (" << myAddr << ") found a queue for (" << *oldName << "), attempting to flush");
-	  // The actual queue
-	  std::queue<Ptr<Packet> > addrQueue = m_node_pdu_buffer->PopQueue(oldName);
 
-	  // Dummy Pointers to the PDU types
-	  Ptr<DO> do_o_orig;
-	  Ptr<DU> du_o_orig;
+	  std::vector<uint64_t> histogram (m_buffer_histogram.size (), 0);
+	  uint32_t flushed = 0;
+	  Time arrival;
+	  Ptr<Packet> queuePDU;
 
-	  uint32_t do_flush = 0;
-	  uint32_t du_flush = 0;
+	  while ((queuePDU = m_node_pdu_buffer->PopPDU (oldName, arrival)) != 0)
+	    {
+	      if (SendBufferedPDU (queuePDU, oldName, newName))
+		{
+		  AddBufferTime (oldName, Simulator::Now () - arrival, histogram);
+		  flushed++;
+		}
+	    }
 
-	  std::pair<Ptr<Face>, Address> closestSector;
+	  FinishBufferFlush (oldName, newName, histogram);
 
-	  Ptr<Face> outFace;
-	  Address destAddr;
+	  NS_LOG_INFO ("On (" << myAddr << ") flushed (" << *oldName << ") -> (" << *newName << ") <-> " << flushed << " PDUs");
+	}
+      else
+	{
+	  NS_LOG_INFO ("On (" << myAddr << ") no buffer found for (" << *oldName << "), continuing");
+	}
+    }
+
+    void
+    ForwardingStrategy::StreamBuffer (Ptr<NNNAddress> oldName)
+    {
+      NS_LOG_FUNCTION (this << *oldName);
+
+      std::map<Ptr<const NNNAddress>, Ptr<NNNAddress>, PtrNNNComp>::iterator stream = m_buffer_streams.find (oldName);
+      if (stream == m_buffer_streams.end ())
+	return;
+
+      Ptr<NNNAddress> newName = stream->second;
+      std::vector<uint64_t> &histogram = m_buffer_stream_histograms[oldName];
+      histogram.resize (m_buffer_histogram.size (), 0);
 
-	  while (!addrQueue.empty())
+      Time arrival;
+      for (uint32_t i = 0; i < m_stream_burst; i++)
+	{
+	  Ptr<Packet> queuePDU = m_node_pdu_buffer->PopPDU (oldName, arrival);
+	  if (queuePDU == 0)
 	    {
-	      // Get the PDU at the front of the queue
-	      Ptr<Packet> queuePDU = addrQueue.front();
+	      NS_LOG_INFO ("Finished streaming (" << *oldName << ") -> (" << *newName << ")");
+	      std::vector<uint64_t> done;
+	      done.swap (histogram);
+	      m_buffer_stream_histograms.erase (oldName);
+	      m_buffer_streams.erase (stream);
+	      FinishBufferFlush (oldName, newName, done);
+	      return;
+	    }
 
-	      switch(HeaderHelper::GetNNNHeaderType(queuePDU))
-	      {
-		case DO_NNN:
-		  // Convert the Packet back to a DO for manipulation
-		  do_o_orig = wire::nnnSIM::DO::FromWire(queuePDU);
-
-		  // Renew the DO lifetime
-		  do_o_orig->SetLifetime(m_3n_lifetime);
-		  // Change the DO 3N name to the new name
-		  do_o_orig->SetName(newName);
-
-		  // Find where to send the SO
-		  closestSector = m_nnst->ClosestSectorFaceInfo(newName, 0);
-
-		  outFace = closestSector.first;
-		  destAddr = closestSector.second;
-
-		  // Send the created DO PDU
-		  outFace->SendDO(do_o_orig, destAddr);
-		  // Log the DO sending
-		  m_outDOs(do_o_orig, outFace);
-		  do_flush++;
-		  break;
-		case DU_NNN:
-		  // Convert the Packet back to a DU for manipulation
-		  du_o_orig = wire::nnnSIM::DU::FromWire(queuePDU);
+	  if (SendBufferedPDU (queuePDU, oldName, newName))
+	    AddBufferTime (oldName, Simulator::Now () - arrival, histogram);
+	}
 
-		  // Renew the DU lifetime
-		  du_o_orig->SetLifetime(m_3n_lifetime);
+      Simulator::Schedule (m_stream_interval, &ForwardingStrategy::StreamBuffer, this, oldName);
+    }
 
-		  // Change the DU 3N names to the new names if necessary
-		  if (du_o_orig->GetDstName() == *oldName)
-		    du_o_orig->SetDstName(newName);
+    bool
+    ForwardingStrategy::SendBufferedPDU (Ptr<Packet> queuePDU, Ptr<NNNAddress> oldName, Ptr<NNNAddress> newName)
+    {
+      // Dummy Pointers to the PDU types
+      Ptr<DO> do_o_orig;
+      Ptr<DU> du_o_orig;
 
-		  if (du_o_orig->GetSrcName() == *oldName)
-		    du_o_orig->SetSrcName(newName);
+      std::pair<Ptr<Face>, Address> closestSector;
 
-		  // Find where to send the DU
-		  closestSector = m_nnst->ClosestSectorFaceInfo(du_o_orig->GetDstNamePtr(), 0);
+      Ptr<Face> outFace;
+      Address destAddr;
 
-		  outFace = closestSector.first;
-		  destAddr = closestSector.second;
+      switch(HeaderHelper::GetNNNHeaderType(queuePDU))
+      {
+	case DO_NNN:
+	  // Convert the Packet back to a DO for manipulation
+	  do_o_orig = wire::nnnSIM::DO::FromWire(queuePDU);
 
-		  // Send the created DU PDU
-		  outFace->SendDU(du_o_orig, destAddr);
-		  // Log the DU sending
-		  m_outDUs(du_o_orig, outFace);
-		  du_flush++;
-		  break;
-		default:
-		  NS_LOG_INFO("Obtained unknown PDU");
-	      }
-	      // Pop the queue and continue
-	      addrQueue.pop ();
-	    }
+	  // Renew the DO lifetime
+	  do_o_orig->SetLifetime(m_3n_lifetime);
+	  // Change the DO 3N name to the new name
+	  do_o_orig->SetName(newName);
 
-	  // Make sure we delete the entry for oldName in the buffer
-	  m_node_pdu_buffer->RemoveDestination(oldName);
+	  // Find where to send the SO
+	  closestSector = m_nnst->ClosestSectorFaceInfo(newName, 0);
 
-	  NS_LOG_INFO ("On (" << myAddr << ") flushed (" << *oldName << ") -> (" << *newName << ") <->  DO: " << do_flush << " DU: " << du_flush );
-	}
-      else
+	  outFace = closestSector.first;
+	  destAddr = closestSector.second;
+
+	  // Send the created DO PDU
+	  outFace->SendDO(do_o_orig, destAddr);
+	  // Log the DO sending
+	  m_outDOs(do_o_orig, outFace);
+	  return true;
+	case DU_NNN:
+	  // Convert the Packet back to a DU for manipulation
+	  du_o_orig = wire::nnnSIM::DU::FromWire(queuePDU);
+
+	  // Renew the DU lifetime
+	  du_o_orig->SetLifetime(m_3n_lifetime);
+
+	  // Change the DU 3N names to the new names if necessary
+	  if (du_o_orig->GetDstName() == *oldName)
+	    du_o_orig->SetDstName(newName);
+
+	  if (du_o_orig->GetSrcName() == *oldName)
+	    du_o_orig->SetSrcName(newName);
+
+	  // Find where to send the DU
+	  closestSector = m_nnst->ClosestSectorFaceInfo(du_o_orig->GetDstNamePtr(), 0);
+
+	  outFace = closestSector.first;
+	  destAddr = closestSector.second;
+
+	  // Send the created DU PDU
+	  outFace->SendDU(du_o_orig, destAddr);
+	  // Log the DU sending
+	  m_outDUs(du_o_orig, outFace);
+	  return true;
+	default:
+	  NS_LOG_INFO("Obtained unknown PDU");
+	  return false;
+      }
+    }
+
+    void
+    ForwardingStrategy::AddBufferTime (Ptr<const NNNAddress> oldName, Time inBuffer, std::vector<uint64_t> &histogram)
+    {
+      size_t bin = histogram.size () - 1;
+      if (m_buffer_histogram_bin.IsStrictlyPositive ())
+	bin = std::min<size_t> (inBuffer.GetInteger () / m_buffer_histogram_bin.GetInteger (), bin);
+
+      histogram[bin]++;
+      m_buffer_histogram[bin]++;
+
+      m_timeInBuffer (oldName, inBuffer);
+    }
+
+    void
+    ForwardingStrategy::FinishBufferFlush (Ptr<NNNAddress> oldName, Ptr<NNNAddress> newName, const std::vector<uint64_t> &histogram)
+    {
+      // Make sure we delete the entry for oldName in the buffer
+      m_node_pdu_buffer->RemoveDestination(oldName);
+      m_buffer_start.erase (oldName);
+      m_nexthop_generation++;
+
+      m_bufferHistogram (oldName, histogram, m_buffer_histogram_bin);
+    }
+
+    void
+    ForwardingStrategy::ExpireBuffer (Ptr<NNNAddress> oldName, Time start)
+    {
+      NS_LOG_FUNCTION (this << *oldName);
+
+      std::map<Ptr<const NNNAddress>, Time, PtrNNNComp>::iterator it = m_buffer_start.find (oldName);
+      if (it == m_buffer_start.end () || it->second != start)
+	return;
+
+      // A flush in progress removes the buffer itself
+      if (m_buffer_streams.find (oldName) != m_buffer_streams.end ())
+	return;
+
+      NS_LOG_INFO ("(" << *oldName << ") did not reappear before its lease ended, dropping its buffer");
+      m_node_pdu_buffer->RemoveDestination (oldName);
+      m_buffer_start.erase (it);
+      m_nexthop_generation++;
+    }
+
+    void
+    ForwardingStrategy::SetBufferHistogramBins (uint32_t bins)
+    {
+      m_buffer_histogram.assign (std::max<uint32_t> (bins, 1), 0);
+    }
+
+    uint32_t
+    ForwardingStrategy::GetBufferHistogramBins () const
+    {
+      return m_buffer_histogram.size ();
+    }
+
+    const std::vector<uint64_t> &
+    ForwardingStrategy::GetBufferHistogram () const
+    {
+      return m_buffer_histogram;
+    }
+
+    void
+    ForwardingStrategy::PrintBufferHistogram (std::ostream &os) const
+    {
+      for (size_t i = 0; i < m_buffer_histogram.size (); i++)
 	{
-	  NS_LOG_INFO ("On (" << myAddr << ") no buffer found for (" << *oldName << "), continuing");
+	  os << m_buffer_histogram_bin.GetSeconds () * i << "\t";
+	  if (i + 1 < m_buffer_histogram.size ())
+	    os << m_buffer_histogram_bin.GetSeconds () * (i + 1);
+	  else
+	    os << "inf";
+	  os << "\t" << m_buffer_histogram[i] << std::endl;
 	}
     }
 
@@ -566,59 +887,197 @@ namespace ns3
       // Find if we can produce 3N names
       if (m_produce3Nnames && Has3NName ())
 	{
-	  NNNAddress myAddr = GetNode3NName ();
-	  NS_LOG_INFO("On (" << myAddr << ") producing 3N name for new node");
+	  if (m_enroll_batch_window.IsStrictlyPositive ())
+	    {
+	      // Coalesce the EN with the others arriving in the same window
+	      PendingEN pending;
+	      pending.m_face = face;
+	      pending.m_en = en_p;
+	      pending.m_arrival = Simulator::Now ();
+	      m_pending_ens.push_back (pending);
+
+	      if (!m_enroll_batch_event.IsRunning ())
+		m_enroll_batch_event = Simulator::Schedule (m_enroll_batch_window, &ForwardingStrategy::ProcessENBatch, this);
+	      return;
+	    }
+
+	  // Produce a 3N name
+	  Ptr<NNNAddress> produced3Nname = produce3NName ();
+	  if (produced3Nname != 0)
+	    EnrollNode (face, en_p, produced3Nname, Simulator::Now ());
+	  else
+	    m_dropENs (en_p, face);
+	}
+      else
+	{
+	  m_dropENs (en_p, face);
+	}
+    }
+
+    void
+    ForwardingStrategy::EnrollNode (Ptr<Face> face, Ptr<EN> en_p, Ptr<NNNAddress> produced3Nname, Time arrival)
+    {
+      NS_LOG_FUNCTION (this << face->GetId () << *produced3Nname);
+
+      NNNAddress myAddr = GetNode3NName ();
+      NS_LOG_INFO("On (" << myAddr << ") producing 3N name for new node");
+
+      // Get the first Address from the EN PDU (this probably requires more tuning)
+      Address destAddr = en_p->GetOnePoa(0);
+
+      NS_LOG_INFO ("On (" << myAddr << "), will return OEN to " << destAddr);
+
+      // Get all the PoA Address in the EN PDU to fill the NNST
+      std::vector<Address> poaAddrs = en_p->GetPoas();
+
+      NS_LOG_INFO ("Received PoA Names: ");
+      for (size_t i = 0; i < poaAddrs.size (); i++)
+	{
+	  NS_LOG_INFO (i << ": " << poaAddrs[i]);
+	}
 
-	  // Get the first Address from the EN PDU (this probably requires more tuning)
-	  Address destAddr = en_p->GetOnePoa(0);
+      // Add the new information into the Awaiting Response NNST type structure
+      // Create a 5 second timeout - remember absolute time
+      m_awaiting_response->Add(produced3Nname, face, poaAddrs, Simulator::Now () + m_3n_lease_ack_timeout, m_standardMetric);
 
-	  NS_LOG_INFO ("On (" << myAddr << "), will return OEN to " << destAddr);
+      NS_LOG_INFO ("On (" << myAddr << ") creating OEN PDU to send");
+      // Create an OEN PDU to respond
+      Ptr<OEN> oen_p = Create<OEN> (produced3Nname);
+      oen_p->SetLifetime(m_3n_lifetime);
+      // Ensure that the lease time is set in the PDU
+      // We send the lease out in absolute simulator time
+      Time absoluteLease = Simulator::Now () + m_3n_lease_time;
+      oen_p->SetLeasetime(absoluteLease);
+      // Add the PoA names to the PDU
+      oen_p->AddPoa(poaAddrs);
+      // Add my name to the PDU
+      oen_p->SetSrcName (GetNode3NName ());
+      // Add personal PoAs
+      oen_p->AddPersonalPoa (GetAllPoANames (face));
 
-	  // Get all the PoA Address in the EN PDU to fill the NNST
-	  std::vector<Address> poaAddrs = en_p->GetPoas();
+      // Send the create OEN PDU out the way it came
+      face->SendOEN(oen_p, destAddr);
 
-	  NS_LOG_INFO ("Received PoA Names: ");
-	  for (size_t i = 0; i < poaAddrs.size (); i++)
+      NS_LOG_INFO ("Making a lease entry in (" << myAddr << ") for (" <<*produced3Nname << ") until " << absoluteLease.GetSeconds());
+
+      // Maintain the lease time given to the 3N name for further checking
+      m_node_lease_times[oen_p->GetNamePtr()] = absoluteLease;
+
+      // Remember when the node asked, to measure the enrollment time
+      m_enroll_start[oen_p->GetNamePtr()] = arrival;
+
+      // Give the name back if the offer is not acknowledged
+      Simulator::Schedule (m_3n_lease_ack_timeout, &ForwardingStrategy::CheckNameRelease, this, oen_p->GetNamePtr ());
+
+      m_outOENs (oen_p, face);
+    }
+
+    void
+    ForwardingStrategy::ProcessENBatch ()
+    {
+      NS_LOG_FUNCTION (this << m_pending_ens.size ());
+
+      std::vector<PendingEN> batch;
+      batch.swap (m_pending_ens);
+
+      if (!m_produce3Nnames || !Has3NName ())
+	{
+	  // Lost our own name while the batch was waiting
+	  for (size_t i = 0; i < batch.size (); i++)
 	    {
-	      NS_LOG_INFO (i << ": " << poaAddrs[i]);
+	      m_dropENs (batch[i].m_en, batch[i].m_face);
 	    }
+	  return;
+	}
 
-	  // Produce a 3N name
-	  Ptr<NNNAddress> produced3Nname = produce3NName ();
-
-	  // Add the new information into the Awaiting Response NNST type structure
-	  // Create a 5 second timeout - remember absolute time
-	  m_awaiting_response->Add(produced3Nname, face, poaAddrs, Simulator::Now () + m_3n_lease_ack_timeout, m_standardMetric);
+      // A node repeating its EN within the window sends the same PoAs on the
+      // same Face, answer it once with the arrival of its first EN
+      typedef std::pair<uint32_t, std::vector<Address> > ENGroup;
+      std::map<ENGroup, size_t> groups;
+      std::vector<size_t> answer;
 
-	  NS_LOG_INFO ("On (" << myAddr << ") creating OEN PDU to send");
-	  // Create an OEN PDU to respond
-	  Ptr<OEN> oen_p = Create<OEN> (produced3Nname);
-	  oen_p->SetLifetime(m_3n_lifetime);
-	  // Ensure that the lease time is set in the PDU
-	  // We send the lease out in absolute simulator time
-	  Time absoluteLease = Simulator::Now () + m_3n_lease_time;
-	  oen_p->SetLeasetime(absoluteLease);
-	  // Add the PoA names to the PDU
-	  oen_p->AddPoa(poaAddrs);
-	  // Add my name to the PDU
-	  oen_p->SetSrcName (GetNode3NName ());
-	  // Add personal PoAs
-	  oen_p->AddPersonalPoa (GetAllPoANames (face));
+      for (size_t i = 0; i < batch.size (); i++)
+	{
+	  std::vector<Address> poas = batch[i].m_en->GetPoas ();
+	  std::sort (poas.begin (), poas.end ());
 
-	  // Send the create OEN PDU out the way it came
-	  face->SendOEN(oen_p, destAddr);
+	  ENGroup key (batch[i].m_face->GetId (), poas);
+	  if (groups.find (key) == groups.end ())
+	    {
+	      groups[key] = i;
+	      answer.push_back (i);
+	    }
+	  else
+	    {
+	      NS_LOG_INFO ("EN " << i << " of the batch repeats an earlier EN on Face " << batch[i].m_face->GetId ());
+	    }
+	}
 
-	  NS_LOG_INFO ("Making a lease entry in (" << myAddr << ") for (" <<*produced3Nname << ") until " << absoluteLease.GetSeconds());
+      NS_LOG_INFO ("Answering " << answer.size () << " of " << batch.size () << " ENs in the batch");
 
-	  // Maintain the lease time given to the 3N name for further checking
-	  m_node_lease_times[oen_p->GetNamePtr()] = absoluteLease;
+      for (size_t i = 0; i < answer.size (); i++)
+	{
+	  const PendingEN &pending = batch[answer[i]];
+	  Ptr<NNNAddress> name = NextReservedName (answer.size () - i);
+	  if (name != 0)
+	    EnrollNode (pending.m_face, pending.m_en, name, pending.m_arrival);
+	  else
+	    m_dropENs (pending.m_en, pending.m_face);
+	}
+    }
 
-	  m_outOENs (oen_p, face);
+    Ptr<NNNAddress>
+    ForwardingStrategy::NextReservedName (uint32_t needed)
+    {
+      // The block is only valid under the 3N name it was reserved from
+      if (!m_reserved_names.empty () && m_reserved_names.front ()->getSectorName () != GetNode3NName ())
+	{
+	  NS_LOG_INFO ("3N name changed, releasing " << m_reserved_names.size () << " reserved names");
+	  for (size_t i = 0; i < m_reserved_names.size (); i++)
+	    {
+	      ReleaseName (m_reserved_names[i]);
+	    }
+	  m_reserved_names.clear ();
 	}
-      else
+
+      if (m_reserved_names.empty ())
 	{
-	  m_dropENs (en_p, face);
+	  uint32_t block = std::max (needed, m_enroll_name_block);
+	  for (uint32_t i = 0; i < block; i++)
+	    {
+	      Ptr<NNNAddress> name = produce3NName ();
+	      if (name == 0)
+		break;
+	      m_reserved_names.push_back (name);
+	    }
+	  NS_LOG_INFO ("Reserved a block of " << m_reserved_names.size () << " 3N names");
+
+	  if (m_reserved_names.empty ())
+	    return 0;
 	}
+
+      Ptr<NNNAddress> name = m_reserved_names.front ();
+      m_reserved_names.pop_front ();
+      return name;
+    }
+
+    Time
+    ForwardingStrategy::GetEnrollmentTimePercentile (double p) const
+    {
+      if (m_enroll_times.GetCount () == 0)
+	return Seconds (0);
+
+      return NanoSeconds (m_enroll_times.GetQuantile (p / 100.0));
+    }
+
+    void
+    ForwardingStrategy::PrintEnrollmentTimes (std::ostream &os) const
+    {
+      os << "Enrollments: " << m_enroll_times.GetCount ()
+	  << " p50: " << GetEnrollmentTimePercentile (50).GetSeconds ()
+	  << "s p90: " << GetEnrollmentTimePercentile (90).GetSeconds ()
+	  << "s p99: " << GetEnrollmentTimePercentile (99).GetSeconds ()
+	  << "s max: " << GetEnrollmentTimePercentile (100).GetSeconds () << "s";
     }
 
     void
@@ -755,6 +1214,15 @@ namespace ns3
 		      // Add the information the the leased NodeNameContainer
 		      m_leased_names->addEntry(newName, absoluteLeaseTime, false);
 
+		      std::map<Ptr<const NNNAddress>, Time, PtrNNNComp>::iterator started = m_enroll_start.find (newName);
+		      if (started != m_enroll_start.end ())
+			{
+			  Time enrollment = Simulator::Now () - started->second;
+			  m_enroll_times.Add (static_cast<uint64_t> (enrollment.GetNanoSeconds ()));
+			  m_enrollmentTime (newName, enrollment);
+			  m_enroll_start.erase (started);
+			}
+
 		      NS_LOG_INFO("Saving face " << *face << " for REN purposes");
 		      // Add the Face where the AEN came from (used for REN purposes)
 		      m_returnEN_faces.insert (face);
@@ -810,6 +1278,11 @@ namespace ns3
 
 	  // Produce a new 3N name
 	  Ptr<const NNNAddress> produced3Nname = produce3NName ();
+	  if (produced3Nname == 0)
+	    {
+	      m_dropRENs (ren_p, face);
+	      return;
+	    }
 
 	  // Add the new information into the Awaiting Response NNST type structure
 	  // Create a 5 second timeout - must be in absolute simulator time
@@ -844,6 +1317,9 @@ namespace ns3
 	  NS_LOG_INFO ("Making a lease entry in (" << myAddr << ") for (" <<*produced3Nname << ") until " << absoluteLease.GetSeconds ());
 	  // Maintain the lease time given to the 3N name for further checking
 	  m_node_lease_times[oen_p->GetNamePtr()] = absoluteLease;
+
+	  // Give the name back if the offer is not acknowledged
+	  Simulator::Schedule (m_3n_lease_ack_timeout, &ForwardingStrategy::CheckNameRelease, this, oen_p->GetNamePtr ());
 	}
       else
 	{
@@ -904,11 +1380,28 @@ namespace ns3
 	  NS_LOG_INFO ("On (" << myAddr << ") we have left the sector and are too far, stopping propagation");
 	}
 
+      // With a make-before-break handoff the INF may already have told us
+      // where the node went. PDUs are redirected, so there is nothing to buffer
+      if (m_nnpt->foundOldName (leavingAddr))
+	{
+	  NS_LOG_INFO ("(" << *leavingAddr << ") is already redirected to (" << m_nnpt->findPairedName (leavingAddr) << "), not buffering");
+	  m_handoffInterruption (leavingAddr, m_nnpt->findPairedNamePtr (leavingAddr), Seconds (0));
+	  return;
+	}
+
       NS_LOG_INFO ("Adding (" << *leavingAddr << ") to buffers");
 
       // We know the node sending the DEN is moving. His lease time will be maintained
       // All we need to do is tell the buffer to keep the packets to that destination
       m_node_pdu_buffer->AddDestination (leavingAddr);
+      m_buffer_start[leavingAddr] = Simulator::Now ();
+      m_nexthop_generation++;
+
+      // Past its lease the old name cannot be redirected, do not keep its PDUs forever
+      Time lease = m_3n_lease_time;
+      if (m_leased_names->foundName (leavingAddr))
+	lease = std::max (m_leased_names->findNameExpireTime (leavingAddr) - Simulator::Now (), Seconds (0));
+      Simulator::Schedule (lease, &ForwardingStrategy::ExpireBuffer, this, leavingAddr, Simulator::Now ());
     }
 
     void
@@ -999,6 +1492,9 @@ namespace ns3
 	  // If you start using the 3N name, execute the following
 	  if (willUseName)
 	    {
+	      // Remember who gave the name, a later handoff must reach it with the DEN
+	      m_attach_poas = oen_p->GetPersonalPoas ();
+
 	      // If this came from a REN PDU, signal that you have received
 	      if (m_sent_ren)
 		{
@@ -1019,10 +1515,25 @@ namespace ns3
 	      face->SendAEN(aen_p);
 
 	      m_outAENs (aen_p, face);
+
+	      // The new attachment is up, give the old sector time to learn the
+	      // new name before telling it that we are leaving
+	      if (m_mbb_old_name != 0 && *m_mbb_old_name != *obtainedName)
+		{
+		  Simulator::Cancel (m_mbb_event);
+		  m_mbb_event = Simulator::Schedule (m_mbb_hold, &ForwardingStrategy::FinishHandoff, this);
+		}
 	    }
 	  else
 	    {
 	      NS_LOG_INFO ("Will not be using (" << *obtainedName << ")");
+
+	      // The new PoA kept us under the same 3N name, there is no old attachment to break
+	      if (m_mbb_old_name != 0 && *m_mbb_old_name == *obtainedName)
+		{
+		  NS_LOG_INFO ("Handoff kept (" << *obtainedName << "), nothing to leave");
+		  AbortHandoff ();
+		}
 	    }
 	}
     }
@@ -1144,6 +1655,7 @@ namespace ns3
     ForwardingStrategy::OnSO (Ptr<Face> face, Ptr<SO> so_p)
     {
       NS_LOG_FUNCTION (this << face->GetId () << face->GetFlags());
+      NNN_PROFILE_STAGE (ON_SO);
 
       m_inSOs (so_p, face);
 
@@ -1164,6 +1676,7 @@ namespace ns3
     ForwardingStrategy::OnDO (Ptr<Face> face, Ptr<DO> do_p)
     {
       NS_LOG_FUNCTION (this << face->GetId () << face->GetFlags());
+      NNN_PROFILE_STAGE (ON_DO);
 
       m_inDOs (do_p, face);
 
@@ -1184,6 +1697,7 @@ namespace ns3
     ForwardingStrategy::OnDU (Ptr<Face> face, Ptr<DU> du_p)
     {
       NS_LOG_FUNCTION (this << face->GetId () << face->GetFlags());
+      NNN_PROFILE_STAGE (ON_DU);
 
       m_inDUs (du_p, face);
 
@@ -1204,6 +1718,7 @@ namespace ns3
     ForwardingStrategy::ProcessICNPDU (Ptr<NNNPDU> pdu, Ptr<Face> face, Ptr<Packet> icn_pdu)
     {
       NS_LOG_FUNCTION (this << face->GetId ());
+      NNN_PROFILE_STAGE (PROCESS_ICN_PDU);
       bool receivedInterest =false;
       bool receivedData = false;
       Ptr<Interest> interest;
@@ -1280,6 +1795,7 @@ namespace ns3
     ForwardingStrategy::ProcessInterest (Ptr<NNNPDU> pdu, Ptr<Face> face, Ptr<Interest> interest)
     {
       NS_LOG_FUNCTION (this << face->GetId () << interest->GetName ());
+      NNN_PROFILE_STAGE (PROCESS_INTEREST);
       // Log the Interest PDU
       m_inInterests (interest, face);
 
@@ -1369,6 +1885,7 @@ namespace ns3
     ForwardingStrategy::ProcessData (Ptr<NNNPDU> pdu, Ptr<Face> face, Ptr<Data> data)
     {
       NS_LOG_FUNCTION (this << face->GetId () << data->GetName ());
+      NNN_PROFILE_STAGE (PROCESS_DATA);
       // Log the Data PDU
       m_inData (data, face);
 
@@ -1550,7 +2067,6 @@ namespace ns3
       // Check whether this node has a 3N name
       if (Has3NName () && !m_on_ren_oen)
 	{
-	  bool ok = false;
 	  Ptr<Face> tmp;
 	  // Now transmit the REN through all Faces that are not of type APPLICATION
 	  for (uint32_t i = 0; i < m_faces->GetN (); i++)
@@ -1569,35 +2085,7 @@ namespace ns3
 	      // Check that the Face is not of type APPLICATION
 	      if (!tmp->isAppFace ())
 		{
-		  std::vector<Address> poanames = GetAllPoANames (tmp);
-
-		  // Create the REN PDU to transmit
-		  Ptr<REN> ren_o = Create<REN> ();
-		  Ptr<const NNNAddress> addr = GetNode3NNamePtr ();
-
-		  // Set the lifetime for the REN PDU
-		  ren_o->SetLifetime (m_3n_lifetime);
-		  // Set the 3N name for the REN
-		  ren_o->SetName (*addr);
-		  // Write the expire time for the 3N name (Time within the simulator is absolute)
-		  ren_o->SetRemainLease (m_node_names->findNameExpireTime (addr));
-		  // Add all the PoA names we found
-		  for (size_t i = 0; i < poanames.size (); i++)
-		    {
-		      ren_o->AddPoa (poanames[i]);
-		    }
-
-		  NS_LOG_INFO ("Sending out REN via " << *tmp << " with (" << GetNode3NName () << ")");
-
-
-		  // Send the REN throughout the Faces
-		  ok = tmp->SendREN (ren_o);
-
-		  if (ok)
-		    {
-		      m_outRENs (ren_o, tmp);
-		      m_sent_ren = true;
-		    }
+		  ReenrollThrough (tmp);
 
 		  NS_LOG_INFO ("Scheduling an reenroll should things go south");
 		  // Schedule the another enroll, should things go bad
@@ -1614,6 +2102,49 @@ namespace ns3
 	}
     }
 
+    bool
+    ForwardingStrategy::ReenrollThrough (Ptr<Face> face)
+    {
+      NS_LOG_FUNCTION (this << face->GetId ());
+
+      if (!Has3NName ())
+	{
+	  NS_LOG_INFO ("No 3N name to reenroll through " << *face);
+	  return false;
+	}
+
+      std::vector<Address> poanames = GetAllPoANames (face);
+
+      // Create the REN PDU to transmit
+      Ptr<REN> ren_o = Create<REN> ();
+      Ptr<const NNNAddress> addr = GetNode3NNamePtr ();
+
+      // Set the lifetime for the REN PDU
+      ren_o->SetLifetime (m_3n_lifetime);
+      // Set the 3N name for the REN
+      ren_o->SetName (*addr);
+      // Write the expire time for the 3N name (Time within the simulator is absolute)
+      ren_o->SetRemainLease (m_node_names->findNameExpireTime (addr));
+      // Add all the PoA names we found
+      for (size_t i = 0; i < poanames.size (); i++)
+	{
+	  ren_o->AddPoa (poanames[i]);
+	}
+
+      NS_LOG_INFO ("Sending out REN via " << *face << " with (" << *addr << ")");
+
+      // Send the REN through the Face
+      bool ok = face->SendREN (ren_o);
+
+      if (ok)
+	{
+	  m_outRENs (ren_o, face);
+	  m_sent_ren = true;
+	}
+
+      return ok;
+    }
+
     void
     ForwardingStrategy::Disenroll ()
     {
@@ -1621,70 +2152,209 @@ namespace ns3
       // Check whether this node has a 3N name
       if (Has3NName ())
 	{
+	  if (DisenrollName (GetNode3NNamePtr (), 0))
+	    {
+	      // At this point, we should at least reset the REN flags
+	      m_sent_ren = false;
+	      m_on_ren_oen = false;
+	    }
+	}
+    }
+
+    bool
+    ForwardingStrategy::DisenrollName (Ptr<const NNNAddress> name, Ptr<Face> skip)
+    {
+      NS_LOG_FUNCTION (this << *name);
+
+      bool sent = false;
+      Ptr<Face> tmp;
+      // Now transmit the DEN through all Faces that are not of type APPLICATION
+      for (uint32_t i = 0; i < m_faces->GetN (); i++)
+	{
+	  // Get a Face
+	  tmp = m_faces->Get (i);
+	  // Check that the Face is not of type APPLICATION
+	  if (tmp->isAppFace () || tmp == skip)
+	    continue;
 
-	  bool ok = false;
+	  Ptr<DEN> den_o = CreateDEN (name, tmp);
 
-	  Ptr<Face> tmp;
-	  // Now transmit the DEN through all Faces that are not of type APPLICATION
-	  for (uint32_t i = 0; i < m_faces->GetN (); i++)
+	  // Send the DEN throughout the Faces
+	  if (tmp->SendDEN (den_o))
 	    {
-	      // Get a Face
-	      tmp = m_faces->Get (i);
-	      // Check that the Face is not of type APPLICATION
-	      if (!tmp->isAppFace ())
-		{
-		  std::vector<Address> poanames = GetAllPoANames (tmp);
+	      m_outDENs (den_o, tmp);
+	      sent = true;
+	    }
+	}
 
-		  // Create the REN PDU to transmit
-		  Ptr<DEN> den_o = Create<DEN> ();
-		  Ptr<const NNNAddress> addr = GetNode3NNamePtr ();
+      return sent;
+    }
 
-		  // Set the lifetime for the REN PDU
-		  den_o->SetLifetime (m_3n_lifetime);
-		  // Set the 3N name for the REN
-		  den_o->SetName (*addr);
-		  // Add all the PoA names we found
-		  for (size_t i = 0; i < poanames.size (); i++)
-		    {
-		      den_o->AddPoa (poanames[i]);
-		    }
-		  // Send the REN throughout the Faces
-		  ok = tmp->SendDEN (den_o);
+    Ptr<DEN>
+    ForwardingStrategy::CreateDEN (Ptr<const NNNAddress> name, Ptr<Face> face)
+    {
+      std::vector<Address> poanames = GetAllPoANames (face);
 
-		  if (ok)
-		    {
-		      m_outDENs (den_o, tmp);
-		      // At this point, we should at least reset the REN flags
-		      m_sent_ren = false;
-		      m_on_ren_oen = false;
-		    }
-		}
-	    }
+      // Create the DEN PDU to transmit
+      Ptr<DEN> den_o = Create<DEN> ();
+
+      // Set the lifetime for the DEN PDU
+      den_o->SetLifetime (m_3n_lifetime);
+      // Set the 3N name for the DEN
+      den_o->SetName (*name);
+      // Add all the PoA names we found
+      for (size_t i = 0; i < poanames.size (); i++)
+	{
+	  den_o->AddPoa (poanames[i]);
+	}
+
+      return den_o;
+    }
+
+    void
+    ForwardingStrategy::NotifyNewPoA (Ptr<Face> face)
+    {
+      NS_LOG_FUNCTION (this << face->GetId ());
+
+      if (!Has3NName ())
+	{
+	  NS_LOG_INFO ("No 3N name yet, enrolling through the new PoA");
+	  Enroll ();
+	  return;
+	}
+
+      if (!m_make_before_break)
+	{
+	  // Break before make: leave the old sector and then look for a new name
+	  Disenroll ();
+	  Reenroll ();
+	  return;
+	}
+
+      if (m_mbb_old_name != 0)
+	{
+	  NS_LOG_INFO ("Handoff away from (" << *m_mbb_old_name << ") already in progress");
+	  return;
+	}
+
+      // Keep the current attachment until the new 3N name has been acknowledged
+      m_mbb_old_name = GetNode3NNamePtr ();
+      m_mbb_old_poas = m_attach_poas;
+      m_mbb_face = face;
+      m_mbb_retries = 0;
+
+      NS_LOG_INFO ("Pre-enrolling (" << *m_mbb_old_name << ") through " << *face);
+      PreEnroll ();
+    }
+
+    void
+    ForwardingStrategy::PreEnroll ()
+    {
+      NS_LOG_FUNCTION (this);
+
+      if (m_mbb_old_name == 0 || m_mbb_face == 0)
+	return;
+
+      if (!Has3NName ())
+	{
+	  // The lease ran out during the handoff, there is nothing left to keep
+	  NS_LOG_INFO ("Lost (" << *m_mbb_old_name << ") during the handoff, enrolling");
+	  AbortHandoff ();
+	  Enroll ();
+	  return;
+	}
+
+      if (m_mbb_retries >= m_mbb_max_retries)
+	{
+	  NS_LOG_INFO ("No new 3N name after " << m_mbb_retries << " RENs, breaking before making");
+	  AbortHandoff ();
+	  Disenroll ();
+	  Reenroll ();
+	  return;
+	}
+
+      m_mbb_retries++;
+      ReenrollThrough (m_mbb_face);
+
+      // Try again should the REN or OEN be lost
+      m_mbb_event = Simulator::Schedule (m_ack_timeout, &ForwardingStrategy::PreEnroll, this);
+    }
+
+    void
+    ForwardingStrategy::FinishHandoff ()
+    {
+      NS_LOG_FUNCTION (this);
+
+      if (m_mbb_old_name == 0)
+	return;
+
+      NS_LOG_INFO ("Breaking the attachment of (" << *m_mbb_old_name << ")");
+      DisenrollName (m_mbb_old_name, m_mbb_face);
+
+      // A single radio reaches the old and the new PoA through the same
+      // Face, so address the DEN to the old PoAs rather than skip the Face.
+      // A 3N name that was not obtained through an OEN has no known PoAs,
+      // the DEN is then broadcast on the Face
+      Ptr<DEN> den_o = CreateDEN (m_mbb_old_name, m_mbb_face);
+      if (m_mbb_old_poas.empty () && m_mbb_face->SendDEN (den_o))
+	m_outDENs (den_o, m_mbb_face);
+
+      for (size_t i = 0; i < m_mbb_old_poas.size (); i++)
+	{
+	  if (std::find (m_attach_poas.begin (), m_attach_poas.end (), m_mbb_old_poas[i]) != m_attach_poas.end ())
+	    continue;
+
+	  if (m_mbb_face->SendDEN (den_o, m_mbb_old_poas[i]))
+	    m_outDENs (den_o, m_mbb_face);
 	}
+
+      m_mbb_old_name = 0;
+      m_mbb_old_poas.clear ();
+      m_mbb_face = 0;
+    }
+
+    void
+    ForwardingStrategy::AbortHandoff ()
+    {
+      NS_LOG_FUNCTION (this);
+
+      Simulator::Cancel (m_mbb_event);
+      m_mbb_old_name = 0;
+      m_mbb_old_poas.clear ();
+      m_mbb_face = 0;
+      m_mbb_retries = 0;
     }
 
     void
     ForwardingStrategy::DidAddNNSTEntry (Ptr<nnst::Entry> NNSTEntry)
     {
       NS_LOG_FUNCTION (this);
+      // Invalidate the next hops cached in PIT entries
+      m_nexthop_generation++;
     }
 
     void
     ForwardingStrategy::WillRemoveNNSTEntry (Ptr<nnst::Entry> NNSTEntry)
     {
       NS_LOG_FUNCTION (this);
+      // Invalidate the next hops cached in PIT entries
+      m_nexthop_generation++;
     }
 
     void
     ForwardingStrategy::DidAddNNPTEntry (Ptr<nnpt::Entry> NNPTEntry)
     {
       NS_LOG_FUNCTION (this);
+      // Invalidate the next hops cached in PIT entries
+      m_nexthop_generation++;
     }
 
     void
     ForwardingStrategy::WillRemoveNNPTEntry (Ptr<nnpt::Entry> NNPTEntry)
     {
       NS_LOG_FUNCTION (this);
+      // Invalidate the next hops cached in PIT entries
+      m_nexthop_generation++;
     }
 
     void
@@ -1860,6 +2530,7 @@ namespace ns3
                                                 Ptr<pit::Entry> pitEntry)
     {
       NS_LOG_FUNCTION (this);
+      NNN_PROFILE_STAGE (SATISFY_PENDING_INTEREST);
       NNNAddress myAddr = GetNode3NName ();
 
       NS_LOG_INFO ("On (" << myAddr << ") Satisfying pending Interests for " << data->GetName());
@@ -1922,10 +2593,8 @@ namespace ns3
 	NS_LOG_INFO ("On (" << myAddr << ") Satisfying for Face " << incoming.m_face->GetId() << " of type " << incoming.m_face->GetFlags() << " at (" << GetNode3NName () << ")");
 
 	/////////////////////////////////////////////////////////////////////////////////////////
-	// Obtain the distinct 3N names associated to this Face and go through them
-	std::vector<Ptr<NNNAddress> > distinct = incoming.m_addrs->GetDistinctDestinations ();
 	// It is possible for the face to have no destinations
-	if (distinct.empty())
+	if (incoming.m_addrs->GetNumDistinctDestinations () == 0)
 	  {
 	    // The PIT Entry has been created but has no 3N names. We satisfy with whatever we were given
 	    NS_LOG_INFO ("On (" << myAddr << ") Our PIT has no 3N names aggregated");
@@ -2152,16 +2821,20 @@ namespace ns3
 	  {
 	    NS_LOG_INFO ("On (" << myAddr << ") Our PIT has 3N names aggregated");
 
-	    // There is at least one 3N name in this list - go through the code
-	    BOOST_FOREACH (Ptr<NNNAddress> j, distinct)
+	    // There is at least one 3N name in this list - go through the distinct sectors
+	    Ptr<const NNNAddrEntry> sector;
+	    for (sector = incoming.m_addrs->Begin (); sector != incoming.m_addrs->End (); sector = incoming.m_addrs->Next (sector))
 	    {
+	      Ptr<NNNAddress> j = sector->GetSector ();
 	      bool subSector = m_node_names->foundName(j);
 	      NNNAddress newdst;
-	      // Obtain all the 3N names aggregated in this sector
-	      std::vector<Ptr<NNNAddress> > addrs = incoming.m_addrs->GetCompleteDestinations (j);
+	      // Obtain all the 3N names aggregated in this sector, with their next hops
+	      const std::vector<NNNAddrResolution> &addrs = sector->GetResolvedAddresses (m_nexthop_generation, m_resolve);
 
-	      BOOST_FOREACH (Ptr<NNNAddress> i, addrs)
+	      BOOST_FOREACH (const NNNAddrResolution &res, addrs)
 	      {
+		Ptr<NNNAddress> i = res.m_destination;
+
 		// If the aggregation is the same as the 3N Name the node is using, then
 		// everything aggregated is probably connected to it
 		if (subSector)
@@ -2245,17 +2918,16 @@ namespace ns3
 
 		// Go through the normal forwarding methods
 
-		// Check if the NNPT has any information for this particular 3N name
-		// Retrieve the new 3N name destination
-		bool redirect = m_nnpt->foundOldName(i);
+		// The NNPT redirection, buffering and next hop were resolved by ResolveDestination
+		bool redirect = res.m_redirect;
 
-		newdst = m_nnpt->findPairedNamePtr (i)->getName ();
+		newdst = *res.m_newdst;
 
 		if (redirect)
 		  NS_LOG_INFO ("We are on (" << myAddr << ") we are redirecting (" << *i << ") to (" << newdst << ")");
 
 		// We may have obtained a DEN so we need to check
-		if (m_node_pdu_buffer->DestinationExists (i) && !redirect)
+		if (res.m_buffered)
 		  {
 		    NS_LOG_INFO ("We are on (" << myAddr << ") we have been told to buffer this PDU to (" << *i << ")");
 
@@ -2274,11 +2946,9 @@ namespace ns3
 		NS_LOG_INFO ("On (" << myAddr << ") Going to look at NNST size: " << m_nnst->GetSize() << " to send to (" << newdst << ")");
 		NS_LOG_INFO (*m_nnst);
 
-		// Roughly pick the next hop that would bring us closer to newdst
-		std::pair<Ptr<Face>, Address> tmp = m_nnst->ClosestSectorFaceInfo (newdst, 0);
-
-		Ptr<Face> outFace = tmp.first;
-		Address destAddr = tmp.second;
+		// The next hop that would bring us closer to newdst
+		Ptr<Face> outFace = res.m_outFace;
+		Address destAddr = res.m_destAddr;
 
 		if ((wasNULL || wasSO || wasDO) && (!sentSomething || redirect))
 		  {
@@ -2418,6 +3088,42 @@ namespace ns3
       m_pit->MarkErased (pitEntry);
     }
 
+    void
+    ForwardingStrategy::ResolveDestination (NNNAddrResolution &res)
+    {
+      NS_LOG_FUNCTION (this << *res.m_destination);
+
+      // Check if the NNPT has any information for this particular 3N name
+      res.m_redirect = m_nnpt->foundOldName (res.m_destination);
+      // Retrieve the new 3N name destination
+      res.m_newdst = m_nnpt->findPairedNamePtr (res.m_destination);
+      // We may have obtained a DEN for the original destination
+      res.m_buffered = m_node_pdu_buffer->DestinationExists (res.m_destination) && !res.m_redirect;
+
+      // Roughly pick the next hop that would bring us closer to the new destination
+      if (m_nnst->GetSize () > 0)
+	{
+	  std::pair<Ptr<Face>, Address> tmp = m_nnst->ClosestSectorFaceInfo (res.m_newdst, 0);
+	  res.m_outFace = tmp.first;
+	  res.m_destAddr = tmp.second;
+	}
+      else
+	{
+	  res.m_outFace = 0;
+	  res.m_destAddr = Address ();
+	}
+    }
+
+    const NNNAddrResolution&
+    ForwardingStrategy::LookupNextHop (Ptr<const NNNAddress> dst)
+    {
+      const NNNAddrResolution &res = m_nexthop_cache->Lookup (dst, m_nexthop_generation, m_resolve);
+
+      m_nexthopCache (dst, m_nexthop_cache->WasHit (), m_nexthop_cache->GetHitRate ());
+
+      return res;
+    }
+
     void
     ForwardingStrategy::DidSendOutData (Ptr<Face> inFace,
                                         Ptr<Face> outFace,
@@ -2710,6 +3416,7 @@ namespace ns3
                                              Ptr<pit::Entry> pitEntry)
     {
       NS_LOG_FUNCTION (this);
+      NNN_PROFILE_STAGE (DO_PROPAGATE_INTEREST);
       NS_ASSERT_MSG (m_pit != 0, "PIT should be aggregated with forwarding strategy");
 
       int propagatedCount = 0;
@@ -2717,6 +3424,9 @@ namespace ns3
       // Get the number of Faces available
       int totalFaces = pitEntry->GetFibEntry ()->m_faces.size ();
 
+      // An Interest with a cached wire has not changed since it was decoded from the 3N PDU
+      bool samePayload = (interest->GetWire () != 0);
+
       // Convert the Interest PDU into a NS-3 Packet
       Ptr<Packet> icn_pdu = ns3::icn::Wire::FromInterest (interest);
 
@@ -2805,8 +3515,12 @@ namespace ns3
 	      return propagatedCount > 0;
 	    }
 
+	  // Obtain the buffering, NNPT and NNST decision for this destination at once.
+	  // Copied since sending may trigger other lookups
+	  NNNAddrResolution nexthop = LookupNextHop (constdstPtr);
+
 	  // We may have obtained a DEN so we need to check
-	  if (m_node_pdu_buffer->DestinationExists (newdst) && !m_nnpt->foundOldName(constdstPtr))
+	  if (nexthop.m_buffered)
 	    {
 	      NS_LOG_INFO ("We are on (" << GetNode3NName () << ") we have been told to buffer this PDU to (" << newdst << ")");
 
@@ -2823,10 +3537,10 @@ namespace ns3
 	    }
 
 	  // Check if the NNPT has any information for this particular 3N name
-	  if (m_nnpt->foundOldName(constdstPtr))
+	  if (nexthop.m_redirect)
 	    {
 	      // Retrieve the new 3N name destination and update variable
-	      newdst = m_nnpt->findPairedNamePtr (constdstPtr)->getName ();
+	      newdst = *nexthop.m_newdst;
 	      // Flag that the NNPT made a change
 	      nnptRedirect = true;
 	    }
@@ -2847,6 +3561,11 @@ namespace ns3
 		  // Signal that the PDU had an ICN PDU as payload
 		  do_o_spec->SetPDUPayloadType (ICN_NNN);
 
+		  // Only the lifetime and destination differ from the received DO, so
+		  // its encoding is rewritten instead of serializing everything again
+		  if (samePayload && do_i->GetWire ())
+		    do_o_spec->SetPatchedWire (do_i->GetWire (), NNNPDU::WIRE_PATCH_LIFETIME | NNNPDU::WIRE_PATCH_DST);
+
 		  pdu_i = DynamicCast<NNNPDU> (do_o_spec);
 		}
 	      else if (wasDU)
@@ -2864,6 +3583,11 @@ namespace ns3
 		  // Signal that the PDU had an ICN PDU as payload
 		  du_o_spec->SetPDUPayloadType (ICN_NNN);
 
+		  // Only the lifetime and destination differ from the received DU, so
+		  // its encoding is rewritten instead of serializing everything again
+		  if (samePayload && du_i->GetWire ())
+		    du_o_spec->SetPatchedWire (du_i->GetWire (), NNNPDU::WIRE_PATCH_LIFETIME | NNNPDU::WIRE_PATCH_DST);
+
 		  pdu_i = DynamicCast<NNNPDU> (du_o_spec);
 		}
 	    }
@@ -2875,12 +3599,21 @@ namespace ns3
 
 	  for (int j = 0; j < totalFaces; j++)
 	    {
-	      // Roughly find the next hop
-	      tmp = m_nnst->ClosestSectorFaceInfo (newdst, j);
+	      if (j == 0)
+		{
+		  // The closest next hop is in the cached decision
+		  foutFace = nexthop.m_outFace;
+		  destAddr = nexthop.m_destAddr;
+		}
+	      else
+		{
+		  // Roughly find the next hop
+		  tmp = m_nnst->ClosestSectorFaceInfo (newdst, j);
 
-	      // Update the variables for Face and PoA name
-	      foutFace = tmp.first;
-	      destAddr = tmp.second;
+		  // Update the variables for Face and PoA name
+		  foutFace = tmp.first;
+		  destAddr = tmp.second;
+		}
 
 	      if (TrySendOutInterest(pdu_i, inFace, foutFace, destAddr, interest, pitEntry))
 		{
@@ -2942,6 +3675,9 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this);
 
+      // A Data with a cached wire has not changed since it was decoded from the 3N PDU
+      bool samePayload = (data->GetWire () != 0);
+
       // Convert the Interest PDU into a NS-3 Packet
       Ptr<Packet> icn_pdu = ns3::icn::Wire::FromData(data);
 
@@ -2976,7 +3712,6 @@ namespace ns3
       Ptr<Face> foutFace;
 
       // Pointers to use when we have DO or DU PDUs
-      std::pair<Ptr<Face>, Address> tmp;
       Address destAddr;
       NNNAddress newdst;
       Ptr<NNNAddress> newdstPtr;
@@ -3050,8 +3785,12 @@ namespace ns3
 	      return ok;
 	    }
 
+	  // Obtain the buffering, NNPT and NNST decision for this destination at once.
+	  // Copied since sending may trigger other lookups
+	  NNNAddrResolution nexthop = LookupNextHop (constdstPtr);
+
 	  // We may have obtained a DEN so we need to check
-	  if (m_node_pdu_buffer->DestinationExists (newdst) && !m_nnpt->foundOldName(constdstPtr))
+	  if (nexthop.m_buffered)
 	    {
 	      NS_LOG_INFO ("We are on (" << GetNode3NName () << ") we have been told to buffer this PDU to (" << newdst << ")");
 
@@ -3068,10 +3807,10 @@ namespace ns3
 	    }
 
 	  // Check if the NNPT has any information for this particular 3N name
-	  if (m_nnpt->foundOldName(constdstPtr))
+	  if (nexthop.m_redirect)
 	    {
 	      // Retrieve the new 3N name destination and update variable
-	      newdst = m_nnpt->findPairedNamePtr (constdstPtr)->getName ();
+	      newdst = *nexthop.m_newdst;
 	      // Flag that the NNPT made a change
 	      nnptRedirect = true;
 	    }
@@ -3092,6 +3831,11 @@ namespace ns3
 		  // Signal that the PDU had an ICN PDU as payload
 		  do_o_spec->SetPDUPayloadType (ICN_NNN);
 
+		  // Only the lifetime and destination differ from the received DO, so
+		  // its encoding is rewritten instead of serializing everything again
+		  if (samePayload && do_i->GetWire ())
+		    do_o_spec->SetPatchedWire (do_i->GetWire (), NNNPDU::WIRE_PATCH_LIFETIME | NNNPDU::WIRE_PATCH_DST);
+
 		  tosend_do = do_o_spec;
 		}
 	      else if (wasDU)
@@ -3109,16 +3853,18 @@ namespace ns3
 		  // Signal that the PDU had an ICN PDU as payload
 		  du_o_spec->SetPDUPayloadType (ICN_NNN);
 
+		  // Only the lifetime and destination differ from the received DU, so
+		  // its encoding is rewritten instead of serializing everything again
+		  if (samePayload && du_i->GetWire ())
+		    du_o_spec->SetPatchedWire (du_i->GetWire (), NNNPDU::WIRE_PATCH_LIFETIME | NNNPDU::WIRE_PATCH_DST);
+
 		  tosend_du = du_o_spec;
 		}
 	    }
 
-	  // Roughly find the next hop
-	  tmp = m_nnst->ClosestSectorFaceInfo (newdst, 0);
-
-	  // Update the variables for Face and PoA name
-	  foutFace = tmp.first;
-	  destAddr = tmp.second;
+	  // Use the next hop from the cached decision
+	  foutFace = nexthop.m_outFace;
+	  destAddr = nexthop.m_destAddr;
 
 
 	  if (wasDO)
@@ -3198,6 +3944,15 @@ namespace ns3
       m_nnpt = 0;
       m_nnst = 0;
 
+      Simulator::Cancel (m_enroll_batch_event);
+      m_pending_ens.clear ();
+
+      m_buffer_streams.clear ();
+      m_buffer_stream_histograms.clear ();
+
+      AbortHandoff ();
+      m_buffer_start.clear ();
+
       m_pit = 0;
       m_fib = 0;
       m_contentStore = 0;
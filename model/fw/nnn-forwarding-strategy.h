@@ -26,6 +26,7 @@
 #include "ns3/address.h"
 #include "ns3/nstime.h"
 #include "ns3/callback.h"
+#include "ns3/event-id.h"
 #include "ns3/object.h"
 #include "ns3/packet.h"
 #include "ns3/traced-callback.h"
@@ -34,8 +35,12 @@
 #include <boost/random/uniform_int_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
 
+#include <deque>
+#include <vector>
+
 #include "../nnn-face.h"
 #include "../nnn-naming.h"
+#include "../../utils/nnn-log-linear-histogram.h"
 
 namespace ns3
 {
@@ -95,6 +100,9 @@ namespace ns3
     namespace name { class Component; }
 
     class NNNAddrAggregator;
+    struct NNNAddrResolution;
+    class NextHopCache;
+    class NameAllocator;
     class PDUBuffer;
 
     class Interest;
@@ -140,16 +148,59 @@ namespace ns3
       virtual void
       SetNode3NName (Ptr<const NNNAddress> name, Time lease, bool fixed);
 
+      /**
+       * @brief Record a 3N name as leased by this node to one of its neighbours
+       *
+       * Used to load the state the enrollment protocol would have built, so
+       * that the name is never produced again while leased
+       *
+       * @param name leased 3N name
+       * @param lease absolute expiry time of the lease
+       * @param fixed whether the lease never expires
+       */
+      virtual void
+      AddLeasedName (Ptr<const NNNAddress> name, Time lease, bool fixed);
+
       virtual const NNNAddress&
       GetNode3NName ();
 
       virtual Ptr<const NNNAddress>
       GetNode3NNamePtr ();
 
-      // Produces a random 3N name under the delegated name space
+      /**
+       * @brief 3N names of this node
+       */
+      Ptr<const NamesContainer>
+      GetNodeNames () const;
+
+      /**
+       * @brief 3N names leased by this node to its neighbours
+       */
+      Ptr<const NamesContainer>
+      GetLeasedNames () const;
+
+      /**
+       * @brief Buffer of the PDUs waiting for their destinations to reattach
+       */
+      Ptr<PDUBuffer>
+      GetPDUBuffer () const;
+
+      // Produces a 3N name under the delegated name space, 0 if the sector is full
       virtual Ptr<NNNAddress>
       produce3NName ();
 
+      /**
+       * @brief Get the allocator of the 3N names produced under a sector, creating it if needed
+       */
+      Ptr<NameAllocator>
+      GetNameAllocator (const NNNAddress &sector);
+
+      /**
+       * @brief Print the occupancy of the 3N name allocator of every sector, one per line
+       */
+      void
+      PrintNameOccupancy (std::ostream &os) const;
+
       virtual bool
       Has3NName ();
 
@@ -162,9 +213,40 @@ namespace ns3
       virtual Time
       GetRetxTimer () const;
 
+      void
+      SetNextHopCacheSize (uint32_t size);
+
+      uint32_t
+      GetNextHopCacheSize () const;
+
+      /**
+       * @brief Forward the PDUs buffered for oldName to newName
+       *
+       * With StreamBufferedPDUs the PDUs are forwarded StreamBurst at a time
+       * every StreamInterval, while new PDUs for oldName are redirected by the
+       * NNPT and skip the buffer
+       */
       virtual void
       flushBuffer (Ptr<Face> face, Ptr<NNNAddress> oldName, Ptr<NNNAddress> newName);
 
+      void
+      SetBufferHistogramBins (uint32_t bins);
+
+      uint32_t
+      GetBufferHistogramBins () const;
+
+      /**
+       * @brief Get the number of buffered PDUs in every bin of the time in buffer histogram
+       */
+      const std::vector<uint64_t> &
+      GetBufferHistogram () const;
+
+      /**
+       * @brief Print the time in buffer histogram, one bin per line with its bounds in seconds
+       */
+      void
+      PrintBufferHistogram (std::ostream &os) const;
+
       /**
        * \brief Actual processing of incoming 3N ENs
        *
@@ -175,6 +257,24 @@ namespace ns3
       virtual void
       OnEN (Ptr<Face> face, Ptr<EN> en_p);
 
+      /**
+       * @brief Get a percentile of the time from the first EN of a node to the AEN that completed its enrollment
+       *
+       * The times are kept in a LogLinearHistogram, so the value returned is
+       * within 1/16 of the exact percentile
+       *
+       * @param p percentile, between 0 and 100
+       * @returns 0 if no enrollment has completed
+       */
+      Time
+      GetEnrollmentTimePercentile (double p) const;
+
+      /**
+       * @brief Print the number of completed enrollments and the 50th, 90th and 99th percentiles and maximum of their time
+       */
+      void
+      PrintEnrollmentTimes (std::ostream &os) const;
+
       /**
        * \brief Actual processing of incoming 3N AENs.
        *
@@ -312,6 +412,20 @@ namespace ns3
       virtual void
       Disenroll ();
 
+      /**
+       * @brief Tell the strategy that a Face is now attached to a new PoA
+       *
+       * Mobility scenarios call this when the node associates with a new
+       * PoA. Without MakeBeforeBreak the node sends a DEN and reenrolls. With
+       * MakeBeforeBreak the node reenrolls through the new PoA first and only
+       * sends the DEN for its old 3N name MakeBeforeBreakHold after the new
+       * 3N name has been acknowledged.
+       *
+       * @param face Face attached to the new PoA
+       */
+      virtual void
+      NotifyNewPoA (Ptr<Face> face);
+
       /**
        * @brief Event fired every time a NNST entry is added to NNST
        * @param NNSTEntry NNST entry that was added
@@ -500,6 +614,31 @@ namespace ns3
                               Ptr<const Data> data,
                               Ptr<pit::Entry> pitEntry);
 
+      /**
+       * @brief Fill the forwarding decision for a 3N destination aggregated in a PIT entry
+       *
+       * The result is cached in the PIT entry until the NNST, NNPT or PDU
+       * buffer change, so this method should only depend on those tables
+       *
+       * @param res destination to resolve, with its complete 3N name already set
+       *
+       * @see SatisfyPendingInterest
+       */
+      virtual void
+      ResolveDestination (NNNAddrResolution &res);
+
+      /**
+       * @brief Obtain the forwarding decision for the destination of a DO or DU PDU
+       *
+       * Looks up the next hop cache, calling ResolveDestination on a miss
+       *
+       * @param dst 3N name of the destination
+       *
+       * @return decision for dst, only valid until the next lookup
+       */
+      const NNNAddrResolution&
+      LookupNextHop (Ptr<const NNNAddress> dst);
+
       /**
        * @brief Event which is fired just after data was send out on the face
        *
@@ -720,7 +859,152 @@ namespace ns3
       typedef void (* NNNAddrTracedCallback)
 	  (void);
 
+      typedef void (* NextHopCacheTracedCallback)
+	  (const Ptr<const NNNAddress>, bool, double);
+
+      typedef void (* EnrollmentTimeTracedCallback)
+	  (const Ptr<const NNNAddress>, const Time &);
+
+      typedef void (* HandoffTracedCallback)
+	  (const Ptr<const NNNAddress>, const Ptr<const NNNAddress>, const Time &);
+
+      typedef void (* BufferTimeTracedCallback)
+	  (const Ptr<const NNNAddress>, const Time &);
+
+      typedef void (* BufferHistogramTracedCallback)
+	  (const Ptr<const NNNAddress>, const std::vector<uint64_t> &, const Time &);
+
     protected:
+      /**
+       * @brief Answer an EN with an OEN offering the given 3N name
+       *
+       * @param face Face the EN came in on
+       * @param en_p EN PDU
+       * @param name 3N name offered to the node
+       * @param arrival time the first EN of the node was received
+       */
+      virtual void
+      EnrollNode (Ptr<Face> face, Ptr<EN> en_p, Ptr<NNNAddress> name, Time arrival);
+
+      /**
+       * @brief Answer the ENs coalesced during the last EnrollmentBatchWindow
+       */
+      void
+      ProcessENBatch ();
+
+      /**
+       * @brief Take the next 3N name of the reserved block, reserving a new block if needed
+       *
+       * @param needed number of names the caller is going to take, used to size the block
+       */
+      Ptr<NNNAddress>
+      NextReservedName (uint32_t needed);
+
+      /**
+       * @brief Give a produced 3N name back to the allocator of its sector
+       */
+      void
+      ReleaseName (Ptr<const NNNAddress> name);
+
+      /**
+       * @brief Release a produced 3N name once it is neither offered nor leased
+       *
+       * Scheduled when the offer times out; reschedules itself at the lease
+       * expiry while the name is leased
+       */
+      void
+      CheckNameRelease (Ptr<const NNNAddress> name);
+
+      /**
+       * @brief Send a REN for the current 3N name through one Face
+       * @returns true if the REN was sent, false if there is no 3N name to reenroll
+       */
+      bool
+      ReenrollThrough (Ptr<Face> face);
+
+      /**
+       * @brief Send a DEN for a 3N name through every network Face
+       *
+       * @param name 3N name the node is leaving
+       * @param skip Face not to send the DEN through, may be 0
+       * @returns true if at least one DEN was sent
+       */
+      bool
+      DisenrollName (Ptr<const NNNAddress> name, Ptr<Face> skip);
+
+      /**
+       * @brief Create the DEN announcing that the node leaves a 3N name
+       *
+       * @param name 3N name the node is leaving
+       * @param face Face the DEN will be sent through, gives the PoAs of the DEN
+       */
+      Ptr<DEN>
+      CreateDEN (Ptr<const NNNAddress> name, Ptr<Face> face);
+
+      /**
+       * @brief Send the REN of a make-before-break handoff, rescheduled until the new name is obtained
+       *
+       * After MakeBeforeBreakRetries RENs without an OEN the handoff falls
+       * back to break before make
+       */
+      void
+      PreEnroll ();
+
+      /**
+       * @brief Forget the current make-before-break handoff without sending the DEN for the old 3N name
+       */
+      void
+      AbortHandoff ();
+
+      /**
+       * @brief Send the DEN for the 3N name used before a make-before-break handoff
+       */
+      void
+      FinishHandoff ();
+
+      /**
+       * @brief Forward the next burst of PDUs buffered for oldName, rescheduled until the buffer is empty
+       */
+      void
+      StreamBuffer (Ptr<NNNAddress> oldName);
+
+      /**
+       * @brief Rename and forward a PDU taken from the buffer of oldName
+       * @returns false if the PDU is not a DO or DU
+       */
+      bool
+      SendBufferedPDU (Ptr<Packet> queuePDU, Ptr<NNNAddress> oldName, Ptr<NNNAddress> newName);
+
+      /**
+       * @brief Count the time a forwarded PDU spent in the buffer
+       */
+      void
+      AddBufferTime (Ptr<const NNNAddress> oldName, Time inBuffer, std::vector<uint64_t> &histogram);
+
+      /**
+       * @brief Remove the buffer of oldName once all its PDUs have been forwarded
+       */
+      void
+      FinishBufferFlush (Ptr<NNNAddress> oldName, Ptr<NNNAddress> newName, const std::vector<uint64_t> &histogram);
+
+      /**
+       * @brief Drop the buffer of oldName if the node has not reappeared by the end of its lease
+       *
+       * @param start arrival of the DEN that created the buffer, a later DEN keeps the buffer
+       */
+      void
+      ExpireBuffer (Ptr<NNNAddress> oldName, Time start);
+
+      /**
+       * @brief EN waiting for the current enrollment batch to be processed
+       */
+      struct PendingEN
+      {
+	Ptr<Face> m_face;
+	Ptr<EN> m_en;
+	Time m_arrival;
+      };
+
       // inherited from Object class
       virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
       virtual void DoDispose (); ///< @brief Do cleanup
@@ -753,10 +1037,41 @@ namespace ns3
       Time m_3n_lifetime;
       Time m_ack_timeout;
       int32_t m_standardMetric;
-      uint64_t m_producedNameNumber;
+      uint32_t m_3n_label_width; ///< \brief Bits of the label appended to the sector name for produced 3N names
+      std::map<Ptr<const NNNAddress>, Ptr<NameAllocator>, PtrNNNComp> m_name_allocators; ///< \brief Produced 3N names per sector
+      uint64_t m_nexthop_generation; ///< \brief Bumped every time the NNST, NNPT or PDU buffer change
+      Ptr<NextHopCache> m_nexthop_cache; ///< \brief Forwarding decisions for DO and DU destinations
+      Callback<void, NNNAddrResolution &> m_resolve; ///< \brief Callback to ResolveDestination
       bool m_on_ren_oen;
       bool m_sent_ren;
 
+      Time m_enroll_batch_window; ///< \brief ENs arriving within this time are answered together, 0 answers them immediately
+      uint32_t m_enroll_name_block; ///< \brief Number of 3N names reserved at once for batched enrollments
+      std::vector<PendingEN> m_pending_ens; ///< \brief ENs of the current batch
+      EventId m_enroll_batch_event; ///< \brief Processing of the current batch
+      std::deque<Ptr<NNNAddress> > m_reserved_names; ///< \brief 3N names reserved for batched enrollments
+      std::map <Ptr<const NNNAddress>, Time, PtrNNNComp> m_enroll_start; ///< \brief Arrival of the first EN of each offered 3N name
+      LogLinearHistogram m_enroll_times; ///< \brief Duration in nanoseconds of the completed enrollments
+
+      bool m_make_before_break; ///< \brief Obtain the new 3N name before leaving the old PoA
+      Time m_mbb_hold; ///< \brief Time between the AEN for the new 3N name and the DEN for the old one
+      Ptr<const NNNAddress> m_mbb_old_name; ///< \brief 3N name being left in the current handoff, 0 if none
+      Ptr<Face> m_mbb_face; ///< \brief Face attached to the new PoA in the current handoff
+      std::vector<Address> m_attach_poas; ///< \brief PoAs of the node that gave the current 3N name
+      std::vector<Address> m_mbb_old_poas; ///< \brief PoAs of the attachment being left in the current handoff
+      EventId m_mbb_event; ///< \brief Next REN or the DEN of the current handoff
+      uint32_t m_mbb_max_retries; ///< \brief RENs sent in a handoff before falling back to break before make
+      uint32_t m_mbb_retries; ///< \brief RENs sent in the current handoff
+      std::map <Ptr<const NNNAddress>, Time, PtrNNNComp> m_buffer_start; ///< \brief Arrival of the DEN of every buffered destination
+
+      bool m_stream_buffer; ///< \brief Forward buffered PDUs a few at a time
+      Time m_stream_interval; ///< \brief Time between bursts of streamed PDUs
+      uint32_t m_stream_burst; ///< \brief Number of PDUs forwarded in every burst
+      std::map <Ptr<const NNNAddress>, Ptr<NNNAddress>, PtrNNNComp> m_buffer_streams; ///< \brief New 3N name of every buffer being streamed
+      std::map <Ptr<const NNNAddress>, std::vector<uint64_t>, PtrNNNComp> m_buffer_stream_histograms; ///< \brief Time in buffer histogram of every buffer being streamed
+      Time m_buffer_histogram_bin; ///< \brief Width of the bins of the time in buffer histogram
+      std::vector<uint64_t> m_buffer_histogram; ///< \brief Time in buffer histogram of all forwarded PDUs
+
       ////////////////////////////////////////////////////////////////////
 
       TracedCallback<Ptr<const EN>,
@@ -901,6 +1216,24 @@ namespace ns3
       TracedCallback<> m_got3Nname;
       TracedCallback<> m_no3Nname;
 
+      TracedCallback<Ptr<const NNNAddress>,
+      bool /*hit*/,
+      double /*hit rate*/> m_nexthopCache; ///< @brief trace of next hop cache lookups
+
+      TracedCallback<Ptr<const NNNAddress>,
+      const Time & /*enrollment time*/> m_enrollmentTime; ///< @brief trace of completed enrollments
+
+      TracedCallback<Ptr<const NNNAddress>,
+      const Time & /*time in buffer*/> m_timeInBuffer; ///< @brief trace of the time every forwarded PDU was buffered
+
+      TracedCallback<Ptr<const NNNAddress>,
+      const std::vector<uint64_t> & /*PDUs per bin*/,
+      const Time & /*bin width*/> m_bufferHistogram; ///< @brief trace of the time in buffer histogram of every flushed destination
+
+      TracedCallback<Ptr<const NNNAddress> /*old name*/,
+      Ptr<const NNNAddress> /*new name*/,
+      const Time & /*interruption*/> m_handoffInterruption; ///< @brief trace of the time PDUs were held during handoffs
+
     private:
       // Number generator
       boost::random::mt19937_64 gen;
@@ -0,0 +1,190 @@
+/* -*- Mode: C++; c-file-style: "gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-name-allocator.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-name-allocator.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-name-allocator.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include "nnn-name-allocator.h"
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.NameAllocator");
+
+  namespace nnn
+  {
+    NameAllocator::NameAllocator (const NNNAddress &sector, uint32_t labelWidth)
+    : m_sector      (sector)
+    , m_width       (labelWidth)
+    , m_capacity    (static_cast<uint64_t> (1) << labelWidth)
+    , m_watermark   (0)
+    , m_allocated   (0)
+    , m_peak        (0)
+    , m_allocations (0)
+    , m_releases    (0)
+    {
+      NS_ASSERT_MSG (labelWidth >= 1 && labelWidth <= 32, "3N label width must be between 1 and 32 bits");
+    }
+
+    NameAllocator::~NameAllocator ()
+    {
+    }
+
+    Ptr<NNNAddress>
+    NameAllocator::Allocate ()
+    {
+      uint64_t label;
+
+      if (!m_free.empty ())
+	{
+	  label = m_free.front ();
+	  m_free.pop_front ();
+	}
+      else if (m_watermark < m_capacity)
+	{
+	  label = m_watermark++;
+	  if ((label >> 6) >= m_bitmap.size ())
+	    m_bitmap.push_back (0);
+	}
+      else
+	{
+	  NS_LOG_WARN ("No free labels left under (" << m_sector << ")");
+	  return 0;
+	}
+
+      m_bitmap[label >> 6] |= (static_cast<uint64_t> (1) << (label & 63));
+
+      m_allocated++;
+      m_allocations++;
+      if (m_allocated > m_peak)
+	m_peak = m_allocated;
+
+      // Copy the components of the sector instead of parsing its text form
+      Ptr<NNNAddress> name = Create<NNNAddress> (m_sector);
+      name->append (name::Component ().fromNumber (label));
+
+      NS_LOG_DEBUG ("Allocated (" << *name << "), " << m_allocated << " in use");
+      return name;
+    }
+
+    bool
+    NameAllocator::Release (uint64_t label)
+    {
+      if (!IsAllocated (label))
+	return false;
+
+      m_bitmap[label >> 6] &= ~(static_cast<uint64_t> (1) << (label & 63));
+      m_free.push_back (label);
+
+      m_allocated--;
+      m_releases++;
+
+      NS_LOG_DEBUG ("Released label " << label << " under (" << m_sector << "), " << m_allocated << " in use");
+      return true;
+    }
+
+    bool
+    NameAllocator::Release (const NNNAddress &name)
+    {
+      if (name.size () != m_sector.size () + 1 || name.getSectorName () != m_sector)
+	return false;
+
+      return Release (name.get (-1).toNumber ());
+    }
+
+    bool
+    NameAllocator::IsAllocated (uint64_t label) const
+    {
+      if (label >= m_watermark)
+	return false;
+
+      return (m_bitmap[label >> 6] >> (label & 63)) & 1;
+    }
+
+    const NNNAddress &
+    NameAllocator::GetSector () const
+    {
+      return m_sector;
+    }
+
+    uint32_t
+    NameAllocator::GetLabelWidth () const
+    {
+      return m_width;
+    }
+
+    uint64_t
+    NameAllocator::GetCapacity () const
+    {
+      return m_capacity;
+    }
+
+    uint64_t
+    NameAllocator::GetAllocated () const
+    {
+      return m_allocated;
+    }
+
+    uint64_t
+    NameAllocator::GetPeakAllocated () const
+    {
+      return m_peak;
+    }
+
+    double
+    NameAllocator::GetOccupancy () const
+    {
+      return static_cast<double> (m_allocated) / m_capacity;
+    }
+
+    uint64_t
+    NameAllocator::GetFreeLabels () const
+    {
+      return m_free.size ();
+    }
+
+    uint64_t
+    NameAllocator::GetAllocations () const
+    {
+      return m_allocations;
+    }
+
+    uint64_t
+    NameAllocator::GetReleases () const
+    {
+      return m_releases;
+    }
+
+    void
+    NameAllocator::Print (std::ostream &os) const
+    {
+      os << m_sector << "\t" << m_width << "\t" << m_allocated << "\t" << m_peak << "\t"
+	  << m_capacity << "\t" << GetOccupancy () << "\t" << m_allocations << "\t" << m_releases;
+    }
+
+    std::ostream& operator<< (std::ostream& os, const NameAllocator &allocator)
+    {
+      allocator.Print (os);
+      return os;
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,152 @@
+/* -*- Mode: C++; c-file-style: "gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-name-allocator.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-name-allocator.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-name-allocator.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_NAME_ALLOCATOR_H_
+#define NNN_NAME_ALLOCATOR_H_
+
+#include <deque>
+#include <ostream>
+#include <vector>
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include "../nnn-naming.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Allocator of the 3N names leased under one sector
+     *
+     * Names are the sector name followed by one label of at most LabelWidth
+     * bits. Labels are handed out in increasing order until the first
+     * release, after which released labels are reused oldest first, so that
+     * NNPT entries pointing at a released name have the most time to expire.
+     * A bitmap, grown only up to the highest label handed out, records which
+     * labels are in use. Allocate and Release are O(1).
+     */
+    class NameAllocator : public SimpleRefCount<NameAllocator>
+    {
+    public:
+      /**
+       * @param sector 3N name of the sector the names are produced under
+       * @param labelWidth number of bits of the label appended to the sector name, between 1 and 32
+       */
+      NameAllocator (const NNNAddress &sector, uint32_t labelWidth);
+
+      virtual
+      ~NameAllocator ();
+
+      /**
+       * @brief Obtain a 3N name with an unused label
+       *
+       * @returns 0 if every label is in use
+       */
+      Ptr<NNNAddress>
+      Allocate ();
+
+      /**
+       * @brief Return a label so that it can be allocated again
+       *
+       * @returns false if the label was not in use
+       */
+      bool
+      Release (uint64_t label);
+
+      /**
+       * @brief Return the label of a 3N name produced by this allocator
+       *
+       * @returns false if the name is not under the sector or its label was not in use
+       */
+      bool
+      Release (const NNNAddress &name);
+
+      bool
+      IsAllocated (uint64_t label) const;
+
+      const NNNAddress &
+      GetSector () const;
+
+      uint32_t
+      GetLabelWidth () const;
+
+      /**
+       * @brief Number of labels the sector can hold
+       */
+      uint64_t
+      GetCapacity () const;
+
+      /**
+       * @brief Number of labels in use
+       */
+      uint64_t
+      GetAllocated () const;
+
+      /**
+       * @brief Largest number of labels in use at the same time
+       */
+      uint64_t
+      GetPeakAllocated () const;
+
+      /**
+       * @brief Fraction of the labels in use
+       */
+      double
+      GetOccupancy () const;
+
+      /**
+       * @brief Number of released labels waiting to be reused
+       */
+      uint64_t
+      GetFreeLabels () const;
+
+      uint64_t
+      GetAllocations () const;
+
+      uint64_t
+      GetReleases () const;
+
+      void
+      Print (std::ostream &os) const;
+
+    private:
+      NNNAddress m_sector;
+      uint32_t m_width;
+      uint64_t m_capacity;
+      uint64_t m_watermark;             ///< \brief Labels below have been handed out at least once
+      std::vector<uint64_t> m_bitmap;   ///< \brief One bit per label below m_watermark, set while in use
+      std::deque<uint64_t> m_free;      ///< \brief Released labels, oldest first
+
+      uint64_t m_allocated;
+      uint64_t m_peak;
+      uint64_t m_allocations;
+      uint64_t m_releases;
+    };
+
+    std::ostream& operator<< (std::ostream& os, const NameAllocator &allocator);
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_NAME_ALLOCATOR_H_ */
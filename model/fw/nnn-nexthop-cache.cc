@@ -0,0 +1,133 @@
+/* -*- Mode: C++; c-file-style: "gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-nexthop-cache.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-nexthop-cache.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-nexthop-cache.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/log.h"
+
+#include "nnn-nexthop-cache.h"
+
+#include "../../utils/nnn-fast-path.h"
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.NextHopCache");
+
+  namespace nnn
+  {
+    NextHopCache::NextHopCache (uint32_t size)
+    : m_slots (size)
+    , m_hits (0)
+    , m_lookups (0)
+    , m_lastHit (false)
+    {
+    }
+
+    NextHopCache::~NextHopCache ()
+    {
+    }
+
+    void
+    NextHopCache::SetSize (uint32_t size)
+    {
+      NS_LOG_FUNCTION (this << size);
+      m_slots.clear ();
+      m_slots.resize (size);
+    }
+
+    uint32_t
+    NextHopCache::GetSize () const
+    {
+      return m_slots.size ();
+    }
+
+    const NNNAddrResolution&
+    NextHopCache::Lookup (Ptr<const NNNAddress> dst, uint64_t generation, ResolveCallback resolve)
+    {
+      m_lookups++;
+
+      if (m_slots.empty ())
+	{
+	  m_lastHit = false;
+	  m_uncached.m_destination = Create<NNNAddress> (*dst);
+	  resolve (m_uncached);
+	  return m_uncached;
+	}
+
+      Slot &slot = m_slots[dst->hash () % m_slots.size ()];
+
+      if (slot.m_valid && slot.m_generation == generation && *slot.m_res.m_destination == *dst)
+	{
+	  m_lastHit = true;
+	  m_hits++;
+	  return slot.m_res;
+	}
+
+      NS_LOG_DEBUG ("Next hop cache miss for " << *dst);
+      m_lastHit = false;
+
+      // Reuse the stored name when the slot held this destination in an older generation
+      if (!slot.m_valid || *slot.m_res.m_destination != *dst)
+	slot.m_res.m_destination = Create<NNNAddress> (*dst);
+
+      resolve (slot.m_res);
+      slot.m_valid = true;
+      slot.m_generation = generation;
+
+      return slot.m_res;
+    }
+
+    void
+    NextHopCache::Clear ()
+    {
+      for (std::vector<Slot>::iterator it = m_slots.begin (); it != m_slots.end (); ++it)
+	{
+	  *it = Slot ();
+	}
+    }
+
+    bool
+    NextHopCache::WasHit () const
+    {
+      return m_lastHit;
+    }
+
+    uint64_t
+    NextHopCache::GetHits () const
+    {
+      return m_hits;
+    }
+
+    uint64_t
+    NextHopCache::GetLookups () const
+    {
+      return m_lookups;
+    }
+
+    double
+    NextHopCache::GetHitRate () const
+    {
+      if (m_lookups == 0)
+	return 0.0;
+
+      return static_cast<double> (m_hits) / m_lookups;
+    }
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,119 @@
+/* -*- Mode: C++; c-file-style: "gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-nexthop-cache.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-nexthop-cache.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-nexthop-cache.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_NEXTHOP_CACHE_H_
+#define NNN_NEXTHOP_CACHE_H_
+
+#include <vector>
+
+#include "ns3/simple-ref-count.h"
+
+#include "../addr-aggr/nnn-addr-aggregator.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Direct-mapped cache of forwarding decisions keyed on the 3N destination
+     *
+     * Each slot keeps the NNPT redirection, buffering state and NNST next hop
+     * for one destination, together with the generation it was computed in.
+     * A slot is only used when its destination matches and its generation is
+     * the current one, so any change to the NNST, NNPT or PDU buffer
+     * invalidates the whole cache at once
+     */
+    class NextHopCache : public SimpleRefCount<NextHopCache>
+    {
+    public:
+      typedef NNNAddrEntry::ResolveCallback ResolveCallback;
+
+      NextHopCache (uint32_t size = 64);
+
+      virtual
+      ~NextHopCache ();
+
+      /**
+       * @brief Change the number of slots, dropping everything cached
+       *
+       * A size of 0 disables caching, every lookup is then resolved
+       */
+      void
+      SetSize (uint32_t size);
+
+      uint32_t
+      GetSize () const;
+
+      /**
+       * @brief Obtain the forwarding decision for a 3N destination
+       *
+       * @param dst 3N name of the destination
+       * @param generation current generation of the forwarding tables
+       * @param resolve callback filling the decision on a miss
+       *
+       * @return decision for dst, valid until the next call to Lookup
+       */
+      const NNNAddrResolution&
+      Lookup (Ptr<const NNNAddress> dst, uint64_t generation, ResolveCallback resolve);
+
+      /**
+       * @brief Drop everything cached, keeping the statistics
+       */
+      void
+      Clear ();
+
+      bool
+      WasHit () const;
+
+      uint64_t
+      GetHits () const;
+
+      uint64_t
+      GetLookups () const;
+
+      double
+      GetHitRate () const;
+
+    private:
+      struct Slot
+      {
+	Slot ()
+	: m_valid (false)
+	, m_generation (0)
+	{
+	}
+
+	bool m_valid;
+	uint64_t m_generation;
+	NNNAddrResolution m_res;
+      };
+
+      std::vector<Slot> m_slots;
+      NNNAddrResolution m_uncached; ///< \brief Used when the cache is disabled
+      uint64_t m_hits;
+      uint64_t m_lookups;
+      bool m_lastHit;
+    };
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_NEXTHOP_CACHE_H_ */
@@ -26,6 +26,9 @@
 #include "nnn-name-format.h"
 #include "name-component.h"
 
+#include <algorithm>
+#include <cstring>
+
 NNN_NAMESPACE_BEGIN
 
 namespace name {
@@ -248,13 +251,25 @@ namespace name {
   uint64_t
   Component::toNumber () const
   {
-    uint64_t ret = 0;
-    for (const_iterator i = begin (); i != end (); i++)
-      {
-	ret <<= 8;
-	ret |= static_cast<unsigned char> (*i);
-      }
-    return ret;
+    if (empty ())
+      return 0;
+
+    // Only the last 8 bytes fit in the number
+    size_t length = std::min<size_t> (size (), 8);
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*> (buf ()) + size () - length;
+
+    // Load the label as one big endian word instead of shifting it in byte by byte
+    uint8_t word[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    std::memcpy (word + 8 - length, bytes, length);
+
+    return (static_cast<uint64_t> (word[0]) << 56) |
+	(static_cast<uint64_t> (word[1]) << 48) |
+	(static_cast<uint64_t> (word[2]) << 40) |
+	(static_cast<uint64_t> (word[3]) << 32) |
+	(static_cast<uint64_t> (word[4]) << 24) |
+	(static_cast<uint64_t> (word[5]) << 16) |
+	(static_cast<uint64_t> (word[6]) << 8) |
+	static_cast<uint64_t> (word[7]);
   }
 
   uint64_t
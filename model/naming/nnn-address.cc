@@ -26,6 +26,7 @@
 #include <boost/regex.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <ctype.h>
 #include "error.h"
 
@@ -35,6 +36,35 @@ NNN_NAMESPACE_BEGIN
 
 ATTRIBUTE_HELPER_CPP (NNNAddress);
 
+/**
+ * @brief Numeric labels of a NNNAddress, on the stack unless the name is longer than MAXCOMP
+ */
+class LabelArray
+{
+public:
+  LabelArray (const NNNAddress &name)
+    : m_labels (m_stack)
+  {
+    if (name.size () > MAXCOMP)
+      {
+	m_heap.resize (name.size ());
+	m_labels = &m_heap[0];
+      }
+    name.toLabels (m_labels);
+  }
+
+  inline const uint64_t *
+  get () const
+  {
+    return m_labels;
+  }
+
+private:
+  uint64_t m_stack[MAXCOMP];
+  std::vector<uint64_t> m_heap;
+  uint64_t *m_labels;
+};
+
 NNNAddress::NNNAddress ()
 {
 }
@@ -223,6 +253,26 @@ NNNAddress::compare (const NNNAddress &name) const
   return (i == this->end ()) ? -1 : +1;
 }
 
+size_t
+NNNAddress::hash () const
+{
+  // FNV-1a over the components, separating them so that a.bc != ab.c
+  size_t h = 2166136261u;
+
+  for (NNNAddress::const_iterator i = this->begin (); i != this->end (); i++)
+    {
+      for (name::Component::const_iterator j = i->begin (); j != i->end (); j++)
+	{
+	  h ^= static_cast<unsigned char> (*j);
+	  h *= 16777619u;
+	}
+      h ^= '.';
+      h *= 16777619u;
+    }
+
+  return h;
+}
+
 int
 NNNAddress::compareLabels(const NNNAddress & name) const
 {
@@ -234,64 +284,84 @@ NNNAddress::compareLabels(const NNNAddress & name) const
   else if (!this->isEmpty() && name.isEmpty ())
     return 1;
 
-  NNNAddress::const_iterator i = this->begin ();
-  NNNAddress::const_iterator j = name.begin ();
+  LabelArray a (*this);
+  LabelArray b (name);
 
-  for (; i != this->end () && j != name.end (); i++, j++)
+  size_t n = std::min (size (), name.size ());
+  size_t k = mismatchLabels (a.get (), b.get (), n);
+
+  if (k < n)
+    return (a.get ()[k] > b.get ()[k]) ? +1 : -1;
+
+  // The prefixes are the same
+  if (size () == name.size ())
+    return 0;
+
+  return (size () < name.size ()) ? +1 : -1;
+}
+
+size_t
+NNNAddress::toLabels (uint64_t *labels) const
+{
+  for (size_t i = 0; i < m_address_comp.size (); i++)
     {
-      if (i->toNumber () == j->toNumber ())
-	continue;
-      else
-	return (i->toNumber() > j->toNumber ()) ? +1 : -1;
+      labels[i] = m_address_comp[i].toNumber ();
     }
+  return m_address_comp.size ();
+}
 
-  // The prefixes are the same, test the final label
-  if (i == this->end () && j == name.end ())
+size_t
+NNNAddress::mismatchLabels (const uint64_t *a, const uint64_t *b, size_t n)
+{
+  size_t i = 0;
+
+  // Without data dependent branches inside a block the compiler can keep
+  // the four comparisons in vector registers
+  for (; i + 4 <= n; i += 4)
     {
-      i--;
-      j--;
-      if (i->toNumber() == j->toNumber())
-	{
-	  return 0;
-	}
-      else
-	return (i->toNumber() > j->toNumber ()) ? +1 : -1;
+      uint64_t diff = (a[i] ^ b[i]) | (a[i + 1] ^ b[i + 1]) |
+	  (a[i + 2] ^ b[i + 2]) | (a[i + 3] ^ b[i + 3]);
+      if (diff != 0)
+	break;
+    }
+
+  for (; i < n; i++)
+    {
+      if (a[i] != b[i])
+	break;
     }
 
-  return (i == this->end ()) ? +1 : -1;
+  return i;
 }
 
 bool
 NNNAddress::isSameSector (const NNNAddress &name) const
 {
-  NNNAddress currSec = getSectorName();
-  NNNAddress nameSec = name.getSectorName();
+  // Same as comparing getSectorName () of both, without copying the names
+  size_t currSec = isEmpty () ? 0 : size () - 1;
+  size_t nameSec = name.isEmpty () ? 0 : name.size () - 1;
 
-  int res = currSec.compare(nameSec);
+  if (currSec != nameSec)
+    return false;
 
-  return (res == 0);
+  for (size_t i = 0; i < currSec; i++)
+    {
+      if (m_address_comp[i].compare (name.m_address_comp[i]) != 0)
+	return false;
+    }
+
+  return true;
 }
+
 bool
 NNNAddress::isSubSector (const NNNAddress &name) const
 {
-
   if (name.size () <= this->size ())
     {
-      NNNAddress::const_iterator i = this->begin ();
-      NNNAddress::const_iterator j = name.begin ();
-
-      bool ret = true;
-
-      for (; i != this->end () && j != name.end (); i++, j++)
-	{
-	  if (j->toNumber () != i->toNumber ())
-	    {
-	      ret = false;
-	      break;
-	    }
-	}
+      LabelArray a (*this);
+      LabelArray b (name);
 
-      return ret;
+      return (mismatchLabels (a.get (), b.get (), name.size ()) == name.size ());
     }
   else
     return false;
@@ -302,21 +372,10 @@ NNNAddress::isParentSector (const NNNAddress &name) const
 {
   if (name.size () > this->size ())
     {
-      NNNAddress::const_iterator i = this->begin ();
-      NNNAddress::const_iterator j = name.begin ();
-
-      bool ret = true;
-
-      for (; i != this->end () && j != name.end (); i++, j++)
-	{
-	  if (j->toNumber () != i->toNumber ())
-	    {
-	      ret = false;
-	      break;
-	    }
-	}
+      LabelArray a (*this);
+      LabelArray b (name);
 
-      return ret;
+      return (mismatchLabels (a.get (), b.get (), size ()) == size ());
     }
   else
     return false;
@@ -445,59 +504,63 @@ NNNAddress::ConvertFrom (const Address &address)
 int
 NNNAddress::distance (const NNNAddress &name) const
 {
-  //std::cout << "Comparing " << *this << " with " << name << std::endl;
-  int res = compare(name);
+  // The distance is defined by recursing on the sector names of both
+  // addresses until they compare equal. Instead of copying the sector names,
+  // follow the length of both prefixes: the first component that differs in
+  // two prefixes is the first component that differs in the full names, as
+  // long as it is within both prefixes.
+  size_t s1 = size ();
+  size_t s2 = name.size ();
+  size_t n = std::min (s1, s2);
+
+  size_t first = 0;
+  int firstRes = 0;
+  for (; first < n; first++)
+    {
+      firstRes = m_address_comp[first].compare (name.m_address_comp[first]);
+      if (firstRes != 0)
+	break;
+    }
 
-  if (res == 0)
-    return 0;
-  else
+  int dist = 0;
+  while (true)
     {
-      NNNAddress::const_iterator i = this->begin ();
-      NNNAddress::const_iterator j = name.begin ();
-      if (isToplvlSector())
-	{
-	  int fin = name.size ();
-	  if (i->compare(*j) == 0)
-	    return fin - 1;
-	  else
-	    return fin;
-	}
+      // compare () of the current prefixes
+      int res;
+      if (first < std::min (s1, s2))
+	res = firstRes;
+      else if (s1 == s2)
+	res = 0;
+      else
+	res = (s1 < s2) ? -1 : +1;
 
-      if (name.isToplvlSector())
-	{
-	  int fin = size ();
-	  if (i->compare(*j) == 0)
-	    return fin - 1;
-	  else
-	    return fin;
-	}
+      if (res == 0)
+	return dist;
+
+      // Top level sectors, check if they share the first component
+      if (s1 == 1)
+	return dist + s2 - ((s2 > 0 && first > 0) ? 1 : 0);
+
+      if (s2 == 1)
+	return dist + s1 - ((first > 0) ? 1 : 0);
 
-      int s1 = size ();
-      int s2 = name.size ();
       if (s1 == s2)
 	{
-	  if (isSameSector(name))
-	    {
-	      return 2;
-	    }
+	  // Same sector
+	  if (first >= s1 - 1)
+	    return dist + 2;
 
 	  if (res == 1)
-	    {
-	      return getSectorName ().distance(name) + 1;
-	    }
+	    s1--;
 	  else
-	    {
-	      return distance(name.getSectorName ()) + 1;
-	    }
+	    s2--;
 	}
       else if (s1 > s2)
-	{
-	  return getSectorName ().distance(name) + 1;
-	}
+	s1--;
       else
-	{
-	  return distance(name.getSectorName ()) + 1;
-	}
+	s2--;
+
+      dist++;
     }
 }
 
@@ -263,6 +263,37 @@ public:
   int
   compareLabels (const NNNAddress &name) const;
 
+  /**
+   * @brief Write the numeric value of every label to a contiguous array
+   *
+   * Predicates that compare labels numerically convert each label once with
+   * this and then work on the arrays with mismatchLabels
+   *
+   * @param labels array of at least size () elements
+   * @returns number of labels written
+   */
+  size_t
+  toLabels (uint64_t *labels) const;
+
+  /**
+   * @brief Find the first position where two label arrays differ
+   *
+   * Four labels are compared per step, branching only once a block differs
+   *
+   * @param a labels of the first name
+   * @param b labels of the second name
+   * @param n number of labels to compare
+   * @returns index of the first different label, n if the first n labels are equal
+   */
+  static size_t
+  mismatchLabels (const uint64_t *a, const uint64_t *b, size_t n);
+
+  /**
+   * @brief Hash of the NNN address, computed over every component
+   */
+  size_t
+  hash () const;
+
   /**
    * @brief Find out if two NNN addresses belong to the same sector
    * @return True or False
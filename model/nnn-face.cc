@@ -41,6 +41,8 @@
 
 #include "../helper/nnn-header-helper.h"
 
+#include "../utils/nnn-stage-profiler.h"
+
 namespace ns3
 {
   NS_LOG_COMPONENT_DEFINE ("nnn.Face");
@@ -158,6 +160,7 @@ namespace ns3
     Face::SendNULLp (Ptr<const NULLp> n_o)
     {
       NS_LOG_FUNCTION (this << n_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -171,6 +174,7 @@ namespace ns3
     Face::SendNULLp (Ptr<const NULLp> n_o, Address addr)
     {
       NS_LOG_FUNCTION (this << n_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -184,6 +188,7 @@ namespace ns3
     Face::SendSO (Ptr<const SO> so_o)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << so_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -197,6 +202,7 @@ namespace ns3
     Face::SendSO (Ptr<const SO> so_o, Address addr)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << so_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -210,6 +216,7 @@ namespace ns3
     Face::SendDO (Ptr<const DO> do_o)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << do_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -223,6 +230,7 @@ namespace ns3
     Face::SendDO (Ptr<const DO> do_o, Address addr)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << do_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -236,6 +244,7 @@ namespace ns3
     Face::SendDU (Ptr<const DU> du_o)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << du_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -249,6 +258,7 @@ namespace ns3
     Face::SendDU (Ptr<const DU> du_o, Address addr)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << du_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -262,6 +272,7 @@ namespace ns3
     Face::SendEN (Ptr<const EN> en_o)
     {
       NS_LOG_FUNCTION (this << en_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -275,6 +286,7 @@ namespace ns3
     Face::SendEN (Ptr<const EN> en_o, Address addr)
     {
       NS_LOG_FUNCTION (this << en_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -288,6 +300,7 @@ namespace ns3
     Face::SendAEN (Ptr<const AEN> aen_o)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << aen_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -301,6 +314,7 @@ namespace ns3
     Face::SendAEN (Ptr<const AEN> aen_o, Address addr)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << aen_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -314,6 +328,7 @@ namespace ns3
     Face::SendREN (Ptr<const REN> ren_o)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << ren_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -327,6 +342,7 @@ namespace ns3
     Face::SendREN (Ptr<const REN> ren_o, Address addr)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << ren_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -340,6 +356,7 @@ namespace ns3
     Face::SendDEN (Ptr<const DEN> den_o)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << den_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -353,6 +370,7 @@ namespace ns3
     Face::SendDEN (Ptr<const DEN> den_o, Address addr)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << den_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -366,6 +384,7 @@ namespace ns3
     Face::SendOEN (Ptr<const OEN> oen_o)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << oen_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -379,6 +398,7 @@ namespace ns3
     Face::SendOEN (Ptr<const OEN> oen_o, Address addr)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << oen_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -392,6 +412,7 @@ namespace ns3
     Face::SendINF (Ptr<const INF> inf_o)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << inf_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -405,6 +426,7 @@ namespace ns3
     Face::SendINF (Ptr<const INF> inf_o, Address addr)
     {
       NS_LOG_FUNCTION (this << boost::cref (*this) << inf_o);
+      NNN_PROFILE_STAGE (FACE_SEND);
 
       if (!IsUp ())
 	{
@@ -430,6 +452,7 @@ namespace ns3
     Face::Receive (Ptr<const Packet> p)
     {
       NS_LOG_FUNCTION (this << p << p->GetSize ());
+      NNN_PROFILE_STAGE (FACE_RECEIVE);
 
       if (!IsUp ())
 	{
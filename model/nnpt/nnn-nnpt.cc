@@ -22,9 +22,12 @@
  */
 
 #include "nnn-nnpt.h"
+#include "../fw/nnn-forwarding-strategy.h"
 
 #include "ns3/log.h"
 
+#include "../../utils/nnn-fast-path.h"
+
 namespace ns3
 {
   NS_LOG_COMPONENT_DEFINE ("nnn.nnpt");
@@ -69,6 +72,12 @@ namespace ns3
             {
               NS_LOG_INFO ("addEntry : Adding entry for (" << *oldName << ") ->  (" << *newName  << ")");
               container.insert(nnpt::Entry(oldName, newName, lease_expire));
+              m_stats.m_inserts++;
+
+              // notify forwarding strategy about new NNPT entry
+              Ptr<ForwardingStrategy> fw = this->GetObject<ForwardingStrategy> ();
+              if (fw != 0)
+                fw->DidAddNNPTEntry (Create<nnpt::Entry> (oldName, newName, lease_expire));
               Simulator::Schedule(relativeExpireTime, &NNPT::cleanExpired, this);
             }
         }
@@ -83,14 +92,20 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this);
       nnpt::Entry tmp = findEntry (oldName);
-      container.erase(tmp);
+      deleteEntry (tmp);
     }
 
     void
     NNPT::deleteEntry (nnpt::Entry nnptEntry)
     {
       NS_LOG_FUNCTION (this);
-      container.erase(nnptEntry);
+
+      // notify forwarding strategy about soon be removed NNPT entry
+      Ptr<ForwardingStrategy> fw = this->GetObject<ForwardingStrategy> ();
+      if (fw != 0 && !nnptEntry.m_oldName->isEmpty ())
+	fw->WillRemoveNNPTEntry (Create<nnpt::Entry> (nnptEntry));
+
+      m_stats.m_erases += container.erase(nnptEntry);
     }
 
     bool
@@ -99,6 +114,7 @@ namespace ns3
       NS_LOG_FUNCTION (this);
       pair_set_by_oldname& names_index = container.get<oldname> ();
       pair_set_by_oldname::iterator it = names_index.find(name);
+      m_stats.Lookup (it != names_index.end (), 1);
 
       if (it == names_index.end())
 	{
@@ -118,6 +134,7 @@ namespace ns3
       NS_LOG_FUNCTION (this << *name);
       pair_set_by_newname& names_index = container.get<newname> ();
       pair_set_by_newname::iterator it = names_index.find(name);
+      m_stats.Lookup (it != names_index.end (), 1);
 
       nnpt::Entry tmp = *it;
 
@@ -157,6 +174,7 @@ namespace ns3
       NS_LOG_FUNCTION (this << *oldName);
       pair_set_by_oldname& pair_index = container.get<oldname> ();
       pair_set_by_oldname::iterator it = pair_index.find(oldName);
+      uint64_t depth = 1;
 
       if (it != pair_index.end())
 	{
@@ -166,13 +184,16 @@ namespace ns3
 	    {
 	      tmp = *it;
 	      it = pair_index.find(tmp.m_newName);
+	      depth++;
 	      if (it == pair_index.end())
 		break;
 	    }
+	  m_stats.Lookup (true, depth);
 	  return tmp.m_newName;
 	}
       else
 	{
+	  m_stats.Lookup (false, depth);
 	  return oldName;
 	}
     }
@@ -183,6 +204,7 @@ namespace ns3
       NS_LOG_FUNCTION (this << *newName);
       pair_set_by_newname& pair_index = container.get<newname> ();
       pair_set_by_newname::iterator it = pair_index.find(newName);
+      uint64_t depth = 1;
 
       if (it != pair_index.end ())
 	{
@@ -192,13 +214,16 @@ namespace ns3
 	    {
 	      tmp = *it;
 	      it = pair_index.find (tmp.m_oldName);
+	      depth++;
 	      if (it == pair_index.end ())
 		break;
 	    }
+	  m_stats.Lookup (true, depth);
 	  return tmp.m_oldName;
 	}
       else
 	{
+	  m_stats.Lookup (false, depth);
 	  return newName;
 	}
     }
@@ -209,6 +234,7 @@ namespace ns3
       NS_LOG_FUNCTION (this << *name);
       pair_set_by_oldname& pair_index = container.get<oldname> ();
       pair_set_by_oldname::iterator it = pair_index.find(name);
+      m_stats.Lookup (it != pair_index.end (), 1);
 
       if (it != pair_index.end())
 	{
@@ -290,6 +316,7 @@ namespace ns3
 	  if (it->m_lease_expire <= now)
 	    {
 	      NS_LOG_INFO ("cleanExpired : removing (" << *it->m_oldName << ") -> (" << *it->m_newName << ")");
+	      m_stats.m_expired++;
 	      deleteEntry(*it);
 	      break;
 	    }
@@ -297,6 +324,16 @@ namespace ns3
 	}
     }
 
+    TableStats
+    NNPT::GetStats () const
+    {
+      TableStats stats = m_stats;
+      stats.m_entries = container.size ();
+      // One node of about three pointers per entry in each of the three indexes
+      stats.m_bytes = stats.m_entries * (sizeof (nnpt::Entry) + 3 * 3 * sizeof (void *));
+      return stats;
+    }
+
     void
     NNPT::Print (std::ostream &os) const
     {
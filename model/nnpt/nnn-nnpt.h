@@ -38,6 +38,7 @@
 
 #include "nnn-nnpt-entry.h"
 #include "../nnn-naming.h"
+#include "../../utils/nnn-table-stats.h"
 
 using boost::multi_index_container;
 using namespace ::boost::multi_index;
@@ -158,7 +159,16 @@ namespace ns3
       void
       printByLease ();
 
+      /**
+       * @brief Usage counters of the table, read without walking it
+       */
+      TableStats
+      GetStats () const;
+
       pair_set container;
+
+    private:
+      TableStats m_stats;
     };
 
     std::ostream& operator<< (std::ostream& os, const NNPT &nnpt);
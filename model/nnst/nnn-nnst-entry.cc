@@ -40,6 +40,8 @@ namespace ll = boost::lambda;
 
 #include "../nnn-naming.h"
 
+#include "../../utils/nnn-fast-path.h"
+
 namespace ns3
 {
   NS_LOG_COMPONENT_DEFINE ("nnn.nnst.entry");
@@ -30,6 +30,8 @@ namespace ll = boost::lambda;
 #include "nnn-nnst.h"
 #include "nnn-nnst-entry.h"
 
+#include "../../utils/nnn-fast-path.h"
+
 namespace ns3
 {
   NS_LOG_COMPONENT_DEFINE ("nnn.nnst");
@@ -66,10 +68,14 @@ namespace ns3
 	  // We don't have a longest prefix with with the given address, attempt to order by distance
 	  Ptr<nnst::Entry> curr;
 	  Ptr<nnst::Entry> closest = Begin ();
+	  int closestDistance = (closest != 0) ? closest->GetAddressPtr ()->distance (prefix) : 0;
+	  m_stats.Lookup (false, GetSize ());
 	  for (curr = Begin(); curr != End (); curr = Next(curr))
 	    {
-	      if (curr->GetAddressPtr ()->distance(prefix) < closest->GetAddressPtr ()->distance (prefix))
+	      int currDistance = curr->GetAddressPtr ()->distance(prefix);
+	      if (currDistance < closestDistance)
 		{
+		  closestDistance = currDistance;
                   NS_LOG_INFO ("Found (" << *curr->GetAddressPtr () << ") to be closer to (" << prefix << ")");
 		  closest = curr;
 		}
@@ -80,6 +86,7 @@ namespace ns3
       else
 	{
 	  Ptr<nnst::Entry> tmp = item->payload ();
+	  m_stats.Lookup (true, prefix.size ());
 	  NS_LOG_INFO ("Returning the longest prefix (" << *tmp->GetAddressPtr () << ")");
 	  return tmp;
 	}
@@ -138,6 +145,7 @@ namespace ns3
 	    }
 	}
 
+      m_stats.Lookup (!ret.empty (), GetSize ());
       return ret;
     }
 
@@ -164,6 +172,7 @@ namespace ns3
 	    }
 	}
 
+      m_stats.Lookup (!ret.empty (), GetSize ());
       return ret;
     }
 
@@ -190,6 +199,7 @@ namespace ns3
 	    }
 	}
 
+      m_stats.Lookup (!ret.empty (), GetSize ());
       return ret;
     }
 
@@ -216,6 +226,7 @@ namespace ns3
 	    }
 	}
 
+      m_stats.Lookup (!ret.empty (), GetSize ());
       return ret;
     }
 
@@ -242,6 +253,7 @@ namespace ns3
 	    }
 	}
 
+      m_stats.Lookup (!ret.empty (), GetSize ());
       return ret;
     }
 
@@ -268,6 +280,7 @@ namespace ns3
 	    }
 	}
 
+      m_stats.Lookup (!ret.empty (), GetSize ());
       return ret;
     }
 
@@ -283,6 +296,7 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this << prefix);
       super::iterator item = super::find_exact (prefix);
+      m_stats.Lookup (item != super::end (), prefix.size ());
 
       if (item == super::end ())
 	return 0;
@@ -396,7 +410,10 @@ namespace ns3
       super::iterator item = super::find_exact (prefix);
 
       if (item != super::end ())
-	super::modify (&(*item), ll::bind (&nnst::Entry::UpdateStatus, ll::_1, face, status));
+	{
+	  super::modify (&(*item), ll::bind (&nnst::Entry::UpdateStatus, ll::_1, face, status));
+	  NotifyDidAdd (item->payload ());
+	}
     }
 
     void
@@ -433,7 +450,10 @@ namespace ns3
       super::iterator item = super::find_exact (prefix);
 
       if (item != super::end ())
+	{
 	  super::modify (&(*item), ll::bind (&nnst::Entry::AddOrUpdateRoutingMetric, ll::_1, face, metric));
+	  NotifyDidAdd (item->payload ());
+	}
     }
 
     void
@@ -443,7 +463,11 @@ namespace ns3
       super::iterator item = super::find_exact (prefix);
 
       if (item != super::end ())
-	super::modify (&(*item), ll::bind (&nnst::Entry::UpdateFaceRtt, ll::_1, face, sample));
+	{
+	  // The RTT takes part in the ranking of the faces
+	  super::modify (&(*item), ll::bind (&nnst::Entry::UpdateFaceRtt, ll::_1, face, sample));
+	  NotifyDidAdd (item->payload ());
+	}
     }
 
 
@@ -452,6 +476,7 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this);
 
+      Ptr<nnst::Entry> last;
       super::parent_trie::recursive_iterator item (super::getTrie ());
       super::parent_trie::recursive_iterator end (0);
       for (; item != end; item++)
@@ -460,7 +485,12 @@ namespace ns3
 
 	  super::modify (&(*item),
 	                 ll::bind (&nnst::Entry::Invalidate, ll::_1));
+	  last = item->payload ();
 	}
+
+      // One notification drops every cached next hop
+      if (last != 0)
+	NotifyDidAdd (last);
     }
 
     void
@@ -472,10 +502,10 @@ namespace ns3
       if (nnstEntry != super::end ())
 	{
 	  // notify forwarding strategy about soon be removed entry
-	  //NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
-	  //this->GetObject<ForwardingStrategy> ()->WillRemoveNNSTEntry (nnstEntry->payload ());
+	  NotifyWillRemove (nnstEntry->payload ());
 
 	  super::erase (nnstEntry);
+	  m_stats.m_erases++;
 	}
     }
 
@@ -492,15 +522,16 @@ namespace ns3
 	    {
 	      Ptr<nnst::Entry> nextEntry = Next (entry);
 
-	      // notify forwarding strategy about soon be removed FIB entry
-	      //NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
-	      //this->GetObject<ForwardingStrategy> ()->WillRemoveNNSTEntry (entry);
+	      // notify forwarding strategy about soon be removed NNST entry
+	      NotifyWillRemove (entry);
 
 	      super::erase (StaticCast<nnst::Entry> (entry)->to_iterator ());
+	      m_stats.m_erases++;
 	      entry = nextEntry;
 	    }
 	  else
 	    {
+	      NotifyDidAdd (entry);
 	      entry = Next (entry);
 	    }
 	}
@@ -520,14 +551,15 @@ namespace ns3
 	      Ptr<nnst::Entry> nextEntry = Next (entry);
 
 	      // notify forwarding strategy about soon be removed NNST entry
-	      //NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
-	      //this->GetObject<ForwardingStrategy> ()->WillRemoveNNSTEntry (entry);
+	      NotifyWillRemove (entry);
 
 	      super::erase (entry->to_iterator ());
+	      m_stats.m_erases++;
 	      entry = nextEntry;
 	    }
 	  else
 	    {
+	      NotifyDidAdd (entry);
 	      entry = Next (entry);
 	    }
 	}
@@ -605,6 +637,16 @@ namespace ns3
       return super::getPolicy ().size ();
     }
 
+    TableStats
+    NNST::GetStats () const
+    {
+      TableStats stats = m_stats;
+      stats.m_entries = super::getPolicy ().size ();
+      stats.m_nodes = super::getTrie ().node_count ();
+      stats.m_bytes = stats.m_entries * sizeof (nnst::Entry) + stats.m_nodes * sizeof (super::parent_trie);
+      return stats;
+    }
+
     Ptr<const nnst::Entry>
     NNST::Begin () const
     {
@@ -700,6 +742,7 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this << prefix);
       super::iterator item = super::find_exact (prefix);
+      m_stats.Lookup (item != super::end (), prefix.size ());
 
       if (item == super::end ())
 	return false;
@@ -712,6 +755,7 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this << prefix);
       super::iterator item = super::find_exact (prefix);
+      m_stats.Lookup (item != super::end (), prefix.size ());
 
       if (item == super::end ())
 	return std::vector<Address> ();
@@ -743,6 +787,7 @@ namespace ns3
 	{
 	  if (result.second)
 	    {
+	      m_stats.m_inserts++;
 	      Ptr<nnst::Entry> newEntry = Create<nnst::Entry> (this, name);
 
 	      newEntry->AddPoA(face, poa, lease_expire, metric);
@@ -753,19 +798,15 @@ namespace ns3
 	  super::modify (result.first,
 	                 ll::bind (&nnst::Entry::AddOrUpdateRoutingMetric, ll::_1, face, metric));
 
-//	  if (result.second)
-//	    {
-//	      // notify forwarding strategy about new NNST entry
-//	      NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
-//	      this->GetObject<ForwardingStrategy> ()->DidAddNNSTEntry (result.first->payload ());
-//	    }
-
 	  // If this is a new entry, then the PoA has not been added
 	  if (!result.second)
 	    {
 	      result.first->payload()->AddPoA(face, poa, lease_expire, metric);
 	    }
 
+	  // notify forwarding strategy about new or modified NNST entry
+	  NotifyDidAdd (result.first->payload ());
+
 	  return result.first->payload ();
 	}
       else
@@ -801,7 +842,30 @@ namespace ns3
       item->cleanExpired ();
 
       if (item->isEmpty ())
-	Remove (name);
+	{
+	  m_stats.m_expired++;
+	  Remove (name);
+	}
+      else
+	NotifyDidAdd (item);
+    }
+
+    void
+    NNST::NotifyDidAdd (Ptr<nnst::Entry> entry)
+    {
+      // Tables that are not aggregated to a node, like the awaiting response
+      // NNST in the forwarding strategy, have nobody to notify
+      Ptr<ForwardingStrategy> fw = this->GetObject<ForwardingStrategy> ();
+      if (fw != 0)
+	fw->DidAddNNSTEntry (entry);
+    }
+
+    void
+    NNST::NotifyWillRemove (Ptr<nnst::Entry> entry)
+    {
+      Ptr<ForwardingStrategy> fw = this->GetObject<ForwardingStrategy> ();
+      if (fw != 0)
+	fw->WillRemoveNNSTEntry (entry);
     }
 
     std::ostream&
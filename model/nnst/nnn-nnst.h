@@ -49,6 +49,7 @@ using namespace ::boost::multi_index;
 #include "../../utils/trie/trie.h"
 #include "../../utils/trie/counting-policy.h"
 #include "../../utils/trie/trie-with-policy.h"
+#include "../../utils/nnn-table-stats.h"
 
 namespace ns3
 {
@@ -217,6 +218,12 @@ namespace ns3
       uint32_t
       GetSize ();
 
+      /**
+       * @brief Usage counters of the table, read without walking it
+       */
+      TableStats
+      GetStats () const;
+
       Ptr<NNST>
       GetNNST (Ptr<Object> node);
 
@@ -247,6 +254,20 @@ namespace ns3
 
       void
       cleanExpired(Ptr<nnst::Entry> item);
+
+      /**
+       * @brief Tell the aggregated forwarding strategy, if any, that an entry was added or modified
+       */
+      void
+      NotifyDidAdd (Ptr<nnst::Entry> entry);
+
+      /**
+       * @brief Tell the aggregated forwarding strategy, if any, that an entry will be removed
+       */
+      void
+      NotifyWillRemove (Ptr<nnst::Entry> entry);
+
+      TableStats m_stats;
     };
 
     std::ostream& operator<< (std::ostream& os, const NNST &nnst);
@@ -88,14 +88,18 @@ namespace ns3
     DO::SetName (Ptr<NNNAddress> name)
     {
       m_name = name;
-      SetWire(0);
+      // Names of the same serialized size are rewritten in the cached wire
+      if (m_wire != 0)
+	m_wirePatch |= WIRE_PATCH_DST;
     }
 
     void
     DO::SetName (const NNNAddress &name)
     {
       m_name = Create<NNNAddress> (name);
-      SetWire(0);
+      // Names of the same serialized size are rewritten in the cached wire
+      if (m_wire != 0)
+	m_wirePatch |= WIRE_PATCH_DST;
     }
 
     void
@@ -119,14 +119,18 @@ namespace ns3
     DU::SetDstName (Ptr<NNNAddress> dst)
     {
       m_dst = dst;
-      SetWire(0);
+      // Names of the same serialized size are rewritten in the cached wire
+      if (m_wire != 0)
+	m_wirePatch |= WIRE_PATCH_DST;
     }
 
     void
     DU::SetDstName (const NNNAddress &dst)
     {
       m_dst = Create<NNNAddress> (dst);
-      SetWire(0);
+      // Names of the same serialized size are rewritten in the cached wire
+      if (m_wire != 0)
+	m_wirePatch |= WIRE_PATCH_DST;
     }
 
     void
@@ -27,6 +27,7 @@ namespace ns3
   namespace nnn
   {
     NNNPDU::NNNPDU ()
+    : m_wirePatch   (0)
     {
     }
 
@@ -35,6 +36,7 @@ namespace ns3
     , m_ttl         (ttl)
     , m_version     (A_NNN)
     , m_wire        (0)
+    , m_wirePatch   (0)
     {
     }
 
@@ -43,6 +45,7 @@ namespace ns3
     , m_ttl         (ttl)
     , m_version     (ver)
     , m_wire        (0)
+    , m_wirePatch   (0)
     {
     }
 
@@ -50,6 +50,14 @@ namespace ns3
     class NNNPDU : public SimpleRefCount<NNNPDU>
     {
     public:
+      /**
+       * @brief Fields changed since the wire formatted packet was cached
+       */
+      enum WirePatch
+      {
+	WIRE_PATCH_LIFETIME = 0x01,   ///< @brief Lifetime
+	WIRE_PATCH_DST      = 0x02    ///< @brief Destination name of a DO or DU
+      };
 
       NNNPDU ();
 
@@ -104,7 +112,8 @@ namespace ns3
       /**
        * @brief Get wire formatted packet
        *
-       * If wire formatted packet has not been set before, 0 will be returned
+       * If wire formatted packet has not been set before, or fields have changed since,
+       * 0 will be returned
        */
       inline Ptr<const Packet>
       GetWire () const;
@@ -115,6 +124,28 @@ namespace ns3
       inline void
       SetWire (Ptr<const Packet> packet) const;
 
+      /**
+       * @brief Get the cached wire formatted packet even if fields changed after it was cached
+       *
+       * GetWirePatch tells which fields the wire layer has to rewrite
+       */
+      inline Ptr<const Packet>
+      GetStaleWire () const;
+
+      /**
+       * @brief Get the WirePatch flags of the fields changed since the wire formatted packet was cached
+       */
+      inline uint8_t
+      GetWirePatch () const;
+
+      /**
+       * @brief Cache the wire formatted packet of another PDU that only differs in the fields flagged
+       * @param packet wire formatted packet
+       * @param patch WirePatch flags of the fields that differ
+       */
+      inline void
+      SetPatchedWire (Ptr<const Packet> packet, uint8_t patch) const;
+
       virtual void
       Print (std::ostream &os) const;
 
@@ -123,6 +154,7 @@ namespace ns3
       Time m_ttl;                           ///< @brief Packet life time (TTL)
       uint16_t m_version;                   ///< @brief NNN Packet version
       mutable Ptr<const Packet> m_wire;
+      mutable uint8_t m_wirePatch;          ///< @brief WirePatch flags of the fields changed since m_wire was cached
     };
 
     inline uint32_t
@@ -153,12 +185,17 @@ namespace ns3
     NNNPDU::SetLifetime (Time ttl)
     {
       m_ttl = ttl;
-      m_wire = 0;
+      // The lifetime has a fixed position and size, keep the wire to rewrite it
+      if (m_wire != 0)
+	m_wirePatch |= WIRE_PATCH_LIFETIME;
     }
 
     inline Ptr<const Packet>
     NNNPDU::GetWire () const
     {
+      if (m_wirePatch != 0)
+	return 0;
+
       return m_wire;
     }
 
@@ -166,6 +203,26 @@ namespace ns3
     NNNPDU::SetWire (Ptr<const Packet> packet) const
     {
       m_wire = packet;
+      m_wirePatch = 0;
+    }
+
+    inline Ptr<const Packet>
+    NNNPDU::GetStaleWire () const
+    {
+      return m_wire;
+    }
+
+    inline uint8_t
+    NNNPDU::GetWirePatch () const
+    {
+      return m_wirePatch;
+    }
+
+    inline void
+    NNNPDU::SetPatchedWire (Ptr<const Packet> packet, uint8_t patch) const
+    {
+      m_wire = packet;
+      m_wirePatch = (packet != 0) ? patch : 0;
     }
   } /* namespace nnn */
 } /* namespace ns3 */
@@ -112,6 +112,9 @@ namespace ns3
 	virtual Ptr<Entry>
 	Next (Ptr<Entry>);
 
+	virtual TableStats
+	GetStats () const;
+
 	const typename super::policy_container &
 	GetPolicy () const { return super::getPolicy (); }
 
@@ -186,6 +189,16 @@ namespace ns3
 	return tid;
       }
 
+      template<class Policy>
+      TableStats
+      PitImpl<Policy>::GetStats () const
+      {
+	TableStats stats = Pit::GetStats ();
+	stats.m_nodes = super::getTrie ().node_count ();
+	stats.m_bytes = stats.m_entries * sizeof (entry) + stats.m_nodes * sizeof (typename super::parent_trie);
+	return stats;
+      }
+
       template<class Policy>
       uint32_t
       PitImpl<Policy>::GetCurrentSize () const
@@ -283,6 +296,8 @@ namespace ns3
 	      {
 		m_forwardingStrategy->WillEraseTimedOutPendingInterest (entry->to_iterator ()->payload ());
 		super::erase (entry->to_iterator ());
+		m_stats.m_expired++;
+		m_stats.m_erases++;
 		// count ++;
 	      }
 	    else
@@ -303,6 +318,7 @@ namespace ns3
       {
 	/// @todo use predicate to search with exclude filters
 	typename super::iterator item = super::longest_prefix_match_if (header.GetName (), EntryIsNotEmpty ());
+	m_stats.Lookup (item != super::end (), header.GetName ().size ());
 
 	if (item == super::end ())
 	  return 0;
@@ -321,6 +337,7 @@ namespace ns3
 	typename super::iterator foundItem, lastItem;
 	bool reachLast;
 	boost::tie (foundItem, reachLast, lastItem) = super::getTrie ().find (header.GetName ());
+	m_stats.Lookup (reachLast && lastItem != super::end () && lastItem->payload () != 0, header.GetName ().size ());
 
 	if (!reachLast || lastItem == super::end ())
 	  return 0;
@@ -333,6 +350,7 @@ namespace ns3
       PitImpl<Policy>::Find (const icn::Name &prefix)
       {
 	typename super::iterator item = super::find_exact (prefix);
+	m_stats.Lookup (item != super::end (), prefix.size ());
 
 	if (item == super::end ())
 	  return 0;
@@ -355,11 +373,15 @@ namespace ns3
 	//                " Prefix = "<< header->GetName() << ", NodeID == " << m_fib->GetObject<Node>()->GetId() << "\n" << *m_fib);
 
 	Ptr< entry > newEntry = ns3::Create< entry > (boost::ref (*this), header, fibEntry);
+	size_t before = super::getPolicy ().size ();
 	std::pair< typename super::iterator, bool > result = super::insert (header->GetName (), newEntry);
 	if (result.first != super::end ())
 	  {
 	    if (result.second)
 	      {
+		m_stats.m_inserts++;
+		// A full PIT evicts an entry to make room
+		m_stats.m_erases += before + 1 - super::getPolicy ().size ();
 		newEntry->SetTrie (result.first);
 		return newEntry;
 	      }
@@ -382,6 +404,7 @@ namespace ns3
 	if (this->m_PitEntryPruningTimout.IsZero ())
 	  {
 	    super::erase (StaticCast< entry > (item)->to_iterator ());
+	    m_stats.m_erases++;
 	  }
 	else
 	  {
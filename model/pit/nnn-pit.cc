@@ -73,5 +73,13 @@ namespace ns3
     Pit::~Pit ()
     {
     }
+
+    TableStats
+    Pit::GetStats () const
+    {
+      TableStats stats = m_stats;
+      stats.m_entries = GetSize ();
+      return stats;
+    }
   } // namespace nnn
 } // namespace ns3
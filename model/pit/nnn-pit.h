@@ -29,6 +29,8 @@
 
 #include "nnn-pit-entry.h"
 
+#include "../../utils/nnn-table-stats.h"
+
 namespace ns3
 {
   namespace nnn
@@ -162,6 +164,12 @@ namespace ns3
       virtual Ptr<pit::Entry>
       Next (Ptr<pit::Entry>) = 0;
 
+      /**
+       * @brief Usage counters of the PIT, read without walking it
+       */
+      virtual TableStats
+      GetStats () const;
+
       ////////////////////////////////////////////////////////////////////////////
       ////////////////////////////////////////////////////////////////////////////
       ////////////////////////////////////////////////////////////////////////////
@@ -189,6 +197,8 @@ namespace ns3
       Time m_PitEntryPruningTimout;
 
       Time m_maxPitEntryLifetime;
+
+      TableStats m_stats; ///< @brief Usage counters, kept by the implementations
     };
 
     ///////////////////////////////////////////////////////////////////////////////
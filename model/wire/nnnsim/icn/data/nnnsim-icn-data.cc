@@ -24,6 +24,8 @@
 
 #include "nnnsim-icn-data.h"
 
+#include "../../../../../utils/nnn-fast-path.h"
+
 namespace ns3
 {
   NS_LOG_COMPONENT_DEFINE ("nnn.wire.icnSIM.Data");
@@ -204,6 +206,152 @@ namespace ns3
 	  m_data->Print (os);
 	}
 
+	// Offset of the timestamp in the content info
+	static const uint32_t TIMESTAMP_OFFSET = 4;
+
+	/**
+	 * @brief Writes a DataTemplate with a name and a timestamp
+	 *
+	 * Deserialize reads any nnnSIM Data header back into a template of its
+	 * own, so Serialize then writes the same bytes again
+	 */
+	class DataTemplate::TemplateHeader : public Header
+	{
+	public:
+	  TemplateHeader ()
+	    : m_template (0)
+	    , m_name (0)
+	    , m_timestamp (0)
+	    , m_size (0)
+	  {
+	  }
+
+	  TemplateHeader (const DataTemplate &tmpl, const Name &name, uint32_t timestamp)
+	    : m_template (&tmpl)
+	    , m_name (&name)
+	    , m_timestamp (timestamp)
+	    , m_size (tmpl.m_head.size () + icn::wire::IcnSim::SerializedSizeName (name) + tmpl.m_tail.size ())
+	  {
+	  }
+
+	  static TypeId
+	  GetTypeId (void)
+	  {
+	    static TypeId tid = TypeId ("ns3::nnn::Data::nnnSIM::Template")
+	      .SetGroupName ("Nnn")
+	      .SetParent<Header> ()
+	      .AddConstructor<TemplateHeader> ()
+	      ;
+	    return tid;
+	  }
+
+	  virtual TypeId
+	  GetInstanceTypeId (void) const
+	  {
+	    return GetTypeId ();
+	  }
+
+	  virtual void
+	  Print (std::ostream &os) const
+	  {
+	    os << "Data template for " << GetName ();
+	  }
+
+	  virtual uint32_t
+	  GetSerializedSize (void) const
+	  {
+	    return m_size;
+	  }
+
+	  virtual void
+	  Serialize (Buffer::Iterator start) const
+	  {
+	    const std::vector<uint8_t> &head = GetTemplate ().m_head;
+	    const std::vector<uint8_t> &tail = GetTemplate ().m_tail;
+
+	    start.Write (&head[0], 2); // version and packet type
+	    start.WriteU16 (m_size - 4); // length
+	    start.Write (&head[4], head.size () - 4);
+
+	    icn::wire::IcnSim::SerializeName (start, GetName ());
+
+	    start.Write (&tail[0], TIMESTAMP_OFFSET);
+	    start.WriteU32 (m_timestamp);
+	    start.Write (&tail[TIMESTAMP_OFFSET + 4], tail.size () - TIMESTAMP_OFFSET - 4);
+	  }
+
+	  virtual uint32_t
+	  Deserialize (Buffer::Iterator start)
+	  {
+	    Data wireEncoding;
+	    m_size = wireEncoding.Deserialize (start);
+
+	    // The Data decoded is its own prototype, the bytes around the name
+	    // come out as they were read
+	    Ptr<nnn::Data> data = wireEncoding.GetData ();
+	    m_decoded = Create<DataTemplate> (data);
+	    m_decodedName = data->GetName ();
+	    m_template = 0;
+	    m_name = 0;
+	    m_timestamp = static_cast<uint32_t> (data->GetTimestamp ().ToInteger (Time::S));
+
+	    return m_size;
+	  }
+
+	private:
+	  const DataTemplate &
+	  GetTemplate () const
+	  {
+	    return (m_template != 0) ? *m_template : *m_decoded;
+	  }
+
+	  const Name &
+	  GetName () const
+	  {
+	    return (m_name != 0) ? *m_name : m_decodedName;
+	  }
+
+	  // What is serialized is only referenced, the header lives as long as the AddHeader call
+	  const DataTemplate *m_template;
+	  const Name *m_name;
+	  uint32_t m_timestamp;
+	  uint32_t m_size;
+
+	  Ptr<const DataTemplate> m_decoded;
+	  Name m_decodedName;
+	};
+
+	DataTemplate::DataTemplate (Ptr<const nnn::Data> prototype)
+	  : m_payload (prototype->GetPayload ()->Copy ())
+	{
+	  Data wireEncoding (ConstCast<nnn::Data> (prototype));
+
+	  Buffer buffer;
+	  buffer.AddAtStart (wireEncoding.GetSerializedSize ());
+	  wireEncoding.Serialize (buffer.Begin ());
+
+	  std::vector<uint8_t> bytes (buffer.GetSize ());
+	  buffer.CopyData (&bytes[0], bytes.size ());
+
+	  // Everything after the name has a fixed size
+	  uint32_t tailSize = 2 + 2 + 4 + 2 + 2 + (2 + 0);
+	  uint32_t headSize = bytes.size () - tailSize - icn::wire::IcnSim::SerializedSizeName (prototype->GetName ());
+
+	  m_head.assign (bytes.begin (), bytes.begin () + headSize);
+	  m_tail.assign (bytes.end () - tailSize, bytes.end ());
+
+	  // Registers the TypeId of the header, so it can be found by name
+	  TemplateHeader::GetTypeId ();
+	}
+
+	Ptr<Packet>
+	DataTemplate::ToWire (const Name &name, const Time &timestamp) const
+	{
+	  Ptr<Packet> packet = m_payload->Copy ();
+	  packet->AddHeader (TemplateHeader (*this, name, static_cast<uint32_t> (timestamp.ToInteger (Time::S))));
+	  return packet;
+	}
+
       } /* namespace icnSIM */
     } /* namespace wire */
   } /* namespace icn */
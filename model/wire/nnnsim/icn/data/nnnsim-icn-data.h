@@ -22,6 +22,8 @@
 
 #include "../../nnnsim-common.h"
 
+#include <vector>
+
 #ifndef NNNSIM_ICN_DATA_H_
 #define NNNSIM_ICN_DATA_H_
 
@@ -61,6 +63,33 @@ namespace ns3
 	  Ptr<nnn::Data> m_data;
 	};
 
+	/**
+	 * @brief Pre-encoded Data wire format for Data that only differs in name and timestamp
+	 *
+	 * The bytes around the name are serialized once from a prototype Data
+	 * (signature, freshness, content info) and the payload is shared by all
+	 * the packets created, so ToWire only writes the name and the timestamp.
+	 * The result decodes with Data::FromWire like any other Data.
+	 */
+	class DataTemplate : public SimpleRefCount<DataTemplate>
+	{
+	public:
+	  DataTemplate (Ptr<const nnn::Data> prototype);
+
+	  /**
+	   * @brief Encode a Data packet with the name and timestamp given and everything else from the prototype
+	   */
+	  Ptr<Packet>
+	  ToWire (const Name &name, const Time &timestamp) const;
+
+	private:
+	  class TemplateHeader;
+
+	  std::vector<uint8_t> m_head;  ///< @brief Version, type, length and signature
+	  std::vector<uint8_t> m_tail;  ///< @brief Content info, the timestamp is patched per packet
+	  Ptr<const Packet> m_payload;
+	};
+
       } /* namespace nnnSIM */
     } /* namespace wire */
   } /* namespace icn */
@@ -22,6 +22,8 @@
 
 #include "nnnsim-aen.h"
 
+#include "../../../../../utils/nnn-fast-path.h"
+
 NNN_NAMESPACE_BEGIN
 
 NS_LOG_COMPONENT_DEFINE ("nnn.wire.nnnSIM.AEN");
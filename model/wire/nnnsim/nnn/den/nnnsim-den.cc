@@ -22,6 +22,8 @@
 
 #include "nnnsim-den.h"
 
+#include "../../../../../utils/nnn-fast-path.h"
+
 NNN_NAMESPACE_BEGIN
 
 namespace wire{
@@ -22,6 +22,8 @@
 
 #include "nnnsim-do.h"
 
+#include "../../../../../utils/nnn-fast-path.h"
+
 NNN_NAMESPACE_BEGIN
 
 namespace wire {
@@ -62,6 +64,18 @@ namespace wire {
     DO::ToWire (Ptr<const nnn::DO> do_p)
     {
       Ptr<const Packet> p = do_p->GetWire ();
+      if (!p && do_p->GetWirePatch () != 0)
+	{
+	  // Rewrite only the fields that changed since the last encoding
+	  Ptr<Packet> packet = NnnSim::PatchWire (do_p->GetStaleWire (), do_p->GetWirePatch (),
+						   do_p->GetLifetime (), 0, &do_p->GetName ());
+	  if (packet)
+	    {
+	      do_p->SetWire (packet);
+	      p = packet;
+	    }
+	}
+
       if (!p)
 	{
 	  Ptr<Packet> packet = Create<Packet> (*do_p->GetPayload ());
@@ -22,6 +22,8 @@
 
 #include "nnnsim-du.h"
 
+#include "../../../../../utils/nnn-fast-path.h"
+
 NNN_NAMESPACE_BEGIN
 
 NS_LOG_COMPONENT_DEFINE ("nnn.wire.nnnSIM.DU");
@@ -63,6 +65,18 @@ namespace wire
     DU::ToWire (Ptr<const nnn::DU> du_p)
     {
       Ptr<const Packet> p = du_p->GetWire ();
+      if (!p && du_p->GetWirePatch () != 0)
+	{
+	  // Rewrite only the fields that changed since the last encoding
+	  Ptr<Packet> packet = NnnSim::PatchWire (du_p->GetStaleWire (), du_p->GetWirePatch (),
+						   du_p->GetLifetime (), 1, &du_p->GetDstName ());
+	  if (packet)
+	    {
+	      du_p->SetWire (packet);
+	      p = packet;
+	    }
+	}
+
       if (!p)
 	{
 	  Ptr<Packet> packet = Create<Packet> (*du_p->GetPayload ());
@@ -22,6 +22,8 @@
 
 #include "nnnsim-nullp.h"
 
+#include "../../../../../utils/nnn-fast-path.h"
+
 NNN_NAMESPACE_BEGIN
 
 NS_LOG_COMPONENT_DEFINE ("nnn.wire.nnnSIM.NULLp");
@@ -63,6 +65,18 @@ namespace wire
     NULLp::ToWire (Ptr<const nnn::NULLp> null_p)
     {
       Ptr<const Packet> p = null_p->GetWire ();
+      if (!p && null_p->GetWirePatch () != 0)
+	{
+	  // Rewrite only the fields that changed since the last encoding
+	  Ptr<Packet> packet = NnnSim::PatchWire (null_p->GetStaleWire (), null_p->GetWirePatch (),
+						   null_p->GetLifetime (), 0, 0);
+	  if (packet)
+	    {
+	      null_p->SetWire (packet);
+	      p = packet;
+	    }
+	}
+
       if (!p)
 	{
 	  Ptr<Packet> packet = Create<Packet> (*null_p->GetPayload ());
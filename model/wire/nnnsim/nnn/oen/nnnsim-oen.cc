@@ -22,6 +22,8 @@
 
 #include "nnnsim-oen.h"
 
+#include "../../../../../utils/nnn-fast-path.h"
+
 namespace ns3
 {
   NS_LOG_COMPONENT_DEFINE ("nnn.wire.nnnSIM.OEN");
@@ -22,6 +22,8 @@
 
 #include "nnnsim-so.h"
 
+#include "../../../../../utils/nnn-fast-path.h"
+
 NNN_NAMESPACE_BEGIN
 
 NS_LOG_COMPONENT_DEFINE ("nnn.wire.nnnSIM.SO");
@@ -46,6 +48,18 @@ namespace wire
     SO::ToWire (Ptr<const nnn::SO> so_p)
     {
       Ptr<const Packet> p = so_p->GetWire ();
+      if (!p && so_p->GetWirePatch () != 0)
+	{
+	  // Rewrite only the fields that changed since the last encoding
+	  Ptr<Packet> packet = NnnSim::PatchWire (so_p->GetStaleWire (), so_p->GetWirePatch (),
+						   so_p->GetLifetime (), 0, 0);
+	  if (packet)
+	    {
+	      so_p->SetWire (packet);
+	      p = packet;
+	    }
+	}
+
       if (!p)
 	{
 	  Ptr<Packet> packet = Create<Packet> (*so_p->GetPayload ());
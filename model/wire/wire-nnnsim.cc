@@ -22,28 +22,54 @@
  */
 
 #include "wire-nnnsim.h"
+#include "ns3/header.h"
+
+#include "../pdus/nnn/nnn-pdu.h"
+
 #include <boost/foreach.hpp>
+#include <cstring>
+#include <vector>
 
 NNN_NAMESPACE_BEGIN
 
 namespace wire
 {
+  // Names up to this size are assembled on the stack
+  static const size_t NAME_STACK_SIZE = 256;
+
   size_t
   NnnSim::SerializeName (Buffer::Iterator &i, const NNNAddress &name)
   {
-    Buffer::Iterator start = i;
+    size_t size = SerializedSizeName (name);
+
+    // Lay out the whole name first and write it to the Buffer with one call
+    uint8_t stackBuf[NAME_STACK_SIZE];
+    std::vector<uint8_t> heapBuf;
+    uint8_t *buf = stackBuf;
+    if (size > NAME_STACK_SIZE)
+      {
+	heapBuf.resize (size);
+	buf = &heapBuf[0];
+      }
 
-    i.WriteU16 (static_cast<uint16_t> (SerializedSizeName (name)-2));
+    // Same little endian order as Buffer::Iterator::WriteU16
+    size_t pos = 0;
+    buf[pos++] = static_cast<uint8_t> ((size - 2) & 0xFF);
+    buf[pos++] = static_cast<uint8_t> (((size - 2) >> 8) & 0xFF);
 
     for (NNNAddress::const_iterator item = name.begin ();
 	item != name.end ();
 	item++)
       {
-	i.WriteU16 (static_cast<uint16_t> (item->size ()));
-	i.Write (reinterpret_cast<const uint8_t*> (item->buf ()), item->size ());
+	buf[pos++] = static_cast<uint8_t> (item->size () & 0xFF);
+	buf[pos++] = static_cast<uint8_t> ((item->size () >> 8) & 0xFF);
+	std::memcpy (buf + pos, item->buf (), item->size ());
+	pos += item->size ();
       }
 
-    return i.GetDistanceFrom (start);
+    i.Write (buf, size);
+
+    return size;
   }
 
   size_t
@@ -66,19 +92,182 @@ namespace wire
     Ptr<NNNAddress> name = Create<NNNAddress> ();
 
     uint16_t nameLength = i.ReadU16 ();
-    while (nameLength > 0)
+    if (nameLength == 0)
+      return name;
+
+    // Read the whole encoded name at once and split the components in place
+    uint8_t stackBuf[NAME_STACK_SIZE];
+    std::vector<uint8_t> heapBuf;
+    uint8_t *buf = stackBuf;
+    if (nameLength > NAME_STACK_SIZE)
+      {
+	heapBuf.resize (nameLength);
+	buf = &heapBuf[0];
+      }
+    i.Read (buf, nameLength);
+
+    size_t pos = 0;
+    while (pos + 2 <= nameLength)
       {
-	uint16_t length = i.ReadU16 ();
-	nameLength = nameLength - 2 - length;
+	uint16_t length = buf[pos] | (buf[pos + 1] << 8);
+	pos += 2;
 
-	uint8_t tmp[length];
-	i.Read (tmp, length);
+	if (pos + length > nameLength)
+	  break; // Malformed name, the component does not fit
 
-	name->append (tmp, length);
+	name->append (buf + pos, length);
+	pos += length;
       }
 
     return name;
   }
+
+  // PDU id, lifetime, version, length and PDU data type
+  static const uint32_t DATA_PDU_FIXED_SIZE = 4 + 2 + 2 + 2 + 2;
+  static const uint32_t LIFETIME_OFFSET = 4;
+
+  // Buffer::Iterator writes the least significant byte first
+  static uint16_t
+  PeekU16 (const std::vector<uint8_t> &bytes, uint32_t offset)
+  {
+    return bytes[offset] | (bytes[offset + 1] << 8);
+  }
+
+  /**
+   * @brief Start of a cached data PDU with the lifetime and destination name rewritten
+   */
+  class PatchHeader : public Header
+  {
+  public:
+    PatchHeader ()
+      : m_bytes (DATA_PDU_FIXED_SIZE + 2)
+      , m_patch (0)
+      , m_lifetime (0)
+      , m_dstOffset (0)
+      , m_dst (0)
+    {
+    }
+
+    PatchHeader (const std::vector<uint8_t> &bytes, uint8_t patch, uint16_t lifetime,
+		 uint32_t dstOffset, const NNNAddress *dst)
+      : m_bytes (bytes)
+      , m_patch (patch)
+      , m_lifetime (lifetime)
+      , m_dstOffset (dstOffset)
+      , m_dst (dst)
+    {
+    }
+
+    static TypeId
+    GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::PatchHeader::nnnSIM")
+	.SetGroupName ("Nnn")
+	.SetParent<Header> ()
+	.AddConstructor<PatchHeader> ()
+	;
+      return tid;
+    }
+
+    virtual TypeId
+    GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+
+    virtual void
+    Print (std::ostream &os) const
+    {
+      os << "Patched nnnSIM header";
+    }
+
+    virtual uint32_t
+    GetSerializedSize (void) const
+    {
+      return m_bytes.size ();
+    }
+
+    virtual void
+    Serialize (Buffer::Iterator start) const
+    {
+      start.Write (&m_bytes[0], LIFETIME_OFFSET);
+
+      if (m_patch & NNNPDU::WIRE_PATCH_LIFETIME)
+	start.WriteU16 (m_lifetime);
+      else
+	start.Write (&m_bytes[LIFETIME_OFFSET], 2);
+
+      if (m_patch & NNNPDU::WIRE_PATCH_DST)
+	{
+	  start.Write (&m_bytes[LIFETIME_OFFSET + 2], m_dstOffset - LIFETIME_OFFSET - 2);
+	  NnnSim::SerializeName (start, *m_dst);
+	}
+      else
+	start.Write (&m_bytes[LIFETIME_OFFSET + 2], m_bytes.size () - LIFETIME_OFFSET - 2);
+    }
+
+    virtual uint32_t
+    Deserialize (Buffer::Iterator start)
+    {
+      // The bytes read are written back as they are, nothing is patched
+      start.Read (&m_bytes[0], m_bytes.size ());
+      m_patch = 0;
+      m_dst = 0;
+      return m_bytes.size ();
+    }
+
+  private:
+    std::vector<uint8_t> m_bytes;
+    uint8_t m_patch;
+    uint16_t m_lifetime;
+    uint32_t m_dstOffset;
+    const NNNAddress *m_dst;
+  };
+
+  Ptr<Packet>
+  NnnSim::PatchWire (Ptr<const Packet> wire, uint8_t patch, const Time &lifetime,
+		     uint32_t namesBeforeDst, const NNNAddress *dst)
+  {
+    uint32_t prefix = DATA_PDU_FIXED_SIZE;
+    uint32_t dstOffset = 0;
+
+    std::vector<uint8_t> bytes (prefix + 2);
+    if (!wire || wire->GetSize () < bytes.size ())
+      return 0;
+
+    if (patch & NNNPDU::WIRE_PATCH_DST)
+      {
+	NS_ASSERT (dst != 0);
+
+	// Walk the names in front of the destination using their length fields
+	dstOffset = prefix;
+	for (uint32_t n = 0; n <= namesBeforeDst; n++)
+	  {
+	    bytes.resize (dstOffset + 2);
+	    if (wire->CopyData (&bytes[0], bytes.size ()) != bytes.size ())
+	      return 0;
+
+	    if (n < namesBeforeDst)
+	      dstOffset += 2 + PeekU16 (bytes, dstOffset);
+	  }
+
+	uint32_t cachedSize = 2 + PeekU16 (bytes, dstOffset);
+	if (cachedSize != SerializedSizeName (*dst))
+	  return 0;
+
+	prefix = dstOffset + cachedSize;
+      }
+
+    bytes.resize (prefix);
+    if (wire->CopyData (&bytes[0], prefix) != prefix)
+      return 0;
+
+    Ptr<Packet> packet = wire->Copy ();
+    packet->RemoveAtStart (prefix);
+    packet->AddHeader (PatchHeader (bytes, patch, static_cast<uint16_t> (lifetime.ToInteger (Time::S)),
+				    dstOffset, dst));
+    return packet;
+  }
 }
 
 NNN_NAMESPACE_END
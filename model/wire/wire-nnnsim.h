@@ -27,6 +27,7 @@
 #include "ns3/ptr.h"
 #include "ns3/nstime.h"
 #include "ns3/buffer.h"
+#include "ns3/packet.h"
 
 #include "../nnn-common.h"
 #include "../nnn-naming.h"
@@ -66,6 +67,24 @@ namespace wire {
      */
     static Ptr<NNNAddress>
     DeserializeName (Buffer::Iterator &start);
+
+    /**
+     * @brief Rewrite the changed fields of a cached nnnSIM encoding of a data PDU
+     *
+     * Only the bytes up to the end of the destination name are written again,
+     * the rest of the cached packet (payload included) is shared.
+     *
+     * @param wire cached encoding (NULLp, SO, DO or DU)
+     * @param patch NNNPDU::WirePatch flags of the fields to rewrite
+     * @param lifetime new lifetime
+     * @param namesBeforeDst number of names serialized before the destination name (0 for DO, 1 for DU)
+     * @param dst new destination name, used with NNNPDU::WIRE_PATCH_DST
+     *
+     * @returns 0 if the new destination name does not have the serialized size of the cached one
+     */
+    static Ptr<Packet>
+    PatchWire (Ptr<const Packet> wire, uint8_t patch, const Time &lifetime,
+	       uint32_t namesBeforeDst, const NNNAddress *dst);
   }; // NnnSim
 
 } // wire
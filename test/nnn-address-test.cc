@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-address-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-address-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-address-test.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/test.h"
+#include "ns3/buffer.h"
+
+#include "ns3/nnn-naming.h"
+#include "ns3/nnn-nnnsim-wire.h"
+
+using namespace ns3;
+using namespace ns3::nnn;
+
+class AddressDistanceTest : public TestCase
+{
+public:
+  AddressDistanceTest ()
+  : TestCase ("NNNAddress distance between siblings, parents, children and disjoint names")
+  {
+  }
+
+private:
+  void
+  CheckDistance (const char *a, const char *b, int expected)
+  {
+    NNNAddress first (a);
+    NNNAddress second (b);
+
+    NS_TEST_ASSERT_MSG_EQ (first.distance (second), expected, "distance from " << a << " to " << b);
+    NS_TEST_ASSERT_MSG_EQ (second.distance (first), expected, "distance from " << b << " to " << a);
+  }
+
+  virtual void
+  DoRun ()
+  {
+    CheckDistance ("1.2.3", "1.2.3", 0);
+    // Siblings
+    CheckDistance ("1.2.3", "1.2.4", 2);
+    CheckDistance ("1", "2", 1);
+    // Parent and child
+    CheckDistance ("1.2", "1.2.3", 1);
+    CheckDistance ("1", "1.2.3", 2);
+    CheckDistance ("1.2", "1.2.3.4.5", 3);
+    // Disjoint
+    CheckDistance ("1.2.3", "4.5.6", 5);
+    CheckDistance ("1.2.3", "1.4.5", 4);
+    CheckDistance ("1", "4.5.6", 3);
+
+    NS_TEST_ASSERT_MSG_EQ (NNNAddress ().distance (NNNAddress ()), 0, "distance between empty names");
+  }
+};
+
+class AddressSectorTest : public TestCase
+{
+public:
+  AddressSectorTest ()
+  : TestCase ("NNNAddress sector predicates and label comparison")
+  {
+  }
+
+private:
+  virtual void
+  DoRun ()
+  {
+    NNNAddress empty;
+    NNNAddress parent ("1.2");
+    NNNAddress child ("1.2.3");
+    NNNAddress sibling ("1.2.4");
+    NNNAddress disjoint ("4.5.6");
+
+    NS_TEST_ASSERT_MSG_EQ (child.isSameSector (sibling), true, "siblings share a sector");
+    NS_TEST_ASSERT_MSG_EQ (child.isSameSector (parent), false, "child and parent");
+    NS_TEST_ASSERT_MSG_EQ (child.isSameSector (disjoint), false, "disjoint names");
+    NS_TEST_ASSERT_MSG_EQ (empty.isSameSector (empty), true, "empty names");
+    NS_TEST_ASSERT_MSG_EQ (empty.isSameSector (NNNAddress ("1")), true, "empty and top level names");
+
+    NS_TEST_ASSERT_MSG_EQ (child.isSubSector (parent), true, "child below parent");
+    NS_TEST_ASSERT_MSG_EQ (child.isSubSector (child), true, "name below itself");
+    NS_TEST_ASSERT_MSG_EQ (parent.isSubSector (child), false, "parent below child");
+    NS_TEST_ASSERT_MSG_EQ (child.isSubSector (sibling), false, "siblings");
+    NS_TEST_ASSERT_MSG_EQ (child.isSubSector (disjoint), false, "disjoint names");
+    NS_TEST_ASSERT_MSG_EQ (child.isSubSector (empty), true, "every name is below the empty name");
+
+    NS_TEST_ASSERT_MSG_EQ (parent.isParentSector (child), true, "parent above child");
+    NS_TEST_ASSERT_MSG_EQ (child.isParentSector (child), false, "name above itself");
+    NS_TEST_ASSERT_MSG_EQ (child.isParentSector (parent), false, "child above parent");
+    NS_TEST_ASSERT_MSG_EQ (child.isParentSector (sibling), false, "siblings");
+    NS_TEST_ASSERT_MSG_EQ (parent.isParentSector (disjoint), false, "disjoint names");
+    NS_TEST_ASSERT_MSG_EQ (empty.isParentSector (child), true, "the empty name is above every name");
+
+    NS_TEST_ASSERT_MSG_EQ (child.compareLabels (child), 0, "same labels");
+    NS_TEST_ASSERT_MSG_EQ (child.compareLabels (sibling), -1, "smaller last label");
+    NS_TEST_ASSERT_MSG_EQ (sibling.compareLabels (child), 1, "larger last label");
+    NS_TEST_ASSERT_MSG_EQ (empty.compareLabels (child), -1, "empty name first");
+    NS_TEST_ASSERT_MSG_EQ (child.compareLabels (empty), 1, "empty name first");
+
+    // Differences inside and after the blocks of four labels
+    uint64_t a[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    uint64_t b[] = { 1, 2, 3, 4, 5, 6, 0, 8, 9 };
+    NS_TEST_ASSERT_MSG_EQ (NNNAddress::mismatchLabels (a, b, 9), 6, "mismatch in the second block");
+    NS_TEST_ASSERT_MSG_EQ (NNNAddress::mismatchLabels (a, b, 6), 6, "no mismatch in the prefix");
+    NS_TEST_ASSERT_MSG_EQ (NNNAddress::mismatchLabels (a, a, 9), 9, "no mismatch");
+    b[8] = 0;
+    b[6] = 7;
+    NS_TEST_ASSERT_MSG_EQ (NNNAddress::mismatchLabels (a, b, 9), 8, "mismatch after the last block");
+    NS_TEST_ASSERT_MSG_EQ (NNNAddress::mismatchLabels (a, b, 0), 0, "nothing to compare");
+  }
+};
+
+class AddressWireTest : public TestCase
+{
+public:
+  AddressWireTest ()
+  : TestCase ("NNNAddress wire encoding round trip and malformed component lengths")
+  {
+  }
+
+private:
+  void
+  CheckRoundTrip (const NNNAddress &name)
+  {
+    uint32_t size = wire::NnnSim::SerializedSizeName (name);
+
+    Buffer buffer;
+    buffer.AddAtStart (size);
+    Buffer::Iterator i = buffer.Begin ();
+    wire::NnnSim::SerializeName (i, name);
+    NS_TEST_ASSERT_MSG_EQ (i.GetDistanceFrom (buffer.Begin ()), size, "bytes written for " << name);
+
+    Buffer::Iterator j = buffer.Begin ();
+    Ptr<NNNAddress> back = wire::NnnSim::DeserializeName (j);
+    NS_TEST_ASSERT_MSG_EQ (j.GetDistanceFrom (buffer.Begin ()), size, "bytes read for " << name);
+    NS_TEST_ASSERT_MSG_EQ (*back, name, "name read back");
+  }
+
+  virtual void
+  DoRun ()
+  {
+    CheckRoundTrip (NNNAddress ());
+    CheckRoundTrip (NNNAddress ("1"));
+    CheckRoundTrip (NNNAddress ("1.2.3"));
+    CheckRoundTrip (NNNAddress ("a1.ff.10.123.4567.89ab.cdef.1.2.3.4.5.6.7.8.9"));
+
+    // One good component, then a component longer than what is left of the name
+    Buffer buffer;
+    buffer.AddAtStart (2 + 2 + 1 + 2 + 1);
+    Buffer::Iterator w = buffer.Begin ();
+    w.WriteU16 (2 + 1 + 2 + 1);
+    w.WriteU16 (1);
+    w.WriteU8 (0x1);
+    w.WriteU16 (9);
+    w.WriteU8 (0x2);
+
+    Buffer::Iterator r = buffer.Begin ();
+    Ptr<NNNAddress> name = wire::NnnSim::DeserializeName (r);
+    NS_TEST_ASSERT_MSG_EQ (name->size (), 1, "malformed component is dropped");
+    NS_TEST_ASSERT_MSG_EQ (r.GetDistanceFrom (buffer.Begin ()), buffer.GetSize (),
+			   "the whole name length is consumed");
+  }
+};
+
+class AddressTestSuite : public TestSuite
+{
+public:
+  AddressTestSuite ()
+  : TestSuite ("nnnsim-address", UNIT)
+  {
+    AddTestCase (new AddressDistanceTest, TestCase::QUICK);
+    AddTestCase (new AddressSectorTest, TestCase::QUICK);
+    AddTestCase (new AddressWireTest, TestCase::QUICK);
+  }
+};
+
+static AddressTestSuite g_addressTestSuite;
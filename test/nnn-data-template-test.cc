@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-data-template-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-data-template-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-data-template-test.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/test.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+#include "ns3/nnn-icn-pdus.h"
+#include "ns3/nnn-naming.h"
+#include "ns3/nnn-nnnsim-icn-wire.h"
+
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::nnn;
+
+static std::vector<uint8_t>
+GetBytes (Ptr<const Packet> packet)
+{
+  std::vector<uint8_t> bytes (packet->GetSize ());
+  packet->CopyData (&bytes[0], bytes.size ());
+  return bytes;
+}
+
+static Ptr<nnn::Data>
+MakeData (const std::string &name, const Time &timestamp)
+{
+  Ptr<nnn::Data> data = Create<nnn::Data> (Create<Packet> (16));
+  data->SetName (Create<icn::Name> (name));
+  data->SetFreshness (Seconds (2));
+  data->SetTimestamp (timestamp);
+  data->SetSignature (0);
+  return data;
+}
+
+class DataTemplateBytesTest : public TestCase
+{
+public:
+  DataTemplateBytesTest ()
+  : TestCase ("DataTemplate writes the same bytes as Data::Serialize")
+  {
+  }
+
+private:
+  virtual void
+  DoRun ()
+  {
+    icn::wire::icnSIM::DataTemplate tmpl (MakeData ("/prototype", Seconds (0)));
+
+    // Names longer and shorter than the one of the prototype
+    const char *names[] = { "/a", "/prefix/of/some/length/0", "/x/yy/zzz" };
+    for (uint32_t n = 0; n < sizeof (names) / sizeof (names[0]); n++)
+      {
+	icn::Name name (names[n]);
+	Ptr<Packet> templated = tmpl.ToWire (name, Seconds (5));
+	Ptr<Packet> encoded = icn::wire::icnSIM::Data::ToWire (MakeData (names[n], Seconds (5)));
+
+	NS_TEST_ASSERT_MSG_EQ ((GetBytes (templated) == GetBytes (encoded)), true,
+			       "Template bytes differ from Data::Serialize for " << names[n]);
+      }
+  }
+};
+
+class DataTemplateHeaderTest : public TestCase
+{
+public:
+  DataTemplateHeaderTest ()
+  : TestCase ("Template and patch headers are created by TypeId and read back what they wrote")
+  {
+  }
+
+private:
+  void
+  CheckRoundTrip (const std::string &typeName, Ptr<const Packet> wire)
+  {
+    TypeId tid;
+    NS_TEST_ASSERT_MSG_EQ (TypeId::LookupByNameFailSafe (typeName, &tid), true, typeName << " is registered");
+    NS_TEST_ASSERT_MSG_EQ (tid.HasConstructor (), true, typeName << " has a constructor");
+
+    Header *header = dynamic_cast<Header *> (tid.GetConstructor () ());
+    NS_TEST_ASSERT_MSG_NE (header, 0, typeName << " creates a Header");
+
+    Ptr<Packet> packet = wire->Copy ();
+    uint32_t read = packet->RemoveHeader (*header);
+    NS_TEST_ASSERT_MSG_EQ (read, header->GetSerializedSize (), typeName << " size after Deserialize");
+
+    packet->AddHeader (*header);
+    NS_TEST_ASSERT_MSG_EQ ((GetBytes (packet) == GetBytes (wire)), true,
+			   typeName << " writes back the bytes it read");
+    delete header;
+  }
+
+  virtual void
+  DoRun ()
+  {
+    icn::wire::icnSIM::DataTemplate tmpl (MakeData ("/prototype", Seconds (0)));
+    Ptr<Packet> wire = tmpl.ToWire (icn::Name ("/some/data/name"), Seconds (7));
+
+    CheckRoundTrip ("ns3::nnn::Data::nnnSIM::Template", wire);
+    CheckRoundTrip ("ns3::nnn::PatchHeader::nnnSIM", wire);
+
+    // What the template header read is a complete Data
+    Ptr<nnn::Data> data = icn::wire::icnSIM::Data::FromWire (wire->Copy ());
+    NS_TEST_ASSERT_MSG_EQ (data->GetName (), icn::Name ("/some/data/name"), "Name read back");
+    NS_TEST_ASSERT_MSG_EQ (data->GetTimestamp (), Seconds (7), "Timestamp read back");
+    NS_TEST_ASSERT_MSG_EQ (data->GetPayload ()->GetSize (), 16, "Payload left after the header");
+  }
+};
+
+class DataTemplateTestSuite : public TestSuite
+{
+public:
+  DataTemplateTestSuite ()
+  : TestSuite ("nnnsim-data-template", UNIT)
+  {
+    AddTestCase (new DataTemplateBytesTest, TestCase::QUICK);
+    AddTestCase (new DataTemplateHeaderTest, TestCase::QUICK);
+  }
+};
+
+static DataTemplateTestSuite g_dataTemplateTestSuite;
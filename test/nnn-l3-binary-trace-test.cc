@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-l3-binary-trace-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-l3-binary-trace-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-l3-binary-trace-test.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/test.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+
+#include "ns3/nnn-face.h"
+#include "ns3/nnn-l3-binary-trace.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+using namespace ns3::nnn;
+
+// Face whose description is given by the test
+class DescribedFace : public Face
+{
+public:
+  DescribedFace (Ptr<Node> node, const std::string &description)
+  : Face (node)
+  , m_description (description)
+  {
+  }
+
+  virtual std::ostream&
+  Print (std::ostream &os) const
+  {
+    os << m_description;
+    return os;
+  }
+
+private:
+  std::string m_description;
+};
+
+static const char *g_header = "Time\tNode\tFaceId\tFaceDescr\tType\tPackets\tKilobytes";
+
+class L3BinaryTraceRoundTripTest : public TestCase
+{
+public:
+  L3BinaryTraceRoundTripTest ()
+  : TestCase ("Binary L3 trace converts back to the TSV of the text mode")
+  {
+  }
+
+private:
+  virtual void
+  DoRun ()
+  {
+    Ptr<Node> first = CreateObject<Node> ();
+    Ptr<Node> second = CreateObject<Node> ();
+
+    // Same face id on two nodes, with different descriptions
+    Ptr<Face> a = CreateObject<DescribedFace> (first, "dev=a");
+    a->SetId (1);
+    Ptr<Face> b = CreateObject<DescribedFace> (second, "dev=b");
+    b->SetId (1);
+
+    boost::shared_ptr<std::stringstream> binary (new std::stringstream ());
+    {
+      L3BinaryTraceWriter writer (binary, g_header, 2);
+
+      writer.BeginBlock (1.5, "0");
+      double inInterests[] = { 3, 0.5 };
+      writer.AddRow (a, "InInterests", inInterests);
+      double outData[] = { 7, 1.25 };
+      writer.AddRow (Ptr<const Face> (), "OutData", outData);
+      writer.EndBlock ();
+
+      writer.BeginBlock (2.5, "1");
+      double secondInInterests[] = { 1, 0.125 };
+      writer.AddRow (b, "InInterests", secondInInterests);
+      writer.EndBlock ();
+
+      // Empty blocks are not written
+      writer.BeginBlock (3.5, "1");
+      writer.EndBlock ();
+    }
+
+    std::string expected = std::string (g_header) + "\n"
+      "1.5\t0\t1\tdev=a\tInInterests\t3\t0.5\n"
+      "1.5\t0\t-1\tall\tOutData\t7\t1.25\n"
+      "2.5\t1\t1\tdev=b\tInInterests\t1\t0.125\n";
+
+    std::istringstream is (binary->str ());
+    std::ostringstream tsv;
+    NS_TEST_ASSERT_MSG_EQ (L3BinaryTraceReader::ConvertToTsv (is, tsv), true, "Valid trace rejected");
+    NS_TEST_ASSERT_MSG_EQ (tsv.str (), expected, "TSV differs from the rows written");
+
+    // Cut in the middle of the last block
+    std::istringstream truncated (binary->str ().substr (0, binary->str ().size () - 3));
+    std::ostringstream ignored;
+    NS_TEST_ASSERT_MSG_EQ (L3BinaryTraceReader::ConvertToTsv (truncated, ignored), false, "Truncated trace accepted");
+
+    std::istringstream text (expected);
+    NS_TEST_ASSERT_MSG_EQ (L3BinaryTraceReader::ConvertToTsv (text, ignored), false, "TSV accepted as a binary trace");
+
+    Simulator::Destroy ();
+  }
+};
+
+class L3BinaryTraceTestSuite : public TestSuite
+{
+public:
+  L3BinaryTraceTestSuite ()
+  : TestSuite ("nnnsim-l3-binary-trace", UNIT)
+  {
+    AddTestCase (new L3BinaryTraceRoundTripTest, TestCase::QUICK);
+  }
+};
+
+static L3BinaryTraceTestSuite g_l3BinaryTraceTestSuite;
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-log-linear-histogram-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-log-linear-histogram-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-log-linear-histogram-test.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/test.h"
+
+#include "ns3/nnn-log-linear-histogram.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+using namespace ns3::nnn;
+
+class LogLinearHistogramBucketTest : public TestCase
+{
+public:
+  LogLinearHistogramBucketTest ()
+  : TestCase ("LogLinearHistogram buckets at 0, 1, powers of two and the largest value")
+  {
+  }
+
+private:
+  virtual void
+  DoRun ()
+  {
+    NS_TEST_ASSERT_MSG_EQ (LogLinearHistogram::BucketOf (0), 0, "bucket of 0");
+    NS_TEST_ASSERT_MSG_EQ (LogLinearHistogram::BucketOf (1), 1, "bucket of 1");
+    NS_TEST_ASSERT_MSG_EQ (LogLinearHistogram::BucketLow (1), 1, "1 has a bucket of its own");
+    NS_TEST_ASSERT_MSG_EQ (LogLinearHistogram::BucketHigh (1), 1, "1 has a bucket of its own");
+
+    for (uint32_t k = 1; k < 64; k++)
+      {
+	uint64_t power = static_cast<uint64_t> (1) << k;
+	uint32_t bucket = LogLinearHistogram::BucketOf (power);
+
+	NS_TEST_ASSERT_MSG_EQ (LogLinearHistogram::BucketLow (bucket), power, "2^" << k << " starts a bucket");
+	NS_TEST_ASSERT_MSG_EQ (LogLinearHistogram::BucketOf (power - 1), bucket - 1, "2^" << k << " - 1 in the previous bucket");
+	NS_TEST_ASSERT_MSG_EQ (LogLinearHistogram::BucketHigh (bucket - 1), power - 1, "2^" << k << " - 1 ends the previous bucket");
+      }
+
+    uint64_t largest = ~static_cast<uint64_t> (0);
+    NS_TEST_ASSERT_MSG_EQ (LogLinearHistogram::BucketOf (largest), LogLinearHistogram::BUCKETS - 1, "largest value in the last bucket");
+    NS_TEST_ASSERT_MSG_EQ (LogLinearHistogram::BucketHigh (LogLinearHistogram::BUCKETS - 1), largest, "last bucket ends at the largest value");
+
+    LogLinearHistogram histogram;
+    histogram.Add (0);
+    histogram.Add (1);
+    histogram.Add (largest);
+    NS_TEST_ASSERT_MSG_EQ (histogram.GetCount (), 3, "values added");
+    NS_TEST_ASSERT_MSG_EQ (histogram.GetMin (), 0, "smallest value");
+    NS_TEST_ASSERT_MSG_EQ (histogram.GetMax (), largest, "largest value");
+    NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (0.0), 0, "quantile of 0");
+    NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (0.5), 1, "quantile of 1");
+    NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (1.0), largest, "quantile of the largest value");
+  }
+};
+
+class LogLinearHistogramQuantileTest : public TestCase
+{
+public:
+  LogLinearHistogramQuantileTest ()
+  : TestCase ("LogLinearHistogram quantiles within one sub-bucket of the exact value")
+  {
+  }
+
+private:
+  virtual void
+  DoRun ()
+  {
+    LogLinearHistogram histogram;
+    std::vector<uint64_t> values;
+
+    // Values spread over many powers of two
+    uint64_t value = 1;
+    for (uint32_t i = 0; i < 5000; i++)
+      {
+	value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+	uint64_t sample = value >> (i % 60);
+	values.push_back (sample);
+	histogram.Add (sample);
+      }
+    std::sort (values.begin (), values.end ());
+
+    for (uint32_t percent = 0; percent <= 100; percent++)
+      {
+	double q = percent / 100.0;
+	uint64_t rank = std::min<uint64_t> (static_cast<uint64_t> (q * values.size ()), values.size () - 1);
+	uint64_t exact = values[rank];
+	uint64_t estimate = histogram.GetQuantile (q);
+	uint64_t error = (estimate > exact) ? estimate - exact : exact - estimate;
+
+	NS_TEST_ASSERT_MSG_EQ ((error <= exact / LogLinearHistogram::SUB_BUCKETS), true,
+			       "quantile " << q << " is " << estimate << ", exact " << exact);
+      }
+
+    NS_TEST_ASSERT_MSG_EQ (histogram.GetMin (), values.front (), "smallest value");
+    NS_TEST_ASSERT_MSG_EQ (histogram.GetMax (), values.back (), "largest value");
+  }
+};
+
+class LogLinearHistogramTestSuite : public TestSuite
+{
+public:
+  LogLinearHistogramTestSuite ()
+  : TestSuite ("nnnsim-log-linear-histogram", UNIT)
+  {
+    AddTestCase (new LogLinearHistogramBucketTest, TestCase::QUICK);
+    AddTestCase (new LogLinearHistogramQuantileTest, TestCase::QUICK);
+  }
+};
+
+static LogLinearHistogramTestSuite g_logLinearHistogramTestSuite;
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-name-allocator-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-name-allocator-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-name-allocator-test.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "ns3/test.h"
+
+#include "ns3/nnn-naming.h"
+#include "ns3/nnn-name-allocator.h"
+
+using namespace ns3;
+using namespace ns3::nnn;
+
+class NameAllocatorExhaustTest : public TestCase
+{
+public:
+  NameAllocatorExhaustTest ()
+  : TestCase ("NameAllocator hands out every label once and then fails")
+  {
+  }
+
+private:
+  virtual void
+  DoRun ()
+  {
+    NNNAddress sector ("1.2");
+    Ptr<NameAllocator> allocator = Create<NameAllocator> (sector, 3);
+    NS_TEST_ASSERT_MSG_EQ (allocator->GetCapacity (), 8, "3 bit labels");
+
+    for (uint64_t label = 0; label < 8; label++)
+      {
+	Ptr<NNNAddress> name = allocator->Allocate ();
+	NS_TEST_ASSERT_MSG_NE (name, 0, "label " << label << " allocated");
+	NS_TEST_ASSERT_MSG_EQ (name->getSectorName (), sector, "name under the sector");
+	NS_TEST_ASSERT_MSG_EQ (name->get (-1).toNumber (), label, "labels in increasing order");
+	NS_TEST_ASSERT_MSG_EQ (allocator->IsAllocated (label), true, "label in use");
+      }
+
+    NS_TEST_ASSERT_MSG_EQ (allocator->Allocate (), 0, "no label left");
+    NS_TEST_ASSERT_MSG_EQ (allocator->GetAllocated (), 8, "labels in use");
+    NS_TEST_ASSERT_MSG_EQ (allocator->GetOccupancy (), 1.0, "full sector");
+
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (5), true, "release");
+    Ptr<NNNAddress> again = allocator->Allocate ();
+    NS_TEST_ASSERT_MSG_NE (again, 0, "released label allocated again");
+    NS_TEST_ASSERT_MSG_EQ (again->get (-1).toNumber (), 5, "the released label");
+    NS_TEST_ASSERT_MSG_EQ (allocator->Allocate (), 0, "no label left");
+  }
+};
+
+class NameAllocatorReuseTest : public TestCase
+{
+public:
+  NameAllocatorReuseTest ()
+  : TestCase ("NameAllocator reuses released labels oldest first and rejects double releases")
+  {
+  }
+
+private:
+  virtual void
+  DoRun ()
+  {
+    NNNAddress sector ("1");
+    Ptr<NameAllocator> allocator = Create<NameAllocator> (sector, 8);
+
+    for (uint32_t i = 0; i < 10; i++)
+      {
+	allocator->Allocate ();
+      }
+
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (7), true, "release 7");
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (2), true, "release 2");
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (NNNAddress ("1.4")), true, "release 4 by name");
+
+    // Rejected releases leave the state as it was
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (2), false, "double release");
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (NNNAddress ("1.4")), false, "double release by name");
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (10), false, "label never handed out");
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (NNNAddress ("2.3")), false, "name under another sector");
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (NNNAddress ("1.3.1")), false, "name below a label");
+    NS_TEST_ASSERT_MSG_EQ (allocator->GetFreeLabels (), 3, "released labels");
+    NS_TEST_ASSERT_MSG_EQ (allocator->GetAllocated (), 7, "labels in use");
+    NS_TEST_ASSERT_MSG_EQ (allocator->GetReleases (), 3, "releases counted");
+
+    uint64_t expected[] = { 7, 2, 4, 10 };
+    for (uint32_t i = 0; i < 4; i++)
+      {
+	Ptr<NNNAddress> name = allocator->Allocate ();
+	NS_TEST_ASSERT_MSG_EQ (name->get (-1).toNumber (), expected[i], "allocation " << i);
+      }
+
+    NS_TEST_ASSERT_MSG_EQ (allocator->GetFreeLabels (), 0, "released labels reused");
+    NS_TEST_ASSERT_MSG_EQ (allocator->GetPeakAllocated (), 11, "peak");
+    NS_TEST_ASSERT_MSG_EQ (allocator->GetAllocations (), 14, "allocations counted");
+  }
+};
+
+class NameAllocatorBitmapTest : public TestCase
+{
+public:
+  NameAllocatorBitmapTest ()
+  : TestCase ("NameAllocator bitmap grows past 64 labels")
+  {
+  }
+
+private:
+  virtual void
+  DoRun ()
+  {
+    Ptr<NameAllocator> allocator = Create<NameAllocator> (NNNAddress ("a"), 16);
+
+    for (uint32_t i = 0; i < 200; i++)
+      {
+	allocator->Allocate ();
+      }
+
+    NS_TEST_ASSERT_MSG_EQ (allocator->IsAllocated (63), true, "last label of the first word");
+    NS_TEST_ASSERT_MSG_EQ (allocator->IsAllocated (64), true, "first label of the second word");
+    NS_TEST_ASSERT_MSG_EQ (allocator->IsAllocated (199), true, "last label handed out");
+    NS_TEST_ASSERT_MSG_EQ (allocator->IsAllocated (200), false, "label not handed out yet");
+
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (64), true, "release in the second word");
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (130), true, "release in the third word");
+    NS_TEST_ASSERT_MSG_EQ (allocator->IsAllocated (63), true, "neighbour in the first word kept");
+    NS_TEST_ASSERT_MSG_EQ (allocator->IsAllocated (64), false, "released");
+    NS_TEST_ASSERT_MSG_EQ (allocator->IsAllocated (65), true, "neighbour in the second word kept");
+    NS_TEST_ASSERT_MSG_EQ (allocator->IsAllocated (130), false, "released");
+    NS_TEST_ASSERT_MSG_EQ (allocator->Release (130), false, "double release in the third word");
+
+    NS_TEST_ASSERT_MSG_EQ (allocator->Allocate ()->get (-1).toNumber (), 64, "oldest release first");
+    NS_TEST_ASSERT_MSG_EQ (allocator->IsAllocated (64), true, "in use again");
+    NS_TEST_ASSERT_MSG_EQ (allocator->GetAllocated (), 199, "labels in use");
+  }
+};
+
+class NameAllocatorTestSuite : public TestSuite
+{
+public:
+  NameAllocatorTestSuite ()
+  : TestSuite ("nnnsim-name-allocator", UNIT)
+  {
+    AddTestCase (new NameAllocatorExhaustTest, TestCase::QUICK);
+    AddTestCase (new NameAllocatorReuseTest, TestCase::QUICK);
+    AddTestCase (new NameAllocatorBitmapTest, TestCase::QUICK);
+  }
+};
+
+static NameAllocatorTestSuite g_nameAllocatorTestSuite;
@@ -0,0 +1,68 @@
+/* -*- Mode: C++; c-file-style: "gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-fast-path.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-fast-path.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-fast-path.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_FAST_PATH_H_
+#define NNN_FAST_PATH_H_
+
+#include "ns3/log.h"
+
+/*
+ * Private header for the nnnSIM forwarding path (forwarding strategy, NNST,
+ * NNPT, PDU buffer and wire code). It must be the last header included by
+ * the .cc file.
+ *
+ * When nnnSIM is configured with --nnnsim-fast-path, NNNSIM_FAST_PATH is
+ * defined and the NS_LOG statements of these files are compiled out, even if
+ * ns-3 logging is enabled for the rest of the build. The statements are kept
+ * behind an if (false), as ns-3 does in optimized builds, so variables only
+ * used for logging do not produce warnings.
+ */
+#ifdef NNNSIM_FAST_PATH
+
+#undef NS_LOG
+#define NS_LOG(level, msg)				\
+  do							\
+    {							\
+      if (false)					\
+	{						\
+	  std::clog << msg;				\
+	}						\
+    }							\
+  while (false)
+
+#undef NS_LOG_FUNCTION
+#define NS_LOG_FUNCTION(parameters)			\
+  do							\
+    {							\
+      if (false)					\
+	{						\
+	  ns3::ParameterLogger (std::clog) << parameters;	\
+	}						\
+    }							\
+  while (false)
+
+#undef NS_LOG_FUNCTION_NOARGS
+#define NS_LOG_FUNCTION_NOARGS()
+
+#endif /* NNNSIM_FAST_PATH */
+
+#endif /* NNN_FAST_PATH_H_ */
@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-log-linear-histogram.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-log-linear-histogram.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-log-linear-histogram.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_LOG_LINEAR_HISTOGRAM_H_
+#define NNN_LOG_LINEAR_HISTOGRAM_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Histogram of unsigned values with buckets of bounded relative width
+     *
+     * Values below 16 get a bucket each. Above, every power of two range is
+     * split in 16 linear buckets, so a bucket is never wider than 1/16 of
+     * its lower bound, whatever the magnitude of the values. All the buckets
+     * are allocated by the constructor: adding a value does not allocate and
+     * costs a few instructions, and the memory does not grow with the number
+     * of values.
+     */
+    class LogLinearHistogram
+    {
+    public:
+      static const uint32_t SUB_BITS = 4;
+      static const uint32_t SUB_BUCKETS = 1 << SUB_BITS;
+      static const uint32_t BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+      LogLinearHistogram ()
+      : m_buckets (BUCKETS, 0)
+      {
+	Reset ();
+      }
+
+      void
+      Reset ()
+      {
+	m_buckets.assign (BUCKETS, 0);
+	m_count = 0;
+	m_sum = 0;
+	m_min = ~static_cast<uint64_t> (0);
+	m_max = 0;
+      }
+
+      void
+      Add (uint64_t value)
+      {
+	m_buckets[BucketOf (value)]++;
+	m_count++;
+	m_sum += value;
+	if (value < m_min)
+	  m_min = value;
+	if (value > m_max)
+	  m_max = value;
+      }
+
+      /**
+       * @brief Add all the values of another histogram
+       */
+      void
+      Add (const LogLinearHistogram &other)
+      {
+	for (uint32_t i = 0; i < BUCKETS; i++)
+	  {
+	    m_buckets[i] += other.m_buckets[i];
+	  }
+	m_count += other.m_count;
+	m_sum += other.m_sum;
+	if (other.m_min < m_min)
+	  m_min = other.m_min;
+	if (other.m_max > m_max)
+	  m_max = other.m_max;
+      }
+
+      uint64_t
+      GetCount () const
+      {
+	return m_count;
+      }
+
+      uint64_t
+      GetMin () const
+      {
+	return (m_count == 0) ? 0 : m_min;
+      }
+
+      uint64_t
+      GetMax () const
+      {
+	return m_max;
+      }
+
+      double
+      GetMean () const
+      {
+	return (m_count == 0) ? 0.0 : static_cast<double> (m_sum) / m_count;
+      }
+
+      /**
+       * @brief Value below which a fraction q of the values fall
+       *
+       * The middle of the bucket holding the quantile is returned, kept
+       * within the smallest and largest values added. The first and last
+       * ranks are the smallest and largest values themselves
+       */
+      uint64_t
+      GetQuantile (double q) const
+      {
+	if (m_count == 0)
+	  return 0;
+
+	uint64_t rank = static_cast<uint64_t> (q * m_count);
+	if (rank >= m_count)
+	  rank = m_count - 1;
+	if (rank == 0)
+	  return m_min;
+	if (rank == m_count - 1)
+	  return m_max;
+
+	uint64_t seen = 0;
+	for (uint32_t i = 0; i < BUCKETS; i++)
+	  {
+	    seen += m_buckets[i];
+	    if (seen > rank)
+	      {
+		uint64_t low = BucketLow (i);
+		uint64_t value = low + (BucketHigh (i) - low) / 2;
+		if (value < m_min)
+		  return m_min;
+		if (value > m_max)
+		  return m_max;
+		return value;
+	      }
+	  }
+	return m_max;
+      }
+
+      static uint32_t
+      BucketOf (uint64_t value)
+      {
+	if (value < SUB_BUCKETS)
+	  return value;
+
+	uint32_t shift = 63 - __builtin_clzll (value) - SUB_BITS;
+	return (shift + 1) * SUB_BUCKETS + (static_cast<uint32_t> (value >> shift) - SUB_BUCKETS);
+      }
+
+      static uint64_t
+      BucketLow (uint32_t bucket)
+      {
+	if (bucket < SUB_BUCKETS)
+	  return bucket;
+
+	uint32_t shift = bucket / SUB_BUCKETS - 1;
+	return static_cast<uint64_t> (SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+      }
+
+      static uint64_t
+      BucketHigh (uint32_t bucket)
+      {
+	if (bucket < SUB_BUCKETS)
+	  return bucket;
+
+	uint32_t shift = bucket / SUB_BUCKETS - 1;
+	return BucketLow (bucket) + ((static_cast<uint64_t> (1) << shift) - 1);
+      }
+
+    private:
+      std::vector<uint64_t> m_buckets;
+      uint64_t m_count;
+      uint64_t m_sum;
+      uint64_t m_min;
+      uint64_t m_max;
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_LOG_LINEAR_HISTOGRAM_H_ */
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-mapped-file.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-mapped-file.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-mapped-file.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "nnn-mapped-file.h"
+
+#include "ns3/log.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.MappedFile");
+
+  namespace nnn
+  {
+    MappedFile::MappedFile ()
+    : m_fd (-1)
+    , m_data (0)
+    , m_size (0)
+    {
+    }
+
+    MappedFile::~MappedFile ()
+    {
+      Close ();
+    }
+
+    bool
+    MappedFile::Open (const std::string &file)
+    {
+      Close ();
+
+      m_fd = open (file.c_str (), O_RDONLY);
+      if (m_fd < 0)
+	{
+	  NS_LOG_ERROR ("Cannot open " << file);
+	  return false;
+	}
+
+      struct stat st;
+      if (fstat (m_fd, &st) != 0)
+	{
+	  NS_LOG_ERROR ("Cannot stat " << file);
+	  Close ();
+	  return false;
+	}
+
+      m_size = st.st_size;
+      if (m_size == 0)
+	return true; // mmap does not accept empty mappings
+
+      void *data = mmap (0, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+      if (data == MAP_FAILED)
+	{
+	  NS_LOG_ERROR ("Cannot map " << file);
+	  Close ();
+	  return false;
+	}
+
+      // Files are read front to back
+      madvise (data, m_size, MADV_SEQUENTIAL);
+
+      m_data = static_cast<const char *> (data);
+      return true;
+    }
+
+    void
+    MappedFile::Close ()
+    {
+      if (m_data != 0)
+	{
+	  munmap (const_cast<char *> (m_data), m_size);
+	  m_data = 0;
+	}
+
+      if (m_fd >= 0)
+	{
+	  close (m_fd);
+	  m_fd = -1;
+	}
+
+      m_size = 0;
+    }
+
+    bool
+    MappedFile::IsOpen () const
+    {
+      return m_fd >= 0;
+    }
+
+    const char *
+    MappedFile::GetData () const
+    {
+      return m_data;
+    }
+
+    size_t
+    MappedFile::GetSize () const
+    {
+      return m_size;
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
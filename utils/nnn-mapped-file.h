@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-mapped-file.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-mapped-file.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-mapped-file.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_MAPPED_FILE_H_
+#define NNN_MAPPED_FILE_H_
+
+#include <stddef.h>
+#include <string>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Read only view of a whole file mapped into memory
+     *
+     * Pages are loaded by the OS as they are read, so large input files
+     * (request traces, snapshots) do not have to be copied into the heap.
+     */
+    class MappedFile
+    {
+    public:
+      MappedFile ();
+
+      ~MappedFile ();
+
+      /**
+       * @brief Map a file, closing the previously mapped one
+       * @returns false if the file could not be opened or mapped
+       */
+      bool
+      Open (const std::string &file);
+
+      void
+      Close ();
+
+      bool
+      IsOpen () const;
+
+      /**
+       * @brief First byte of the file, 0 if nothing is mapped or the file is empty
+       */
+      const char *
+      GetData () const;
+
+      size_t
+      GetSize () const;
+
+    private:
+      // Not copyable, the mapping is owned
+      MappedFile (const MappedFile &);
+      MappedFile &
+      operator= (const MappedFile &);
+
+      int m_fd;
+      const char *m_data;
+      size_t m_size;
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_MAPPED_FILE_H_ */
@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-stage-profiler.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-stage-profiler.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-stage-profiler.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "nnn-stage-profiler.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "../helper/nnn-distributed-helper.h"
+
+#include <fstream>
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.StageProfiler");
+
+  namespace nnn
+  {
+    StageTimer *StageTimer::s_current = 0;
+
+    static const char *g_stageNames[StageProfiler::STAGES] =
+      {
+	"FaceReceive",
+	"OnSO",
+	"OnDO",
+	"OnDU",
+	"ProcessICNPDU",
+	"ProcessInterest",
+	"ProcessData",
+	"SatisfyPendingInterest",
+	"DoPropagateInterest",
+	"FaceSend"
+      };
+
+    static LogLinearHistogram g_total[StageProfiler::STAGES];
+    static LogLinearHistogram g_self[StageProfiler::STAGES];
+
+    static std::string g_dumpFile;
+
+    bool
+    StageProfiler::IsEnabled ()
+    {
+#ifdef NNNSIM_PROFILE
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    const char *
+    StageProfiler::GetStageName (Stage stage)
+    {
+      return g_stageNames[stage];
+    }
+
+    const char *
+    StageProfiler::GetUnit ()
+    {
+#if defined(__i386__) || defined(__x86_64__)
+      return "cycles";
+#else
+      return "ns";
+#endif
+    }
+
+    void
+    StageProfiler::Record (Stage stage, uint64_t total, uint64_t self)
+    {
+      g_total[stage].Add (total);
+      g_self[stage].Add (self);
+    }
+
+    const LogLinearHistogram &
+    StageProfiler::GetTotal (Stage stage)
+    {
+      return g_total[stage];
+    }
+
+    const LogLinearHistogram &
+    StageProfiler::GetSelf (Stage stage)
+    {
+      return g_self[stage];
+    }
+
+    void
+    StageProfiler::Reset ()
+    {
+      for (uint32_t i = 0; i < STAGES; i++)
+	{
+	  g_total[i].Reset ();
+	  g_self[i].Reset ();
+	}
+    }
+
+    static void
+    DumpHistogram (std::ostream &os, const char *stage, const char *time, const LogLinearHistogram &histogram)
+    {
+      os << stage << "\t"
+	  << time << "\t"
+	  << StageProfiler::GetUnit () << "\t"
+	  << histogram.GetCount () << "\t"
+	  << histogram.GetMean () << "\t"
+	  << histogram.GetQuantile (0.5) << "\t"
+	  << histogram.GetQuantile (0.9) << "\t"
+	  << histogram.GetQuantile (0.99) << "\t"
+	  << histogram.GetMax () << "\n";
+    }
+
+    void
+    StageProfiler::Dump (std::ostream &os)
+    {
+      if (!IsEnabled ())
+	NS_LOG_WARN ("nnnSIM was not configured with --nnnsim-profile, no stage was timed");
+
+      os << "Stage" << "\t"
+	  << "Time" << "\t"
+	  << "Unit" << "\t"
+	  << "Calls" << "\t"
+	  << "Mean" << "\t"
+	  << "P50" << "\t"
+	  << "P90" << "\t"
+	  << "P99" << "\t"
+	  << "Max" << "\n";
+
+      for (uint32_t i = 0; i < STAGES; i++)
+	{
+	  DumpHistogram (os, g_stageNames[i], "Total", g_total[i]);
+	  DumpHistogram (os, g_stageNames[i], "Self", g_self[i]);
+	}
+    }
+
+    static void
+    DumpToFile ()
+    {
+      if (g_dumpFile == "-")
+	{
+	  StageProfiler::Dump (std::cout);
+	}
+      else
+	{
+	  std::ofstream os (DistributedHelper::GetRankFileName (g_dumpFile).c_str ());
+	  if (!os.is_open ())
+	    NS_LOG_ERROR ("File " << g_dumpFile << " cannot be opened for writing. Stage times not written");
+	  else
+	    StageProfiler::Dump (os);
+	}
+
+      g_dumpFile.clear ();
+    }
+
+    void
+    StageProfiler::DumpAtEnd (const std::string &file)
+    {
+      if (g_dumpFile.empty ())
+	Simulator::ScheduleDestroy (&DumpToFile);
+
+      g_dumpFile = file;
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
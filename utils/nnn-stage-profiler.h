@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-stage-profiler.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-stage-profiler.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-stage-profiler.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_STAGE_PROFILER_H_
+#define NNN_STAGE_PROFILER_H_
+
+#include "nnn-log-linear-histogram.h"
+
+#include <stdint.h>
+#include <iostream>
+#include <string>
+
+#if !defined(__i386__) && !defined(__x86_64__)
+#include <time.h>
+#endif
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Wall time spent by the stages of the forwarding path
+     *
+     * When nnnSIM is configured with --nnnsim-profile, NNNSIM_PROFILE is
+     * defined and the stages marked with NNN_PROFILE_STAGE time every call
+     * with the processor cycle counter (the monotonic clock in ns on other
+     * processors). Every stage keeps two histograms, one of the whole time
+     * of its calls and one of their self time, without the time spent in
+     * the stages they call. The self time of FaceReceive is thus the wire
+     * decoding, that of OnDO the NNST and NNPT work before the ICN PDU is
+     * processed, and so on. Without the option, NNN_PROFILE_STAGE expands to
+     * nothing and the forwarding path is not changed.
+     *
+     * The histograms are shared by all the nodes of the process:
+     *
+     * \code
+     *   StageProfiler::DumpAtEnd ("stages.txt");
+     *   Simulator::Run ();
+     *   Simulator::Destroy ();
+     * \endcode
+     */
+    class StageProfiler
+    {
+    public:
+      enum Stage
+      {
+	FACE_RECEIVE = 0,
+	ON_SO,
+	ON_DO,
+	ON_DU,
+	PROCESS_ICN_PDU,
+	PROCESS_INTEREST,
+	PROCESS_DATA,
+	SATISFY_PENDING_INTEREST,
+	DO_PROPAGATE_INTEREST,
+	FACE_SEND,
+	STAGES
+      };
+
+      /**
+       * @brief Whether nnnSIM was built with the stages timed
+       */
+      static bool
+      IsEnabled ();
+
+      static const char *
+      GetStageName (Stage stage);
+
+      /**
+       * @brief Unit of the times, "cycles" or "ns"
+       */
+      static const char *
+      GetUnit ();
+
+      static uint64_t
+      Now ()
+      {
+#if defined(__i386__) || defined(__x86_64__)
+	uint32_t low, high;
+	__asm__ __volatile__ ("rdtsc" : "=a" (low), "=d" (high));
+	return (static_cast<uint64_t> (high) << 32) | low;
+#else
+	struct timespec now;
+	clock_gettime (CLOCK_MONOTONIC, &now);
+	return static_cast<uint64_t> (now.tv_sec) * 1000000000 + now.tv_nsec;
+#endif
+      }
+
+      static void
+      Record (Stage stage, uint64_t total, uint64_t self);
+
+      static const LogLinearHistogram &
+      GetTotal (Stage stage);
+
+      static const LogLinearHistogram &
+      GetSelf (Stage stage);
+
+      static void
+      Reset ();
+
+      /**
+       * @brief Write count, mean, quantiles and maximum of the total and self time of every stage as TSV
+       */
+      static void
+      Dump (std::ostream &os);
+
+      /**
+       * @brief Dump into the file when the simulator is destroyed
+       *
+       * Under the distributed simulator every rank writes the file given by
+       * DistributedHelper::GetRankFileName. If file is -, std::cout is used
+       */
+      static void
+      DumpAtEnd (const std::string &file);
+    };
+
+    /**
+     * @brief Times the scope it is declared in as a stage, see NNN_PROFILE_STAGE
+     */
+    class StageTimer
+    {
+    public:
+      explicit
+      StageTimer (StageProfiler::Stage stage)
+      : m_stage (stage)
+      , m_children (0)
+      , m_parent (s_current)
+      {
+	s_current = this;
+	m_start = StageProfiler::Now ();
+      }
+
+      ~StageTimer ()
+      {
+	uint64_t total = StageProfiler::Now () - m_start;
+	StageProfiler::Record (m_stage, total, total - m_children);
+
+	if (m_parent != 0)
+	  m_parent->m_children += total;
+	s_current = m_parent;
+      }
+
+    private:
+      StageProfiler::Stage m_stage;
+      uint64_t m_start;
+      uint64_t m_children;
+      StageTimer *m_parent;
+
+      static StageTimer *s_current;
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#ifdef NNNSIM_PROFILE
+#define NNN_PROFILE_STAGE(stage) \
+  ns3::nnn::StageTimer nnnStageTimer (ns3::nnn::StageProfiler::stage)
+#else
+#define NNN_PROFILE_STAGE(stage)
+#endif
+
+#endif /* NNN_STAGE_PROFILER_H_ */
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-table-stats-probe.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-table-stats-probe.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-table-stats-probe.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "nnn-table-stats-probe.h"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+
+#include "../model/nnst/nnn-nnst.h"
+#include "../model/nnpt/nnn-nnpt.h"
+#include "../model/pit/nnn-pit.h"
+#include "../model/cs/nnn-icn-content-store.h"
+#include "../model/buffers/nnn-pdu-buffer.h"
+#include "../model/fw/nnn-forwarding-strategy.h"
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.TableStatsProbe");
+
+  namespace nnn
+  {
+    NS_OBJECT_ENSURE_REGISTERED (TableStatsProbe);
+
+    TypeId
+    TableStatsProbe::GetTypeId ()
+    {
+      static TypeId tid = TypeId ("ns3::nnn::TableStatsProbe")
+	.SetGroupName ("Nnn")
+	.SetParent<Object> ()
+	.AddConstructor<TableStatsProbe> ()
+
+	.AddAttribute ("Interval", "Time between two readings of the table counters",
+		       TimeValue (Seconds (1.0)),
+		       MakeTimeAccessor (&TableStatsProbe::m_interval),
+		       MakeTimeChecker ())
+
+	.AddTraceSource ("Stats", "Counters of one table over the last interval",
+			 MakeTraceSourceAccessor (&TableStatsProbe::m_statsTrace),
+			 "ns3::nnn::TableStatsProbe::StatsTracedCallback")
+	;
+      return tid;
+    }
+
+    TableStatsProbe::TableStatsProbe ()
+    {
+    }
+
+    TableStatsProbe::~TableStatsProbe ()
+    {
+    }
+
+    Ptr<TableStatsProbe>
+    TableStatsProbe::Install (Ptr<Node> node)
+    {
+      Ptr<TableStatsProbe> probe = node->GetObject<TableStatsProbe> ();
+      if (probe == 0)
+	{
+	  probe = CreateObject<TableStatsProbe> ();
+	  node->AggregateObject (probe);
+	}
+      return probe;
+    }
+
+    Ptr<TableStatsProbe>
+    TableStatsProbe::Install (Ptr<Node> node, Time interval)
+    {
+      Ptr<TableStatsProbe> probe = node->GetObject<TableStatsProbe> ();
+      if (probe == 0)
+	{
+	  // The first reading is scheduled when the probe is aggregated
+	  probe = CreateObject<TableStatsProbe> ();
+	  probe->SetAttribute ("Interval", TimeValue (interval));
+	  node->AggregateObject (probe);
+	}
+      else if (probe->m_interval != interval)
+	{
+	  NS_LOG_WARN ("Node " << node->GetId () << " already has a probe reading every " << probe->m_interval);
+	}
+      return probe;
+    }
+
+    void
+    TableStatsProbe::NotifyNewAggregate ()
+    {
+      if (m_node == 0)
+	{
+	  m_node = GetObject<Node> ();
+	  if (m_node != 0)
+	    {
+	      m_event = Simulator::ScheduleWithContext (m_node->GetId (), m_interval, &TableStatsProbe::Sample, this);
+	    }
+	}
+
+      Object::NotifyNewAggregate ();
+    }
+
+    void
+    TableStatsProbe::DoDispose ()
+    {
+      m_event.Cancel ();
+      m_node = 0;
+      m_last.clear ();
+
+      Object::DoDispose ();
+    }
+
+    void
+    TableStatsProbe::Fire (const std::string &table, const TableStats &stats)
+    {
+      TableStats &last = m_last[table];
+      m_statsTrace (table, stats.Since (last));
+      last = stats;
+    }
+
+    void
+    TableStatsProbe::Sample ()
+    {
+      NS_LOG_FUNCTION (this);
+
+      Ptr<NNST> nnst = m_node->GetObject<NNST> ();
+      if (nnst != 0)
+	Fire ("NNST", nnst->GetStats ());
+
+      Ptr<NNPT> nnpt = m_node->GetObject<NNPT> ();
+      if (nnpt != 0)
+	Fire ("NNPT", nnpt->GetStats ());
+
+      Ptr<Pit> pit = m_node->GetObject<Pit> ();
+      if (pit != 0)
+	Fire ("PIT", pit->GetStats ());
+
+      Ptr<ContentStore> cs = m_node->GetObject<ContentStore> ();
+      if (cs != 0)
+	Fire ("CS", cs->GetStats ());
+
+      Ptr<ForwardingStrategy> fw = m_node->GetObject<ForwardingStrategy> ();
+      if (fw != 0 && fw->GetPDUBuffer () != 0)
+	Fire ("PDUBuffer", fw->GetPDUBuffer ()->GetStats ());
+
+      m_event = Simulator::Schedule (m_interval, &TableStatsProbe::Sample, this);
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-table-stats-probe.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-table-stats-probe.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-table-stats-probe.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_TABLE_STATS_PROBE_H_
+#define NNN_TABLE_STATS_PROBE_H_
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+
+#include "nnn-table-stats.h"
+
+#include <map>
+#include <string>
+
+namespace ns3
+{
+  class Node;
+
+  namespace nnn
+  {
+    /**
+     * @brief Periodic reading of the usage counters of the tables of a node
+     *
+     * Every Interval, the probe reads the counters of the NNST, NNPT, PIT,
+     * content store and PDU buffer of its node, whichever are installed, and
+     * fires the Stats trace source once per table, named "NNST", "NNPT",
+     * "PIT", "CS" and "PDUBuffer". The counters given are those of the last
+     * interval, the sizes those at the time of the reading.
+     *
+     * Reading the counters does not walk the tables, so the probe can run on
+     * every node of large scenarios.
+     */
+    class TableStatsProbe : public Object
+    {
+    public:
+      static TypeId
+      GetTypeId ();
+
+      TableStatsProbe ();
+
+      virtual
+      ~TableStatsProbe ();
+
+      /**
+       * @brief Get the probe aggregated to the node, aggregating and starting one if there is none
+       */
+      static Ptr<TableStatsProbe>
+      Install (Ptr<Node> node);
+
+      /**
+       * @brief Same as Install (node), setting the Interval of a probe it aggregates
+       */
+      static Ptr<TableStatsProbe>
+      Install (Ptr<Node> node, Time interval);
+
+      typedef void (* StatsTracedCallback) (const std::string &table, const TableStats &stats);
+
+    protected:
+      virtual void
+      NotifyNewAggregate ();
+
+      virtual void
+      DoDispose ();
+
+    private:
+      void
+      Sample ();
+
+      void
+      Fire (const std::string &table, const TableStats &stats);
+
+    private:
+      Ptr<Node> m_node;
+      Time m_interval;
+      EventId m_event;
+      std::map<std::string, TableStats> m_last;
+
+      TracedCallback<const std::string &, const TableStats &> m_statsTrace;
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_TABLE_STATS_PROBE_H_ */
@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-table-stats.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-table-stats.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-table-stats.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_TABLE_STATS_H_
+#define NNN_TABLE_STATS_H_
+
+#include <stdint.h>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Usage counters of a table (NNST, NNPT, PIT, content store, PDU buffer)
+     *
+     * Tables keep the counters up to date as they are used, so reading them
+     * costs the same whatever the size of the table. The sizes (entries,
+     * trie nodes and bytes) are filled in when the counters are read.
+     */
+    struct TableStats
+    {
+      TableStats ()
+      : m_entries (0)
+      , m_nodes   (0)
+      , m_bytes   (0)
+      , m_lookups (0)
+      , m_hits    (0)
+      , m_depth   (0)
+      , m_inserts (0)
+      , m_erases  (0)
+      , m_expired (0)
+      {
+      }
+
+      /**
+       * @brief Count a lookup
+       *
+       * @param hit whether the lookup found what it was looking for
+       * @param depth name components walked in the trie, or entries visited by a scan
+       */
+      void
+      Lookup (bool hit, uint64_t depth)
+      {
+	m_lookups++;
+	m_hits += hit;
+	m_depth += depth;
+      }
+
+      uint64_t
+      GetMisses () const
+      {
+	return m_lookups - m_hits;
+      }
+
+      double
+      GetAverageDepth () const
+      {
+	return (m_lookups == 0) ? 0.0 : static_cast<double> (m_depth) / m_lookups;
+      }
+
+      /**
+       * @brief Counters since an earlier reading, with the sizes of this one
+       */
+      TableStats
+      Since (const TableStats &earlier) const
+      {
+	TableStats diff = *this;
+	diff.m_lookups -= earlier.m_lookups;
+	diff.m_hits -= earlier.m_hits;
+	diff.m_depth -= earlier.m_depth;
+	diff.m_inserts -= earlier.m_inserts;
+	diff.m_erases -= earlier.m_erases;
+	diff.m_expired -= earlier.m_expired;
+	return diff;
+      }
+
+      uint64_t m_entries; ///< @brief Entries in the table
+      uint64_t m_nodes;   ///< @brief Trie nodes below the root, 0 for tables that are not tries
+      uint64_t m_bytes;   ///< @brief Estimate of the memory of the entries and trie nodes, without names and PDUs
+      uint64_t m_lookups; ///< @brief Lookups made in the table
+      uint64_t m_hits;    ///< @brief Lookups that found an entry
+      uint64_t m_depth;   ///< @brief Name components or entries visited by all the lookups
+      uint64_t m_inserts; ///< @brief Entries created
+      uint64_t m_erases;  ///< @brief Entries removed, expired and evicted ones included
+      uint64_t m_expired; ///< @brief Entries removed because their lease or lifetime ran out
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_TABLE_STATS_H_ */
@@ -21,6 +21,7 @@
  * Modified for nnnsim by Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
  */
 #include "nnn-app-delay-tracer.h"
+#include "nnn-tracer-streams.h"
 
 #include <ns3-dev/ns3/node.h>
 #include <ns3-dev/ns3/packet.h>
@@ -33,6 +34,8 @@
 
 #include "../../model/nnn-icn-pdus.h"
 
+#include "../../helper/nnn-distributed-helper.h"
+
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
@@ -46,7 +49,8 @@ namespace ns3
 {
   namespace nnn
   {
-    static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<AppDelayTracer> > > > g_tracers;
+    // Released with the simulator, see KeepTracers
+    static TracerStreams<AppDelayTracer>::List g_tracers;
 
     template<class T>
     static inline void
@@ -54,9 +58,10 @@ namespace ns3
     {
     }
 
-    AppDelayTracer::AppDelayTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
+    AppDelayTracer::AppDelayTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node, Time summaryPeriod)
     : m_nodePtr (node)
     , m_os (os)
+    , m_period (summaryPeriod)
     {
       m_node = boost::lexical_cast<std::string> (m_nodePtr->GetId ());
 
@@ -69,26 +74,32 @@ namespace ns3
 	}
     }
 
-    AppDelayTracer::AppDelayTracer (boost::shared_ptr<std::ostream> os, const std::string &node)
+    AppDelayTracer::AppDelayTracer (boost::shared_ptr<std::ostream> os, const std::string &node, Time summaryPeriod)
     : m_node (node)
     , m_os (os)
+    , m_period (summaryPeriod)
     {
       Connect ();
     }
 
     AppDelayTracer::~AppDelayTracer ()
     {
+      m_printEvent.Cancel ();
     }
 
     void
-    AppDelayTracer::Install (Ptr<Node> node, const std::string &file)
+    AppDelayTracer::Install (Ptr<Node> node, const std::string &file, Time summaryPeriod/* = Seconds (0)*/)
     {
+      // Simulated, and traced, by another rank
+      if (!DistributedHelper::IsLocal (node))
+	return;
+
       std::list<Ptr<AppDelayTracer> > tracers;
       boost::shared_ptr<std::ostream> outputStream;
       if (file != "-")
 	{
 	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+	  os->open (DistributedHelper::GetRankFileName (file).c_str (), std::ios_base::out | std::ios_base::trunc);
 
 	  if (!os->is_open ())
 	    {
@@ -103,7 +114,7 @@ namespace ns3
 	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
 	}
 
-      Ptr<AppDelayTracer> trace = Install (node, outputStream);
+      Ptr<AppDelayTracer> trace = Install (node, outputStream, summaryPeriod);
       tracers.push_back (trace);
 
       if (tracers.size () > 0)
@@ -113,29 +124,30 @@ namespace ns3
 	  *outputStream << "\n";
 	}
 
-      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+      KeepTracers (g_tracers, outputStream, tracers);
     }
 
     Ptr<AppDelayTracer>
     AppDelayTracer::Install (Ptr<Node> node,
-                             boost::shared_ptr<std::ostream> outputStream)
+                             boost::shared_ptr<std::ostream> outputStream,
+                             Time summaryPeriod/* = Seconds (0)*/)
     {
       NS_LOG_DEBUG ("Node: " << node->GetId ());
 
-      Ptr<AppDelayTracer> trace = Create<AppDelayTracer> (outputStream, node);
+      Ptr<AppDelayTracer> trace = Create<AppDelayTracer> (outputStream, node, summaryPeriod);
 
       return trace;
     }
 
     void
-    AppDelayTracer::Install (const NodeContainer &nodes, const std::string &file)
+    AppDelayTracer::Install (const NodeContainer &nodes, const std::string &file, Time summaryPeriod/* = Seconds (0)*/)
     {
       std::list<Ptr<AppDelayTracer> > tracers;
       boost::shared_ptr<std::ostream> outputStream;
       if (file != "-")
 	{
 	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+	  os->open (DistributedHelper::GetRankFileName (file).c_str (), std::ios_base::out | std::ios_base::trunc);
 
 	  if (!os->is_open ())
 	    {
@@ -154,7 +166,10 @@ namespace ns3
 	  node != nodes.End ();
 	  node++)
 	{
-	  Ptr<AppDelayTracer> trace = Install (*node, outputStream);
+	  if (!DistributedHelper::IsLocal (*node))
+	    continue;
+
+	  Ptr<AppDelayTracer> trace = Install (*node, outputStream, summaryPeriod);
 	  tracers.push_back (trace);
 	}
 
@@ -165,11 +180,11 @@ namespace ns3
 	  *outputStream << "\n";
 	}
 
-      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+      KeepTracers (g_tracers, outputStream, tracers);
     }
 
     void
-    AppDelayTracer::InstallAll (const std::string &file)
+    AppDelayTracer::InstallAll (const std::string &file, Time summaryPeriod/* = Seconds (0)*/)
     {
       using namespace boost;
       using namespace std;
@@ -179,7 +194,7 @@ namespace ns3
       if (file != "-")
 	{
 	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+	  os->open (DistributedHelper::GetRankFileName (file).c_str (), std::ios_base::out | std::ios_base::trunc);
 
 	  if (!os->is_open ())
 	    {
@@ -198,7 +213,10 @@ namespace ns3
 	  node != NodeList::End ();
 	  node++)
 	{
-	  Ptr<AppDelayTracer> trace = Install (*node, outputStream);
+	  if (!DistributedHelper::IsLocal (*node))
+	    continue;
+
+	  Ptr<AppDelayTracer> trace = Install (*node, outputStream, summaryPeriod);
 	  tracers.push_back (trace);
 	}
 
@@ -209,18 +227,48 @@ namespace ns3
 	  *outputStream << "\n";
 	}
 
-      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+      KeepTracers (g_tracers, outputStream, tracers);
     }
 
     void
     AppDelayTracer::Destroy ()
     {
+      for (TracerStreams<AppDelayTracer>::List::iterator i = g_tracers.begin ();
+	  i != g_tracers.end (); i++)
+	{
+	  for (std::list<Ptr<AppDelayTracer> >::iterator trace = i->get<1> ().begin ();
+	      trace != i->get<1> ().end (); trace++)
+	    {
+	      (*trace)->PrintSummaries ();
+	    }
+
+	  i->get<0> ()->flush ();
+	}
+
       g_tracers.clear ();
     }
 
     void
     AppDelayTracer::PrintHeader (std::ostream &os) const
     {
+      if (!m_period.IsZero ())
+	{
+	  os << "Time" << "\t"
+	      << "Node" << "\t"
+	      << "AppIndex" << "\t"
+	      << "Type" << "\t"
+	      << "Samples" << "\t"
+	      << "MeanS" << "\t"
+	      << "MinS" << "\t"
+	      << "P50S" << "\t"
+	      << "P90S" << "\t"
+	      << "P99S" << "\t"
+	      << "MaxS" << "\t"
+	      << "MeanRetxCount" << "\t"
+	      << "MeanHopCount";
+	  return;
+	}
+
       os << "Time" << "\t"
 	  << "Node" << "\t"
 	  << "AppId" << "\t"
@@ -236,6 +284,18 @@ namespace ns3
     void
     AppDelayTracer::Connect ()
     {
+      if (!m_period.IsZero ())
+	{
+	  Config::ConnectWithoutContext ("/NodeList/"+m_node+"/ApplicationList/*/LastRetransmittedInterestDataDelay",
+					 MakeCallback (&AppDelayTracer::SummarizeLastDelay, this));
+
+	  Config::ConnectWithoutContext ("/NodeList/"+m_node+"/ApplicationList/*/FirstInterestDataDelay",
+					 MakeCallback (&AppDelayTracer::SummarizeFullDelay, this));
+
+	  m_printEvent = Simulator::Schedule (m_period, &AppDelayTracer::PeriodicPrinter, this);
+	  return;
+	}
+
       Config::ConnectWithoutContext ("/NodeList/"+m_node+"/ApplicationList/*/LastRetransmittedInterestDataDelay",
                                      MakeCallback (&AppDelayTracer::LastRetransmittedInterestDataDelay, this));
 
@@ -270,5 +330,84 @@ namespace ns3
 	  << retxCount << "\t"
 	  << hopCount << "\n";
     }
+
+    AppDelayTracer::AppSummary &
+    AppDelayTracer::GetSummary (Ptr<App> app)
+    {
+      // App::GetId is the id of the application face, which is not set for
+      // every application. Nodes hold a handful of applications, finding the
+      // position of this one is cheaper than a map keyed by the application
+      Ptr<Node> node = app->GetNode ();
+      uint32_t index = 0;
+      while (index < node->GetNApplications () && node->GetApplication (index) != app)
+	index++;
+
+      if (index >= m_apps.size ())
+	m_apps.resize (index + 1);
+
+      return m_apps[index];
+    }
+
+    void
+    AppDelayTracer::SummarizeLastDelay (Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount)
+    {
+      GetSummary (app).m_last.Add (delay, 1, hopCount);
+    }
+
+    void
+    AppDelayTracer::SummarizeFullDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount)
+    {
+      GetSummary (app).m_full.Add (delay, retxCount, hopCount);
+    }
+
+    void
+    AppDelayTracer::PrintSummary (const std::string &type, uint32_t appIndex, const DelaySummary &summary)
+    {
+      const LogLinearHistogram &delays = summary.m_delays;
+
+      *m_os << Simulator::Now ().ToDouble (Time::S) << "\t"
+	  << m_node << "\t"
+	  << appIndex << "\t"
+	  << type << "\t"
+	  << delays.GetCount () << "\t"
+	  << delays.GetMean () / 1e9 << "\t"
+	  << delays.GetMin () / 1e9 << "\t"
+	  << delays.GetQuantile (0.5) / 1e9 << "\t"
+	  << delays.GetQuantile (0.9) / 1e9 << "\t"
+	  << delays.GetQuantile (0.99) / 1e9 << "\t"
+	  << delays.GetMax () / 1e9 << "\t"
+	  << static_cast<double> (summary.m_retx) / delays.GetCount () << "\t"
+	  << static_cast<double> (summary.m_hops) / delays.GetCount () << "\n";
+    }
+
+    void
+    AppDelayTracer::PrintSummaries ()
+    {
+      for (uint32_t index = 0; index < m_apps.size (); index++)
+	{
+	  AppSummary &summary = m_apps[index];
+
+	  // Applications without delays in the period cost neither a line nor a reset
+	  if (summary.m_last.m_delays.GetCount () != 0)
+	    {
+	      PrintSummary ("LastDelay", index, summary.m_last);
+	      summary.m_last.Reset ();
+	    }
+
+	  if (summary.m_full.m_delays.GetCount () != 0)
+	    {
+	      PrintSummary ("FullDelay", index, summary.m_full);
+	      summary.m_full.Reset ();
+	    }
+	}
+    }
+
+    void
+    AppDelayTracer::PeriodicPrinter ()
+    {
+      PrintSummaries ();
+
+      m_printEvent = Simulator::Schedule (m_period, &AppDelayTracer::PeriodicPrinter, this);
+    }
   } /* namespace nnn */
 } /* namespace ns3 */
@@ -33,6 +33,9 @@
 #include <boost/tuple/tuple.hpp>
 #include <boost/shared_ptr.hpp>
 #include <list>
+#include <vector>
+
+#include "../nnn-log-linear-histogram.h"
 
 namespace ns3
 {
@@ -43,6 +46,20 @@ namespace ns3
   {
     class App;
 
+    /**
+     * @brief Tracer of the delays between Interests and the Data satisfying them
+     *
+     * By default every satisfied Interest is written as a line. With a
+     * summary period, the delays of every application are instead added to
+     * log-linear histograms (see LogLinearHistogram) and, every period, one
+     * line per application and type of delay gives the number of samples,
+     * the mean, minimum, median, 90th and 99th percentiles and maximum of
+     * the delays, and the mean retransmission and hop counts. Summary lines
+     * identify the application by its index in the ApplicationList of the
+     * node (AppIndex), not by the id of its face. The memory used
+     * does not grow with the length of the run, and nothing is allocated or
+     * formatted per sample once an application has been seen.
+     */
     class AppDelayTracer : public SimpleRefCount<AppDelayTracer>
     {
     public:
@@ -50,15 +67,17 @@ namespace ns3
        * @brief Trace constructor that attaches to all applications on the node using node's pointer
        * @param os    reference to the output stream
        * @param node  pointer to the node
+       * @param summaryPeriod how often the delay summaries are written, 0 to write every delay
        */
-      AppDelayTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node);
+      AppDelayTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node, Time summaryPeriod = Seconds (0));
 
       /**
        * @brief Trace constructor that attaches to all applications on the node using node's name
        * @param os        reference to the output stream
        * @param nodeName  name of the node registered using Names::Add
+       * @param summaryPeriod how often the delay summaries are written, 0 to write every delay
        */
-      AppDelayTracer (boost::shared_ptr<std::ostream> os, const std::string &node);
+      AppDelayTracer (boost::shared_ptr<std::ostream> os, const std::string &node, Time summaryPeriod = Seconds (0));
 
       /**
        * @brief Destructor
@@ -70,58 +89,65 @@ namespace ns3
        *
        * @param nodes Nodes on which to install tracer
        * @param file File to which traces will be written.  If filename is -, then std::out is used
-       * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+       * @param summaryPeriod How often the delay summaries are written (default, 0 to write every delay)
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
        *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
        *
        */
       static void
-      Install (Ptr<Node> node, const std::string &file);
+      Install (Ptr<Node> node, const std::string &file, Time summaryPeriod = Seconds (0));
 
       /**
        * @brief Helper method to install tracers on a specific simulation node
        *
        * @param nodes Nodes on which to install tracer
        * @param outputStream Smart pointer to a stream
-       * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+       * @param summaryPeriod How often the delay summaries are written (default, 0 to write every delay)
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
        *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
        */
       static Ptr<AppDelayTracer>
-      Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream);
+      Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream, Time summaryPeriod = Seconds (0));
 
       /**
        * @brief Helper method to install tracers on the selected simulation nodes
        *
        * @param nodes Nodes on which to install tracer
        * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param summaryPeriod How often the delay summaries are written (default, 0 to write every delay)
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
        *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
        *
        */
       static void
-      Install (const NodeContainer &nodes, const std::string &file);
+      Install (const NodeContainer &nodes, const std::string &file, Time summaryPeriod = Seconds (0));
 
       /**
        * @brief Helper method to install tracers on all simulation nodes
        *
+       * Under the distributed simulator only the nodes of this rank are traced,
+       * into the file given by DistributedHelper::GetRankFileName
+       *
        * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param summaryPeriod How often the delay summaries are written (default, 0 to write every delay)
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
        *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
        *
        */
       static void
-      InstallAll (const std::string &file);
+      InstallAll (const std::string &file, Time summaryPeriod = Seconds (0));
 
       /**
        * @brief Explicit request to remove all statically created tracers
        *
        * This method can be helpful if simulation scenario contains several independent run,
-       * or if it is desired to do a postprocessing of the resulting data
+       * or if it is desired to do a postprocessing of the resulting data.
+       * It is also called by Simulator::Destroy. Tracers writing summaries write
+       * the one of the last, partial, period first
        */
       static void
       Destroy ();
@@ -144,11 +170,68 @@ namespace ns3
       void
       FirstInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount, int32_t hopCount);
 
+      void
+      SummarizeLastDelay (Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
+
+      void
+      SummarizeFullDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount);
+
+      void
+      PrintSummaries ();
+
+      void
+      PeriodicPrinter ();
+
+      struct DelaySummary
+      {
+	DelaySummary ()
+	: m_retx (0)
+	, m_hops (0)
+	{
+	}
+
+	void
+	Add (Time delay, uint32_t retxCount, int32_t hopCount)
+	{
+	  m_delays.Add (delay.GetNanoSeconds ());
+	  m_retx += retxCount;
+	  m_hops += hopCount;
+	}
+
+	void
+	Reset ()
+	{
+	  m_delays.Reset ();
+	  m_retx = 0;
+	  m_hops = 0;
+	}
+
+	LogLinearHistogram m_delays; ///< @brief Delays in nanoseconds
+	uint64_t m_retx;
+	int64_t m_hops;
+      };
+
+      struct AppSummary
+      {
+	DelaySummary m_last;
+	DelaySummary m_full;
+      };
+
+      AppSummary &
+      GetSummary (Ptr<App> app);
+
+      void
+      PrintSummary (const std::string &type, uint32_t appIndex, const DelaySummary &summary);
+
     private:
       std::string m_node;
       Ptr<Node> m_nodePtr;
 
       boost::shared_ptr<std::ostream> m_os;
+
+      Time m_period;
+      EventId m_printEvent;
+      std::vector<AppSummary> m_apps; ///< @brief Summaries indexed by the position of the application in the ApplicationList of the node
     };
   } /* namespace nnn */
 } /* namespace ns3 */
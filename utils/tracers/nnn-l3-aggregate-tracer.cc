@@ -22,6 +22,8 @@
  */
 
 #include "nnn-l3-aggregate-tracer.h"
+#include "nnn-tracer-streams.h"
+#include "nnn-l3-binary-trace.h"
 
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -36,7 +38,10 @@
 #include "../../model/nnn-face.h"
 #include "../../model/pit/nnn-pit-entry.h"
 
+#include "../../helper/nnn-distributed-helper.h"
+
 #include <fstream>
+#include <sstream>
 
 namespace ns3
 {
@@ -44,7 +49,8 @@ namespace ns3
 
   namespace nnn
   {
-    static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<L3AggregateTracer> > > > g_tracers;
+    // Released with the simulator, see KeepTracers
+    static TracerStreams<L3AggregateTracer>::List g_tracers;
 
     template<class T>
     static inline void
@@ -52,9 +58,33 @@ namespace ns3
     {
     }
 
+    // Write the TSV header, or hand the tracers a shared binary writer if the file ends in .bin
+    static void
+    StartOutput (const std::string &file, boost::shared_ptr<std::ostream> outputStream, std::list<Ptr<L3AggregateTracer> > &tracers)
+    {
+      if (L3BinaryTraceWriter::IsBinaryFile (file))
+	{
+	  std::ostringstream header;
+	  tracers.front ()->PrintHeader (header);
+
+	  boost::shared_ptr<L3BinaryTraceWriter> writer (new L3BinaryTraceWriter (outputStream, header.str (), 2));
+	  for (std::list<Ptr<L3AggregateTracer> >::iterator trace = tracers.begin (); trace != tracers.end (); trace++)
+	    {
+	      (*trace)->SetBinaryWriter (writer);
+	    }
+	}
+      else
+	{
+	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
+	  tracers.front ()->PrintHeader (*outputStream);
+	  *outputStream << "\n";
+	}
+    }
+
     L3AggregateTracer::L3AggregateTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
     : L3Tracer (node)
     , m_os (os)
+    , m_hasNodeStats (false)
     {
       Reset ();
     }
@@ -62,6 +92,7 @@ namespace ns3
     L3AggregateTracer::L3AggregateTracer (boost::shared_ptr<std::ostream> os, const std::string &node)
     : L3Tracer (node)
     , m_os (os)
+    , m_hasNodeStats (false)
     {
       Reset ();
     }
@@ -73,12 +104,19 @@ namespace ns3
     void
     L3AggregateTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
     {
+      // Simulated, and traced, by another rank
+      if (!DistributedHelper::IsLocal (node))
+	return;
+
       std::list<Ptr<L3AggregateTracer> > tracers;
       boost::shared_ptr<std::ostream> outputStream;
       if (file != "-")
 	{
 	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+	  std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+	  if (L3BinaryTraceWriter::IsBinaryFile (file))
+	    mode |= std::ios_base::binary;
+	  os->open (DistributedHelper::GetRankFileName (file).c_str (), mode);
 
 	  if (!os->is_open ())
 	    {
@@ -98,12 +136,10 @@ namespace ns3
 
       if (tracers.size () > 0)
 	{
-	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  StartOutput (file, outputStream, tracers);
 	}
 
-      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+      KeepTracers (g_tracers, outputStream, tracers);
     }
 
     void
@@ -114,7 +150,10 @@ namespace ns3
       if (file != "-")
 	{
 	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+	  std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+	  if (L3BinaryTraceWriter::IsBinaryFile (file))
+	    mode |= std::ios_base::binary;
+	  os->open (DistributedHelper::GetRankFileName (file).c_str (), mode);
 
 	  if (!os->is_open ())
 	    {
@@ -133,18 +172,19 @@ namespace ns3
 	  node != nodes.End ();
 	  ++node)
 	{
+	  if (!DistributedHelper::IsLocal (*node))
+	    continue;
+
 	  Ptr<L3AggregateTracer> trace = Install (*node, outputStream, averagingPeriod);
 	  tracers.push_back (trace);
 	}
 
       if (tracers.size () > 0)
 	{
-	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  StartOutput (file, outputStream, tracers);
 	}
 
-      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+      KeepTracers (g_tracers, outputStream, tracers);
     }
 
     Ptr<L3AggregateTracer>
@@ -168,7 +208,10 @@ namespace ns3
       if (file != "-")
 	{
 	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+	  std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+	  if (L3BinaryTraceWriter::IsBinaryFile (file))
+	    mode |= std::ios_base::binary;
+	  os->open (DistributedHelper::GetRankFileName (file).c_str (), mode);
 
 	  if (!os->is_open ())
 	    {
@@ -187,23 +230,30 @@ namespace ns3
 	  node != NodeList::End ();
 	  ++node)
 	{
+	  if (!DistributedHelper::IsLocal (*node))
+	    continue;
+
 	  Ptr<L3AggregateTracer> trace = Install (*node, outputStream, averagingPeriod);
 	  tracers.push_back (trace);
 	}
 
       if (tracers.size () > 0)
 	{
-	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  StartOutput (file, outputStream, tracers);
 	}
 
-      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+      KeepTracers (g_tracers, outputStream, tracers);
     }
 
     void
     L3AggregateTracer::Destroy ()
     {
+      for (TracerStreams<L3AggregateTracer>::List::iterator i = g_tracers.begin ();
+	  i != g_tracers.end (); i++)
+	{
+	  i->get<0> ()->flush ();
+	}
+
       g_tracers.clear ();
     }
 
@@ -221,16 +271,23 @@ namespace ns3
 	  << "Kilobytes";
     }
 
-#define STATS(INDEX) stats->second.get<INDEX> ()
+#define STATS(INDEX) stats.get<INDEX> ()
 
 #define PRINTER(printName, fieldName) \
+  if (m_binary)                                                         \
+    {                                                                   \
+      double values[] = { STATS(0).fieldName, STATS(1).fieldName / 1024.0 }; \
+      m_binary->AddRow (face, printName, values);                       \
+    }                                                                   \
+  else                                                                  \
+    {                                                                   \
   os << time.ToDouble (Time::S) << "\t"                                 \
   << m_node << "\t";                                                    \
-  if (stats->first)                                                     \
+  if (face)                                                             \
     {                                                                   \
       os                                                                \
-        << stats->first->GetId () << "\t"                               \
-        << *stats->first << "\t";                                       \
+        << face->GetId () << "\t"                                       \
+        << *face << "\t";                                               \
     }                                                                   \
   else                                                                  \
     {                                                                   \
@@ -239,20 +296,64 @@ namespace ns3
   os                                                                    \
   << printName << "\t"                                                  \
   << STATS(0).fieldName << "\t"                                         \
-  << STATS(1).fieldName / 1024.0 << "\n";
+  << STATS(1).fieldName / 1024.0 << "\n";                               \
+    }
+
+    L3AggregateTracer::FaceStats &
+    L3AggregateTracer::GetStats (Ptr<const Face> face) const
+    {
+      if (face == 0)
+	{
+	  if (!m_hasNodeStats)
+	    {
+	      m_nodeStats.get<0> ().Reset ();
+	      m_nodeStats.get<1> ().Reset ();
+	      m_hasNodeStats = true;
+	    }
+	  return m_nodeStats;
+	}
+
+      // Face ids are handed out sequentially by the L3Protocol, so the vectors stay dense
+      uint32_t id = face->GetId ();
+      if (id >= m_stats.size ())
+	{
+	  m_faces.resize (id + 1);
+	  m_stats.resize (id + 1);
+	}
+
+      if (m_faces[id] != face)
+	{
+	  m_faces[id] = face;
+	  m_stats[id].get<0> ().Reset ();
+	  m_stats[id].get<1> ().Reset ();
+	}
+
+      return m_stats[id];
+    }
+
+    void
+    L3AggregateTracer::SetBinaryWriter (boost::shared_ptr<L3BinaryTraceWriter> writer)
+    {
+      m_binary = writer;
+    }
 
     void
     L3AggregateTracer::Print (std::ostream &os) const
     {
       Time time = Simulator::Now ();
 
-      for (std::map<Ptr<const Face>, boost::tuple<Stats, Stats> >::iterator stats = m_stats.begin ();
-	  stats != m_stats.end ();
-	  stats++)
+      // In binary mode, all the rows of this period go into one block
+      if (m_binary)
+	m_binary->BeginBlock (time.ToDouble (Time::S), m_node);
+
+      for (uint32_t id = 0; id < m_stats.size (); id++)
 	{
-	  if (!stats->first)
+	  Ptr<const Face> face = m_faces[id];
+	  if (!face)
 	    continue;
 
+	  FaceStats &stats = m_stats[id];
+
 	  PRINTER ("InInterests",   m_inInterests);
 	  PRINTER ("OutInterests",  m_outInterests);
 	  PRINTER ("DropInterests", m_dropInterests);
@@ -302,73 +403,76 @@ namespace ns3
 	  PRINTER ("DropINFs", m_dropINFs);
 	}
 
-      {
-	std::map<Ptr<const Face>, boost::tuple<Stats, Stats> >::iterator stats = m_stats.find (Ptr<const Face> (0));
-	if (stats != m_stats.end ())
-	  {
-	    PRINTER ("SatisfiedInterests", m_satisfiedInterests);
-	    PRINTER ("TimedOutInterests", m_timedOutInterests);
-	  }
-      }
+      if (m_hasNodeStats)
+	{
+	  Ptr<const Face> face = 0;
+	  FaceStats &stats = m_nodeStats;
+
+	  PRINTER ("SatisfiedInterests", m_satisfiedInterests);
+	  PRINTER ("TimedOutInterests", m_timedOutInterests);
+	}
+
+      if (m_binary)
+	m_binary->EndBlock ();
     }
 
     void
     L3AggregateTracer::OutInterests  (Ptr<const Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outInterests ++;
+      GetStats (face).get<0> ().m_outInterests ++;
       if (interest->GetWire ())
         {
-          m_stats[face].get<1> ().m_outInterests += interest->GetWire ()->GetSize ();
+          GetStats (face).get<1> ().m_outInterests += interest->GetWire ()->GetSize ();
         }
     }
 
     void
     L3AggregateTracer::InInterests   (Ptr<const Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inInterests ++;
+      GetStats (face).get<0> ().m_inInterests ++;
       if (interest->GetWire ())
         {
-          m_stats[face].get<1> ().m_inInterests += interest->GetWire ()->GetSize ();
+          GetStats (face).get<1> ().m_inInterests += interest->GetWire ()->GetSize ();
         }
     }
 
     void
     L3AggregateTracer::DropInterests (Ptr<const Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropInterests ++;
+      GetStats (face).get<0> ().m_dropInterests ++;
       if (interest->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropInterests += interest->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropInterests += interest->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::OutNacks  (Ptr<const Interest> nack, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outNacks ++;
+      GetStats (face).get<0> ().m_outNacks ++;
       if (nack->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outNacks += nack->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outNacks += nack->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::InNacks   (Ptr<const Interest> nack, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inNacks ++;
+      GetStats (face).get<0> ().m_inNacks ++;
       if (nack->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inNacks += nack->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inNacks += nack->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::DropNacks (Ptr<const Interest> nack, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropNacks ++;
+      GetStats (face).get<0> ().m_dropNacks ++;
       if (nack->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropNacks += nack->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropNacks += nack->GetWire ()->GetSize ();
 	}
     }
 
@@ -376,10 +480,10 @@ namespace ns3
     L3AggregateTracer::OutData  (Ptr<const Data> data,
                                  bool fromCache, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outData ++;
+      GetStats (face).get<0> ().m_outData ++;
       if (data->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outData += data->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outData += data->GetWire ()->GetSize ();
 	}
     }
 
@@ -387,10 +491,10 @@ namespace ns3
     L3AggregateTracer::InData   (Ptr<const Data> data,
                                  Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inData ++;
+      GetStats (face).get<0> ().m_inData ++;
       if (data->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inData += data->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inData += data->GetWire ()->GetSize ();
 	}
     }
 
@@ -398,324 +502,324 @@ namespace ns3
     L3AggregateTracer::DropData (Ptr<const Data> data,
                                  Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropData ++;
+      GetStats (face).get<0> ().m_dropData ++;
       if (data->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropData += data->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropData += data->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::SatisfiedInterests (Ptr<const pit::Entry>)
     {
-      m_stats[0].get<0> ().m_satisfiedInterests ++;
+      GetStats (0).get<0> ().m_satisfiedInterests ++;
       // no "size" stats
     }
 
     void
     L3AggregateTracer::TimedOutInterests (Ptr<const pit::Entry>)
     {
-      m_stats[0].get<0> ().m_timedOutInterests ++;
+      GetStats (0).get<0> ().m_timedOutInterests ++;
       // no "size" stats
     }
 
     void
     L3AggregateTracer::OutAENs  (Ptr<const AEN> aen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outAENs ++;
+      GetStats (face).get<0> ().m_outAENs ++;
       if (aen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outAENs += aen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outAENs += aen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::InAENs   (Ptr<const AEN> aen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inAENs ++;
+      GetStats (face).get<0> ().m_inAENs ++;
       if (aen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inAENs += aen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inAENs += aen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::DropAENs (Ptr<const AEN> aen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropAENs ++;
+      GetStats (face).get<0> ().m_dropAENs ++;
       if (aen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropAENs += aen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropAENs += aen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::OutDENs  (Ptr<const DEN> den_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outDENs ++;
+      GetStats (face).get<0> ().m_outDENs ++;
       if (den_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outDENs += den_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outDENs += den_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::InDENs   (Ptr<const DEN> den_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inDENs ++;
+      GetStats (face).get<0> ().m_inDENs ++;
       if (den_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inDENs += den_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inDENs += den_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::DropDENs (Ptr<const DEN> den_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropDENs ++;
+      GetStats (face).get<0> ().m_dropDENs ++;
       if (den_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropDENs += den_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropDENs += den_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::OutENs  (Ptr<const EN> en_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outENs ++;
+      GetStats (face).get<0> ().m_outENs ++;
       if (en_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outENs += en_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outENs += en_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::InENs   (Ptr<const EN> en_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inENs ++;
+      GetStats (face).get<0> ().m_inENs ++;
       if (en_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inENs += en_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inENs += en_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::DropENs (Ptr<const EN> en_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropENs ++;
+      GetStats (face).get<0> ().m_dropENs ++;
       if (en_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropENs += en_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropENs += en_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::OutOENs  (Ptr<const OEN> oen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outOENs ++;
+      GetStats (face).get<0> ().m_outOENs ++;
       if (oen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outOENs += oen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outOENs += oen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::InOENs   (Ptr<const OEN> oen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inOENs ++;
+      GetStats (face).get<0> ().m_inOENs ++;
       if (oen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inOENs += oen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inOENs += oen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::DropOENs (Ptr<const OEN> oen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropOENs ++;
+      GetStats (face).get<0> ().m_dropOENs ++;
       if (oen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropENs += oen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropENs += oen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::OutRENs  (Ptr<const REN> ren_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outRENs ++;
+      GetStats (face).get<0> ().m_outRENs ++;
       if (ren_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outRENs += ren_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outRENs += ren_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::InRENs   (Ptr<const REN> ren_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inRENs ++;
+      GetStats (face).get<0> ().m_inRENs ++;
       if (ren_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inRENs += ren_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inRENs += ren_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::DropRENs (Ptr<const REN> ren_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropRENs ++;
+      GetStats (face).get<0> ().m_dropRENs ++;
       if (ren_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropRENs += ren_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropRENs += ren_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::OutINFs  (Ptr<const INF> inf_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outINFs ++;
+      GetStats (face).get<0> ().m_outINFs ++;
       if (inf_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outINFs += inf_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outINFs += inf_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::InINFs   (Ptr<const INF> inf_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inINFs ++;
+      GetStats (face).get<0> ().m_inINFs ++;
       if (inf_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inINFs += inf_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inINFs += inf_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::DropINFs (Ptr<const INF> inf_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropINFs ++;
+      GetStats (face).get<0> ().m_dropINFs ++;
       if (inf_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropINFs += inf_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropINFs += inf_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::OutDOs  (Ptr<const DO> do_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outDOs ++;
+      GetStats (face).get<0> ().m_outDOs ++;
       if (do_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outDOs += do_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outDOs += do_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::InDOs   (Ptr<const DO> do_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inDOs ++;
+      GetStats (face).get<0> ().m_inDOs ++;
       if (do_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inDOs += do_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inDOs += do_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::DropDOs (Ptr<const DO> do_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropDOs ++;
+      GetStats (face).get<0> ().m_dropDOs ++;
       if (do_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropDOs += do_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropDOs += do_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::OutDUs  (Ptr<const DU> du_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outDUs ++;
+      GetStats (face).get<0> ().m_outDUs ++;
       if (du_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outDUs += du_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outDUs += du_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::InDUs   (Ptr<const DU> du_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inDUs ++;
+      GetStats (face).get<0> ().m_inDUs ++;
       if (du_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inDUs += du_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inDUs += du_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::DropDUs (Ptr<const DU> du_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropDUs ++;
+      GetStats (face).get<0> ().m_dropDUs ++;
       if (du_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropDUs += du_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropDUs += du_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::OutSOs  (Ptr<const SO> so_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outSOs ++;
+      GetStats (face).get<0> ().m_outSOs ++;
       if (so_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outSOs += so_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outSOs += so_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::InSOs   (Ptr<const SO> so_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inSOs ++;
+      GetStats (face).get<0> ().m_inSOs ++;
       if (so_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inSOs += so_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inSOs += so_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::DropSOs (Ptr<const SO> so_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropSOs ++;
+      GetStats (face).get<0> ().m_dropSOs ++;
       if (so_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropSOs += so_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropSOs += so_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::OutNULLps  (Ptr<const NULLp> null_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outNULLps ++;
+      GetStats (face).get<0> ().m_outNULLps ++;
       if (null_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outNULLps += null_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outNULLps += null_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::InNULLps   (Ptr<const NULLp> null_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inNULLps ++;
+      GetStats (face).get<0> ().m_inNULLps ++;
       if (null_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inNULLps += null_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inNULLps += null_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3AggregateTracer::DropNULLps (Ptr<const NULLp> null_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropNULLps ++;
+      GetStats (face).get<0> ().m_dropNULLps ++;
       if (null_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropNULLps += null_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropNULLps += null_p->GetWire ()->GetSize ();
 	}
     }
 
@@ -730,13 +834,16 @@ namespace ns3
     void
     L3AggregateTracer::Reset ()
     {
-      for (std::map<Ptr<const Face>, boost::tuple<Stats, Stats> >::iterator stats = m_stats.begin ();
+      for (std::vector<FaceStats>::iterator stats = m_stats.begin ();
 	  stats != m_stats.end ();
 	  stats++)
 	{
-	  stats->second.get<0> ().Reset ();
-	  stats->second.get<1> ().Reset ();
+	  stats->get<0> ().Reset ();
+	  stats->get<1> ().Reset ();
 	}
+
+      m_nodeStats.get<0> ().Reset ();
+      m_nodeStats.get<1> ().Reset ();
     }
 
     void
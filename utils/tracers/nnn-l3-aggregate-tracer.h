@@ -34,11 +34,13 @@
 #include <boost/shared_ptr.hpp>
 #include <map>
 #include <list>
+#include <vector>
 
 namespace ns3
 {
   namespace nnn
   {
+    class L3BinaryTraceWriter;
     /**
      * @ingroup nnn-tracers
      * @brief 3N network-layer tracer for aggregate packet counts
@@ -69,7 +71,8 @@ namespace ns3
        * @brief Helper method to install tracers on a specific simulation node
        *
        * @param nodes Nodes on which to install tracer
-       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param file File to which traces will be written.  If filename is -, then std::out is used.
+       *        If filename ends in .bin, the binary format of L3BinaryTraceWriter is used
        * @param averagingPeriod How often data will be written into the trace file (default, every half second)
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
@@ -83,7 +86,8 @@ namespace ns3
        * @brief Helper method to install tracers on the selected simulation nodes
        *
        * @param nodes Nodes on which to install tracer
-       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param file File to which traces will be written.  If filename is -, then std::out is used.
+       *        If filename ends in .bin, the binary format of L3BinaryTraceWriter is used
        * @param averagingPeriod How often data will be written into the trace file (default, every half second)
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
@@ -109,7 +113,11 @@ namespace ns3
       /**
        * @brief Helper method to install tracers on all simulation nodes
        *
-       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * Under the distributed simulator only the nodes of this rank are traced,
+       * into the file given by DistributedHelper::GetRankFileName
+       *
+       * @param file File to which traces will be written.  If filename is -, then std::out is used.
+       *        If filename ends in .bin, the binary format of L3BinaryTraceWriter is used
        * @param averagingPeriod How often data will be written into the trace file (default, every half second)
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
@@ -123,12 +131,19 @@ namespace ns3
        * @brief Explicit request to remove all statically created tracers
        *
        * This method can be helpful if simulation scenario contains several independent run,
-       * or if it is desired to do a postprocessing of the resulting data
+       * or if it is desired to do a postprocessing of the resulting data.
+       * It is also called by Simulator::Destroy
        */
       static void
       Destroy ();
 
     protected:
+      /**
+       * @brief Write the periodic output through a binary trace writer instead of as TSV
+       */
+      void
+      SetBinaryWriter (boost::shared_ptr<L3BinaryTraceWriter> writer);
+
       virtual void
       PrintHeader (std::ostream &os) const;
 
@@ -269,11 +284,20 @@ namespace ns3
 
     protected:
       boost::shared_ptr<std::ostream> m_os;
+      boost::shared_ptr<L3BinaryTraceWriter> m_binary;
 
       Time m_period;
       EventId m_printEvent;
 
-      mutable std::map<Ptr<const Face>, boost::tuple<Stats, Stats> > m_stats;
+      typedef boost::tuple<Stats, Stats> FaceStats;
+
+      FaceStats &
+      GetStats (Ptr<const Face> face) const;
+
+      mutable std::vector<Ptr<const Face> > m_faces; ///< \brief Faces seen so far, indexed by Face id
+      mutable std::vector<FaceStats> m_stats; ///< \brief Counters of each Face, indexed by Face id
+      mutable FaceStats m_nodeStats; ///< \brief Node wide counters
+      mutable bool m_hasNodeStats;
     };
   } /* namespace nnn */
 } /* namespace ns3 */
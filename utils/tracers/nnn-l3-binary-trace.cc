@@ -0,0 +1,387 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-l3-binary-trace.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-l3-binary-trace.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-l3-binary-trace.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "nnn-l3-binary-trace.h"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+
+#include "../../model/nnn-face.h"
+
+#include <cstring>
+#include <sstream>
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.L3BinaryTrace");
+
+  namespace nnn
+  {
+    static const char g_magic[8] = { 'N', 'N', 'N', 'L', '3', 'T', 'R', '1' };
+
+    static const uint8_t STRING_RECORD = 0x01;
+    static const uint8_t BLOCK_RECORD = 0x02;
+
+    static void
+    WriteVarint (std::ostream &os, uint64_t value)
+    {
+      while (value >= 0x80)
+	{
+	  os.put (static_cast<char> ((value & 0x7F) | 0x80));
+	  value >>= 7;
+	}
+      os.put (static_cast<char> (value));
+    }
+
+    static void
+    WriteZigzag (std::ostream &os, int64_t value)
+    {
+      WriteVarint (os, (static_cast<uint64_t> (value) << 1) ^ static_cast<uint64_t> (value >> 63));
+    }
+
+    static void
+    WriteDouble (std::ostream &os, double value)
+    {
+      uint64_t bits;
+      std::memcpy (&bits, &value, sizeof (bits));
+
+      for (int i = 0; i < 8; i++)
+	{
+	  os.put (static_cast<char> (bits & 0xFF));
+	  bits >>= 8;
+	}
+    }
+
+    static void
+    WriteString (std::ostream &os, const std::string &str)
+    {
+      WriteVarint (os, str.size ());
+      os.write (str.data (), str.size ());
+    }
+
+    static bool
+    ReadVarint (std::istream &is, uint64_t &value)
+    {
+      value = 0;
+      for (int shift = 0; shift < 64; shift += 7)
+	{
+	  int c = is.get ();
+	  if (c == std::char_traits<char>::eof ())
+	    return false;
+
+	  value |= static_cast<uint64_t> (c & 0x7F) << shift;
+	  if (!(c & 0x80))
+	    return true;
+	}
+      return false;
+    }
+
+    static bool
+    ReadZigzag (std::istream &is, int64_t &value)
+    {
+      uint64_t raw;
+      if (!ReadVarint (is, raw))
+	return false;
+
+      value = static_cast<int64_t> (raw >> 1) ^ -static_cast<int64_t> (raw & 1);
+      return true;
+    }
+
+    static bool
+    ReadDouble (std::istream &is, double &value)
+    {
+      unsigned char buf[8];
+      if (!is.read (reinterpret_cast<char *> (buf), 8))
+	return false;
+
+      uint64_t bits = 0;
+      for (int i = 7; i >= 0; i--)
+	{
+	  bits = (bits << 8) | buf[i];
+	}
+      std::memcpy (&value, &bits, sizeof (value));
+      return true;
+    }
+
+    static bool
+    ReadString (std::istream &is, std::string &str)
+    {
+      uint64_t len;
+      if (!ReadVarint (is, len))
+	return false;
+
+      str.resize (len);
+      if (len > 0 && !is.read (&str[0], len))
+	return false;
+
+      return true;
+    }
+
+    L3BinaryTraceWriter::L3BinaryTraceWriter (boost::shared_ptr<std::ostream> os, const std::string &header, uint32_t numValues)
+    : m_os (os)
+    , m_numValues (numValues)
+    , m_time (0)
+    , m_node (0)
+    , m_values (numValues)
+    {
+      m_os->write (g_magic, sizeof (g_magic));
+      WriteString (*m_os, header);
+      WriteVarint (*m_os, m_numValues);
+    }
+
+    L3BinaryTraceWriter::~L3BinaryTraceWriter ()
+    {
+      m_os->flush ();
+    }
+
+    bool
+    L3BinaryTraceWriter::IsBinaryFile (const std::string &file)
+    {
+      return file.size () > 4 && file.compare (file.size () - 4, 4, ".bin") == 0;
+    }
+
+    uint32_t
+    L3BinaryTraceWriter::Intern (const std::string &str)
+    {
+      std::map<std::string, uint32_t>::iterator it = m_strings.find (str);
+      if (it != m_strings.end ())
+	return it->second;
+
+      uint32_t id = m_strings.size ();
+      m_strings[str] = id;
+
+      m_os->put (STRING_RECORD);
+      WriteVarint (*m_os, id);
+      WriteString (*m_os, str);
+
+      return id;
+    }
+
+    void
+    L3BinaryTraceWriter::BeginBlock (double time, const std::string &node)
+    {
+      m_time = time;
+      m_node = Intern (node);
+
+      m_faceIds.clear ();
+      m_faceDescrs.clear ();
+      m_typeIds.clear ();
+      for (uint32_t i = 0; i < m_numValues; i++)
+	{
+	  m_values[i].clear ();
+	}
+    }
+
+    void
+    L3BinaryTraceWriter::AddRow (Ptr<const Face> face, const char *type, const double *values)
+    {
+      // Face descriptions are only formatted the first time the Face is seen.
+      // Face ids are never reused within a node, unlike the addresses of
+      // freed Faces, so the node wide counters get a key no Face can have
+      std::pair<uint32_t, uint32_t> key (~0U, ~0U);
+      if (face)
+	key = std::make_pair (face->GetNode ()->GetId (), face->GetId ());
+
+      std::map<std::pair<uint32_t, uint32_t>, uint32_t>::iterator descr = m_faces.find (key);
+      if (descr == m_faces.end ())
+	{
+	  std::ostringstream os;
+	  if (face)
+	    os << *face;
+	  else
+	    os << "all";
+
+	  descr = m_faces.insert (std::make_pair (key, Intern (os.str ()))).first;
+	}
+
+      std::map<const char *, uint32_t>::iterator typeId = m_types.find (type);
+      if (typeId == m_types.end ())
+	{
+	  typeId = m_types.insert (std::make_pair (type, Intern (type))).first;
+	}
+
+      m_faceIds.push_back (face ? static_cast<int64_t> (face->GetId ()) : -1);
+      m_faceDescrs.push_back (descr->second);
+      m_typeIds.push_back (typeId->second);
+      for (uint32_t i = 0; i < m_numValues; i++)
+	{
+	  m_values[i].push_back (values[i]);
+	}
+    }
+
+    void
+    L3BinaryTraceWriter::EndBlock ()
+    {
+      if (m_typeIds.empty ())
+	return;
+
+      std::ostream &os = *m_os;
+
+      os.put (BLOCK_RECORD);
+      WriteDouble (os, m_time);
+      WriteVarint (os, m_node);
+      WriteVarint (os, m_typeIds.size ());
+
+      int64_t prev = 0;
+      for (size_t i = 0; i < m_faceIds.size (); i++)
+	{
+	  WriteZigzag (os, m_faceIds[i] - prev);
+	  prev = m_faceIds[i];
+	}
+
+      prev = 0;
+      for (size_t i = 0; i < m_faceDescrs.size (); i++)
+	{
+	  WriteZigzag (os, static_cast<int64_t> (m_faceDescrs[i]) - prev);
+	  prev = m_faceDescrs[i];
+	}
+
+      for (size_t i = 0; i < m_typeIds.size (); i++)
+	{
+	  WriteVarint (os, m_typeIds[i]);
+	}
+
+      for (uint32_t col = 0; col < m_numValues; col++)
+	{
+	  for (size_t i = 0; i < m_values[col].size (); i++)
+	    {
+	      WriteDouble (os, m_values[col][i]);
+	    }
+	}
+    }
+
+    bool
+    L3BinaryTraceReader::ConvertToTsv (std::istream &is, std::ostream &os)
+    {
+      char magic[sizeof (g_magic)];
+      if (!is.read (magic, sizeof (magic)) || std::memcmp (magic, g_magic, sizeof (magic)) != 0)
+	{
+	  NS_LOG_ERROR ("Not a nnnSIM binary L3 trace");
+	  return false;
+	}
+
+      std::string header;
+      uint64_t numValues;
+      if (!ReadString (is, header) || !ReadVarint (is, numValues))
+	return false;
+
+      os << header << "\n";
+
+      std::vector<std::string> strings;
+      std::vector<int64_t> faceIds;
+      std::vector<int64_t> faceDescrs;
+      std::vector<uint64_t> typeIds;
+      std::vector<std::vector<double> > values (numValues);
+
+      while (true)
+	{
+	  int tag = is.get ();
+	  if (tag == std::char_traits<char>::eof ())
+	    return true;
+
+	  if (tag == STRING_RECORD)
+	    {
+	      uint64_t id;
+	      std::string str;
+	      if (!ReadVarint (is, id) || !ReadString (is, str))
+		return false;
+
+	      if (id >= strings.size ())
+		strings.resize (id + 1);
+	      strings[id] = str;
+	    }
+	  else if (tag == BLOCK_RECORD)
+	    {
+	      double time;
+	      uint64_t node, rows;
+	      if (!ReadDouble (is, time) || !ReadVarint (is, node) || !ReadVarint (is, rows))
+		return false;
+
+	      faceIds.resize (rows);
+	      faceDescrs.resize (rows);
+	      typeIds.resize (rows);
+
+	      int64_t prev = 0;
+	      for (uint64_t i = 0; i < rows; i++)
+		{
+		  if (!ReadZigzag (is, faceIds[i]))
+		    return false;
+		  faceIds[i] += prev;
+		  prev = faceIds[i];
+		}
+
+	      prev = 0;
+	      for (uint64_t i = 0; i < rows; i++)
+		{
+		  if (!ReadZigzag (is, faceDescrs[i]))
+		    return false;
+		  faceDescrs[i] += prev;
+		  prev = faceDescrs[i];
+		}
+
+	      for (uint64_t i = 0; i < rows; i++)
+		{
+		  if (!ReadVarint (is, typeIds[i]))
+		    return false;
+		}
+
+	      for (uint64_t col = 0; col < numValues; col++)
+		{
+		  values[col].resize (rows);
+		  for (uint64_t i = 0; i < rows; i++)
+		    {
+		      if (!ReadDouble (is, values[col][i]))
+			return false;
+		    }
+		}
+
+	      if (node >= strings.size ())
+		return false;
+
+	      for (uint64_t i = 0; i < rows; i++)
+		{
+		  if (static_cast<uint64_t> (faceDescrs[i]) >= strings.size () || typeIds[i] >= strings.size ())
+		    return false;
+
+		  os << time << "\t"
+		      << strings[node] << "\t"
+		      << faceIds[i] << "\t"
+		      << strings[faceDescrs[i]] << "\t"
+		      << strings[typeIds[i]];
+
+		  for (uint64_t col = 0; col < numValues; col++)
+		    {
+		      os << "\t" << values[col][i];
+		    }
+		  os << "\n";
+		}
+	    }
+	  else
+	    {
+	      NS_LOG_ERROR ("Unknown record " << tag << " in binary L3 trace");
+	      return false;
+	    }
+	}
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-l3-binary-trace.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-l3-binary-trace.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-l3-binary-trace.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_L3_BINARY_TRACE_H_
+#define NNN_L3_BINARY_TRACE_H_
+
+#include "ns3/ptr.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <stdint.h>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    class Face;
+
+    /**
+     * @brief Writer for the binary output of L3RateTracer and L3AggregateTracer
+     *
+     * The file starts with the magic string, the TSV header of the tracer and
+     * the number of value columns. It is followed by records:
+     *
+     *  - String record: tag 0x01, varint id, varint length, bytes. Every node
+     *    name, face description and PDU type is written once and then referred
+     *    to by its id.
+     *  - Block record: tag 0x02, one per tracer per period. Time (8 byte
+     *    double), varint node id, varint row count, followed by the rows stored
+     *    column by column: face ids and face description ids as zigzag varint
+     *    deltas from the previous row, type ids as varints and every value
+     *    column as fixed width 8 byte doubles.
+     *
+     * All multi-byte fields are little endian. L3BinaryTraceReader converts the
+     * file back to the TSV the tracers write in text mode.
+     */
+    class L3BinaryTraceWriter
+    {
+    public:
+      /**
+       * @param os output stream, should be opened in binary mode
+       * @param header TSV header of the tracer, as written by PrintHeader
+       * @param numValues number of value columns in each row
+       */
+      L3BinaryTraceWriter (boost::shared_ptr<std::ostream> os, const std::string &header, uint32_t numValues);
+
+      ~L3BinaryTraceWriter ();
+
+      /**
+       * @brief Whether a trace file name requests the binary format (ends in .bin)
+       */
+      static bool
+      IsBinaryFile (const std::string &file);
+
+      void
+      BeginBlock (double time, const std::string &node);
+
+      /**
+       * @brief Add one row to the current block
+       *
+       * @param face Face of the counters, 0 for the node wide counters
+       * @param type name of the counter, must be a string literal
+       * @param values numValues values of the row
+       */
+      void
+      AddRow (Ptr<const Face> face, const char *type, const double *values);
+
+      void
+      EndBlock ();
+
+    private:
+      uint32_t
+      Intern (const std::string &str);
+
+      boost::shared_ptr<std::ostream> m_os;
+      uint32_t m_numValues;
+
+      std::map<std::string, uint32_t> m_strings;
+      std::map<const char *, uint32_t> m_types;
+      std::map<std::pair<uint32_t, uint32_t>, uint32_t> m_faces; ///< @brief Description ids by (node id, face id)
+
+      // Current block, stored column by column
+      double m_time;
+      uint32_t m_node;
+      std::vector<int64_t> m_faceIds;
+      std::vector<uint32_t> m_faceDescrs;
+      std::vector<uint32_t> m_typeIds;
+      std::vector<std::vector<double> > m_values;
+    };
+
+    /**
+     * @brief Reader for the files written by L3BinaryTraceWriter
+     */
+    class L3BinaryTraceReader
+    {
+    public:
+      /**
+       * @brief Convert a binary trace to the TSV written by the tracers in text mode
+       *
+       * @param is binary trace
+       * @param os destination of the TSV
+       *
+       * @returns false if the input is not a valid binary trace
+       */
+      static bool
+      ConvertToTsv (std::istream &is, std::ostream &os);
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_L3_BINARY_TRACE_H_ */
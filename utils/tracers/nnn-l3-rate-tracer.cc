@@ -22,6 +22,8 @@
  */
 
 #include "nnn-l3-rate-tracer.h"
+#include "nnn-tracer-streams.h"
+#include "nnn-l3-binary-trace.h"
 
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -37,7 +39,10 @@
 #include "../../model/nnn-face.h"
 #include "../../model/pit/nnn-pit-entry.h"
 
+#include "../../helper/nnn-distributed-helper.h"
+
 #include <fstream>
+#include <sstream>
 #include <boost/lexical_cast.hpp>
 
 using namespace boost;
@@ -49,7 +54,8 @@ namespace ns3
 
   namespace nnn
   {
-    static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer> > > > g_tracers;
+    // Released with the simulator, see KeepTracers
+    static TracerStreams<L3RateTracer>::List g_tracers;
 
     template<class T>
     static inline void
@@ -57,9 +63,33 @@ namespace ns3
     {
     }
 
+    // Write the TSV header, or hand the tracers a shared binary writer if the file ends in .bin
+    static void
+    StartOutput (const std::string &file, boost::shared_ptr<std::ostream> outputStream, std::list<Ptr<L3RateTracer> > &tracers)
+    {
+      if (L3BinaryTraceWriter::IsBinaryFile (file))
+	{
+	  std::ostringstream header;
+	  tracers.front ()->PrintHeader (header);
+
+	  boost::shared_ptr<L3BinaryTraceWriter> writer (new L3BinaryTraceWriter (outputStream, header.str (), 4));
+	  for (std::list<Ptr<L3RateTracer> >::iterator trace = tracers.begin (); trace != tracers.end (); trace++)
+	    {
+	      (*trace)->SetBinaryWriter (writer);
+	    }
+	}
+      else
+	{
+	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
+	  tracers.front ()->PrintHeader (*outputStream);
+	  *outputStream << "\n";
+	}
+    }
+
     L3RateTracer::L3RateTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
     : L3Tracer (node)
     , m_os (os)
+    , m_hasNodeStats (false)
     {
       SetAveragingPeriod (Seconds (1.0));
     }
@@ -67,6 +97,7 @@ namespace ns3
     L3RateTracer::L3RateTracer (boost::shared_ptr<std::ostream> os, const std::string &node)
     : L3Tracer (node)
     , m_os (os)
+    , m_hasNodeStats (false)
     {
       SetAveragingPeriod (Seconds (1.0));
     }
@@ -84,7 +115,10 @@ namespace ns3
       if (file != "-")
 	{
 	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+	  std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+	  if (L3BinaryTraceWriter::IsBinaryFile (file))
+	    mode |= std::ios_base::binary;
+	  os->open (DistributedHelper::GetRankFileName (file).c_str (), mode);
 
 	  if (!os->is_open ())
 	    {
@@ -103,18 +137,19 @@ namespace ns3
 	  node != NodeList::End ();
 	  node++)
 	{
+	  if (!DistributedHelper::IsLocal (*node))
+	    continue;
+
 	  Ptr<L3RateTracer> trace = Install (*node, outputStream, averagingPeriod);
 	  tracers.push_back (trace);
 	}
 
       if (tracers.size () > 0)
 	{
-	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  StartOutput (file, outputStream, tracers);
 	}
 
-      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+      KeepTracers (g_tracers, outputStream, tracers);
     }
 
     void
@@ -128,7 +163,10 @@ namespace ns3
       if (file != "-")
 	{
 	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+	  std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+	  if (L3BinaryTraceWriter::IsBinaryFile (file))
+	    mode |= std::ios_base::binary;
+	  os->open (DistributedHelper::GetRankFileName (file).c_str (), mode);
 
 	  if (!os->is_open ())
 	    {
@@ -147,23 +185,28 @@ namespace ns3
 	  node != nodes.End ();
 	  node++)
 	{
+	  if (!DistributedHelper::IsLocal (*node))
+	    continue;
+
 	  Ptr<L3RateTracer> trace = Install (*node, outputStream, averagingPeriod);
 	  tracers.push_back (trace);
 	}
 
       if (tracers.size () > 0)
 	{
-	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  StartOutput (file, outputStream, tracers);
 	}
 
-      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+      KeepTracers (g_tracers, outputStream, tracers);
     }
 
     void
     L3RateTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
     {
+      // Simulated, and traced, by another rank
+      if (!DistributedHelper::IsLocal (node))
+	return;
+
       using namespace boost;
       using namespace std;
 
@@ -172,7 +215,10 @@ namespace ns3
       if (file != "-")
 	{
 	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+	  std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+	  if (L3BinaryTraceWriter::IsBinaryFile (file))
+	    mode |= std::ios_base::binary;
+	  os->open (DistributedHelper::GetRankFileName (file).c_str (), mode);
 
 	  if (!os->is_open ())
 	    {
@@ -192,17 +238,21 @@ namespace ns3
 
       if (tracers.size () > 0)
 	{
-	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  StartOutput (file, outputStream, tracers);
 	}
 
-      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+      KeepTracers (g_tracers, outputStream, tracers);
     }
 
     void
     L3RateTracer::Destroy ()
     {
+      for (TracerStreams<L3RateTracer>::List::iterator i = g_tracers.begin ();
+	  i != g_tracers.end (); i++)
+	{
+	  i->get<0> ()->flush ();
+	}
+
       g_tracers.clear ();
     }
 
@@ -235,20 +285,28 @@ namespace ns3
 	  << "KilobytesRaw";
     }
 
-#define STATS(INDEX) stats->second.get<INDEX> ()
+#define STATS(INDEX) stats.get<INDEX> ()
 #define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble (Time::S)
 
 #define PRINTER(printName, fieldName) \
     STATS(2).fieldName = /*new value*/alpha * RATE(0, fieldName) + /*old value*/(1-alpha) * STATS(2).fieldName; \
     STATS(3).fieldName = /*new value*/alpha * RATE(1, fieldName) / 1024.0 + /*old value*/(1-alpha) * STATS(3).fieldName; \
     \
+    if (m_binary)                                                         \
+    {                                                                   \
+	double values[] = { STATS(2).fieldName, STATS(3).fieldName,       \
+	    STATS(0).fieldName, STATS(1).fieldName / 1024.0 };            \
+	m_binary->AddRow (face, printName, values);                       \
+    }                                                                   \
+    else                                                                  \
+    {                                                                   \
     os << time.ToDouble (Time::S) << "\t"                                 \
     << m_node << "\t";                                                    \
-    if (stats->first)                                                     \
+    if (face)                                                             \
     {                                                                   \
 	os                                                                \
-	<< stats->first->GetId () << "\t"                               \
-	<< *stats->first << "\t";                                       \
+	<< face->GetId () << "\t"                                       \
+	<< *face << "\t";                                               \
     }                                                                   \
     else                                                                  \
     {                                                                   \
@@ -259,22 +317,70 @@ namespace ns3
     << STATS(2).fieldName << "\t"                                         \
     << STATS(3).fieldName << "\t"                                         \
     << STATS(0).fieldName << "\t"                                         \
-    << STATS(1).fieldName / 1024.0 << "\n";
+    << STATS(1).fieldName / 1024.0 << "\n";                               \
+    }
 
     const double alpha = 0.8;
 
+    L3RateTracer::FaceStats &
+    L3RateTracer::GetStats (Ptr<const Face> face) const
+    {
+      if (face == 0)
+	{
+	  if (!m_hasNodeStats)
+	    {
+	      m_nodeStats.get<0> ().Reset ();
+	      m_nodeStats.get<1> ().Reset ();
+	      m_nodeStats.get<2> ().Reset ();
+	      m_nodeStats.get<3> ().Reset ();
+	      m_hasNodeStats = true;
+	    }
+	  return m_nodeStats;
+	}
+
+      // Face ids are handed out sequentially by the L3Protocol, so the vectors stay dense
+      uint32_t id = face->GetId ();
+      if (id >= m_stats.size ())
+	{
+	  m_faces.resize (id + 1);
+	  m_stats.resize (id + 1);
+	}
+
+      if (m_faces[id] != face)
+	{
+	  m_faces[id] = face;
+	  m_stats[id].get<0> ().Reset ();
+	  m_stats[id].get<1> ().Reset ();
+	  m_stats[id].get<2> ().Reset ();
+	  m_stats[id].get<3> ().Reset ();
+	}
+
+      return m_stats[id];
+    }
+
+    void
+    L3RateTracer::SetBinaryWriter (boost::shared_ptr<L3BinaryTraceWriter> writer)
+    {
+      m_binary = writer;
+    }
+
     void
     L3RateTracer::Print (std::ostream &os) const
     {
       Time time = Simulator::Now ();
 
-      for (std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> >::iterator stats = m_stats.begin ();
-	  stats != m_stats.end ();
-	  stats++)
+      // In binary mode, all the rows of this period go into one block
+      if (m_binary)
+	m_binary->BeginBlock (time.ToDouble (Time::S), m_node);
+
+      for (uint32_t id = 0; id < m_stats.size (); id++)
 	{
-	  if (!stats->first)
+	  Ptr<const Face> face = m_faces[id];
+	  if (!face)
 	    continue;
 
+	  FaceStats &stats = m_stats[id];
+
 	  PRINTER ("InInterests",   m_inInterests);
 	  PRINTER ("OutInterests",  m_outInterests);
 	  PRINTER ("DropInterests", m_dropInterests);
@@ -330,73 +436,76 @@ namespace ns3
 	  PRINTER ("DropINFs", m_dropINFs);
 	}
 
-      {
-	std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> >::iterator stats = m_stats.find (Ptr<const Face> (0));
-	if (stats != m_stats.end ())
-	  {
-	    PRINTER ("SatisfiedInterests", m_satisfiedInterests);
-	    PRINTER ("TimedOutInterests", m_timedOutInterests);
-	  }
-      }
+      if (m_hasNodeStats)
+	{
+	  Ptr<const Face> face = 0;
+	  FaceStats &stats = m_nodeStats;
+
+	  PRINTER ("SatisfiedInterests", m_satisfiedInterests);
+	  PRINTER ("TimedOutInterests", m_timedOutInterests);
+	}
+
+      if (m_binary)
+	m_binary->EndBlock ();
     }
 
     void
     L3RateTracer::OutInterests  (Ptr<const Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outInterests ++;
+      GetStats (face).get<0> ().m_outInterests ++;
       if (interest->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outInterests += interest->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outInterests += interest->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InInterests   (Ptr<const Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inInterests ++;
+      GetStats (face).get<0> ().m_inInterests ++;
       if (interest->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inInterests += interest->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inInterests += interest->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropInterests (Ptr<const Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropInterests ++;
+      GetStats (face).get<0> ().m_dropInterests ++;
       if (interest->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropInterests += interest->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropInterests += interest->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::OutNacks  (Ptr<const Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outNacks ++;
+      GetStats (face).get<0> ().m_outNacks ++;
       if (interest->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outNacks += interest->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outNacks += interest->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InNacks   (Ptr<const Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inNacks ++;
+      GetStats (face).get<0> ().m_inNacks ++;
       if (interest->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inNacks += interest->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inNacks += interest->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropNacks (Ptr<const Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropNacks ++;
+      GetStats (face).get<0> ().m_dropNacks ++;
       if (interest->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropNacks += interest->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropNacks += interest->GetWire ()->GetSize ();
 	}
     }
 
@@ -404,10 +513,10 @@ namespace ns3
     L3RateTracer::OutData  (Ptr<const Data> data,
                             bool fromCache, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outData ++;
+      GetStats (face).get<0> ().m_outData ++;
       if (data->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outData += data->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outData += data->GetWire ()->GetSize ();
 	}
     }
 
@@ -415,10 +524,10 @@ namespace ns3
     L3RateTracer::InData   (Ptr<const Data> data,
                             Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inData ++;
+      GetStats (face).get<0> ().m_inData ++;
       if (data->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inData += data->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inData += data->GetWire ()->GetSize ();
 	}
     }
 
@@ -426,52 +535,52 @@ namespace ns3
     L3RateTracer::DropData (Ptr<const Data> data,
                             Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropData ++;
+      GetStats (face).get<0> ().m_dropData ++;
       if (data->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropData += data->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropData += data->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::SatisfiedInterests (Ptr<const pit::Entry> entry)
     {
-      m_stats[0].get<0> ().m_satisfiedInterests ++;
+      GetStats (0).get<0> ().m_satisfiedInterests ++;
       // no "size" stats
 
       for (pit::Entry::in_container::const_iterator i = entry->GetIncoming ().begin ();
 	  i != entry->GetIncoming ().end ();
 	  i++)
 	{
-	  m_stats[i->m_face].get<0> ().m_satisfiedInterests ++;
+	  GetStats (i->m_face).get<0> ().m_satisfiedInterests ++;
 	}
 
       for (pit::Entry::out_container::const_iterator i = entry->GetOutgoing ().begin ();
 	  i != entry->GetOutgoing ().end ();
 	  i++)
 	{
-	  m_stats[i->m_face].get<0> ().m_outSatisfiedInterests ++;
+	  GetStats (i->m_face).get<0> ().m_outSatisfiedInterests ++;
 	}
     }
 
     void
     L3RateTracer::TimedOutInterests (Ptr<const pit::Entry> entry)
     {
-      m_stats[0].get<0> ().m_timedOutInterests ++;
+      GetStats (0).get<0> ().m_timedOutInterests ++;
       // no "size" stats
 
       for (pit::Entry::in_container::const_iterator i = entry->GetIncoming ().begin ();
 	  i != entry->GetIncoming ().end ();
 	  i++)
 	{
-	  m_stats[i->m_face].get<0> ().m_timedOutInterests ++;
+	  GetStats (i->m_face).get<0> ().m_timedOutInterests ++;
 	}
 
       for (pit::Entry::out_container::const_iterator i = entry->GetOutgoing ().begin ();
 	  i != entry->GetOutgoing ().end ();
 	  i++)
 	{
-	  m_stats[i->m_face].get<0> ().m_outTimedOutInterests ++;
+	  GetStats (i->m_face).get<0> ().m_outTimedOutInterests ++;
 	}
     }
 
@@ -495,313 +604,316 @@ namespace ns3
     void
     L3RateTracer::OutAENs  (Ptr<const AEN> aen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outAENs ++;
+      GetStats (face).get<0> ().m_outAENs ++;
       if (aen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outAENs += aen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outAENs += aen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InAENs   (Ptr<const AEN> aen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inAENs ++;
+      GetStats (face).get<0> ().m_inAENs ++;
       if (aen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inAENs += aen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inAENs += aen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropAENs (Ptr<const AEN> aen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropAENs ++;
+      GetStats (face).get<0> ().m_dropAENs ++;
       if (aen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropAENs += aen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropAENs += aen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::OutDENs  (Ptr<const DEN> den_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outDENs ++;
+      GetStats (face).get<0> ().m_outDENs ++;
       if (den_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outDENs += den_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outDENs += den_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InDENs   (Ptr<const DEN> den_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inDENs ++;
+      GetStats (face).get<0> ().m_inDENs ++;
       if (den_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inDENs += den_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inDENs += den_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropDENs (Ptr<const DEN> den_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropDENs ++;
+      GetStats (face).get<0> ().m_dropDENs ++;
       if (den_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropDENs += den_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropDENs += den_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::OutENs  (Ptr<const EN> en_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outENs ++;
+      GetStats (face).get<0> ().m_outENs ++;
       if (en_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outENs += en_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outENs += en_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InENs   (Ptr<const EN> en_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inENs ++;
+      GetStats (face).get<0> ().m_inENs ++;
       if (en_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inENs += en_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inENs += en_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropENs (Ptr<const EN> en_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropENs ++;
+      GetStats (face).get<0> ().m_dropENs ++;
       if (en_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropENs += en_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropENs += en_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::OutOENs  (Ptr<const OEN> oen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outOENs ++;
+      GetStats (face).get<0> ().m_outOENs ++;
       if (oen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outOENs += oen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outOENs += oen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InOENs   (Ptr<const OEN> oen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inOENs ++;
+      GetStats (face).get<0> ().m_inOENs ++;
       if (oen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inOENs += oen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inOENs += oen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropOENs (Ptr<const OEN> oen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropOENs ++;
+      GetStats (face).get<0> ().m_dropOENs ++;
       if (oen_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropENs += oen_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropENs += oen_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::OutRENs  (Ptr<const REN> ren_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outRENs ++;
+      GetStats (face).get<0> ().m_outRENs ++;
       if (ren_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outRENs += ren_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outRENs += ren_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InRENs   (Ptr<const REN> ren_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inRENs ++;
+      GetStats (face).get<0> ().m_inRENs ++;
       if (ren_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inRENs += ren_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inRENs += ren_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropRENs (Ptr<const REN> ren_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropRENs ++;
+      GetStats (face).get<0> ().m_dropRENs ++;
       if (ren_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropRENs += ren_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropRENs += ren_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::OutINFs  (Ptr<const INF> inf_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outINFs ++;
+      GetStats (face).get<0> ().m_outINFs ++;
       if (inf_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outINFs += inf_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outINFs += inf_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InINFs   (Ptr<const INF> inf_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inINFs ++;
+      GetStats (face).get<0> ().m_inINFs ++;
       if (inf_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inINFs += inf_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inINFs += inf_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropINFs (Ptr<const INF> inf_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropINFs ++;
+      GetStats (face).get<0> ().m_dropINFs ++;
       if (inf_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropINFs += inf_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropINFs += inf_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::OutDOs  (Ptr<const DO> do_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outDOs ++;
+      GetStats (face).get<0> ().m_outDOs ++;
       if (do_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outDOs += do_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outDOs += do_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InDOs   (Ptr<const DO> do_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inDOs ++;
+      GetStats (face).get<0> ().m_inDOs ++;
       if (do_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inDOs += do_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inDOs += do_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropDOs (Ptr<const DO> do_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropDOs ++;
+      GetStats (face).get<0> ().m_dropDOs ++;
       if (do_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropDOs += do_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropDOs += do_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::OutDUs  (Ptr<const DU> du_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outDUs ++;
+      GetStats (face).get<0> ().m_outDUs ++;
       if (du_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outDUs += du_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outDUs += du_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InDUs   (Ptr<const DU> du_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inDUs ++;
+      GetStats (face).get<0> ().m_inDUs ++;
       if (du_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inDUs += du_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inDUs += du_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropDUs (Ptr<const DU> du_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropDUs ++;
+      GetStats (face).get<0> ().m_dropDUs ++;
       if (du_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropDUs += du_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropDUs += du_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::OutSOs  (Ptr<const SO> so_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outSOs ++;
+      GetStats (face).get<0> ().m_outSOs ++;
       if (so_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outSOs += so_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outSOs += so_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InSOs   (Ptr<const SO> so_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inSOs ++;
+      GetStats (face).get<0> ().m_inSOs ++;
       if (so_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inSOs += so_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inSOs += so_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropSOs (Ptr<const SO> so_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropSOs ++;
+      GetStats (face).get<0> ().m_dropSOs ++;
       if (so_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropSOs += so_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropSOs += so_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::OutNULLps  (Ptr<const NULLp> null_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outNULLps ++;
+      GetStats (face).get<0> ().m_outNULLps ++;
       if (null_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outNULLps += null_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_outNULLps += null_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::InNULLps   (Ptr<const NULLp> null_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inNULLps ++;
+      GetStats (face).get<0> ().m_inNULLps ++;
       if (null_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_inNULLps += null_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_inNULLps += null_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::DropNULLps (Ptr<const NULLp> null_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropNULLps ++;
+      GetStats (face).get<0> ().m_dropNULLps ++;
       if (null_p->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_dropNULLps += null_p->GetWire ()->GetSize ();
+	  GetStats (face).get<1> ().m_dropNULLps += null_p->GetWire ()->GetSize ();
 	}
     }
 
     void
     L3RateTracer::Reset ()
     {
-      for (std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> >::iterator stats = m_stats.begin ();
+      for (std::vector<FaceStats>::iterator stats = m_stats.begin ();
 	  stats != m_stats.end ();
 	  stats++)
 	{
-	  stats->second.get<0> ().Reset ();
-	  stats->second.get<1> ().Reset ();
+	  stats->get<0> ().Reset ();
+	  stats->get<1> ().Reset ();
 	}
+
+      m_nodeStats.get<0> ().Reset ();
+      m_nodeStats.get<1> ().Reset ();
     }
   } /* namespace nnn */
 } /* namespace ns3 */
@@ -34,11 +34,13 @@
 #include <boost/shared_ptr.hpp>
 #include <map>
 #include <list>
+#include <vector>
 
 namespace ns3
 {
   namespace nnn
   {
+    class L3BinaryTraceWriter;
 
     class L3RateTracer : public L3Tracer
     {
@@ -65,7 +67,11 @@ namespace ns3
       /**
        * @brief Helper method to install tracers on all simulation nodes
        *
-       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * Under the distributed simulator only the nodes of this rank are traced,
+       * into the file given by DistributedHelper::GetRankFileName
+       *
+       * @param file File to which traces will be written.  If filename is -, then std::out is used.
+       *        If filename ends in .bin, the binary format of L3BinaryTraceWriter is used
        * @param averagingPeriod Defines averaging period for the rate calculation,
        *        as well as how often data will be written into the trace file (default, every half second)
        */
@@ -76,7 +82,8 @@ namespace ns3
        * @brief Helper method to install tracers on the selected simulation nodes
        *
        * @param nodes Nodes on which to install tracer
-       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param file File to which traces will be written.  If filename is -, then std::out is used.
+       *        If filename ends in .bin, the binary format of L3BinaryTraceWriter is used
        * @param averagingPeriod How often data will be written into the trace file (default, every half second)
        */
       static void
@@ -86,7 +93,8 @@ namespace ns3
        * @brief Helper method to install tracers on a specific simulation node
        *
        * @param nodes Nodes on which to install tracer
-       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param file File to which traces will be written.  If filename is -, then std::out is used.
+       *        If filename ends in .bin, the binary format of L3BinaryTraceWriter is used
        * @param averagingPeriod How often data will be written into the trace file (default, every half second)
        */
       static void
@@ -96,7 +104,8 @@ namespace ns3
        * @brief Explicit request to remove all statically created tracers
        *
        * This method can be helpful if simulation scenario contains several independent run,
-       * or if it is desired to do a postprocessing of the resulting data
+       * or if it is desired to do a postprocessing of the resulting data.
+       * It is also called by Simulator::Destroy
        */
       static void
       Destroy ();
@@ -114,6 +123,12 @@ namespace ns3
       static Ptr<L3RateTracer>
       Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream, Time averagingPeriod = Seconds (0.5));
 
+      /**
+       * @brief Write the periodic output through a binary trace writer instead of as TSV
+       */
+      void
+      SetBinaryWriter (boost::shared_ptr<L3BinaryTraceWriter> writer);
+
       // from L3Tracer
       virtual void
       PrintHeader (std::ostream &os) const;
@@ -258,10 +273,19 @@ namespace ns3
 
     private:
         boost::shared_ptr<std::ostream> m_os;
+        boost::shared_ptr<L3BinaryTraceWriter> m_binary;
         Time m_period;
         EventId m_printEvent;
 
-        mutable std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> > m_stats;
+        typedef boost::tuple<Stats, Stats, Stats, Stats> FaceStats;
+
+        FaceStats &
+        GetStats (Ptr<const Face> face) const;
+
+        mutable std::vector<Ptr<const Face> > m_faces; ///< \brief Faces seen so far, indexed by Face id
+        mutable std::vector<FaceStats> m_stats; ///< \brief Counters of each Face, indexed by Face id
+        mutable FaceStats m_nodeStats; ///< \brief Node wide counters
+        mutable bool m_hasNodeStats;
     };
 
   } /* namespace nnn */
@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-table-stats-tracer.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-table-stats-tracer.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-table-stats-tracer.cc. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#include "nnn-table-stats-tracer.h"
+#include "nnn-tracer-streams.h"
+
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "../nnn-table-stats-probe.h"
+
+#include "../../helper/nnn-distributed-helper.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("nnn.TableStatsTracer");
+
+  namespace nnn
+  {
+    // Released with the simulator, see KeepTracers
+    static TracerStreams<TableStatsTracer>::List g_tracers;
+
+    template<class T>
+    static inline void
+    NullDeleter (T *ptr)
+    {
+    }
+
+    // Stream for the file, std::cout for "-", or none if the file cannot be opened.
+    // std::cout is held with NullDeleter, so clearing g_tracers in Destroy
+    // only closes the files
+    static boost::shared_ptr<std::ostream>
+    OpenOutput (const std::string &file)
+    {
+      if (file == "-")
+	return boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
+
+      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
+      os->open (DistributedHelper::GetRankFileName (file).c_str (), std::ios_base::out | std::ios_base::trunc);
+
+      if (!os->is_open ())
+	{
+	  NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
+	  return boost::shared_ptr<std::ostream> ();
+	}
+
+      return os;
+    }
+
+    static void
+    StartOutput (boost::shared_ptr<std::ostream> outputStream, const std::list<Ptr<TableStatsTracer> > &tracers)
+    {
+      if (tracers.size () > 0)
+	{
+	  tracers.front ()->PrintHeader (*outputStream);
+	  *outputStream << "\n";
+	}
+
+      KeepTracers (g_tracers, outputStream, tracers);
+    }
+
+    TableStatsTracer::TableStatsTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node, Time period)
+    : m_os (os)
+    {
+      m_node = boost::lexical_cast<std::string> (node->GetId ());
+
+      std::string name = Names::FindName (node);
+      if (!name.empty ())
+	{
+	  m_node = name;
+	}
+
+      TableStatsProbe::Install (node, period)->TraceConnectWithoutContext ("Stats", MakeCallback (&TableStatsTracer::Stats, this));
+    }
+
+    TableStatsTracer::~TableStatsTracer ()
+    {
+    }
+
+    void
+    TableStatsTracer::Install (Ptr<Node> node, const std::string &file, Time period/* = Seconds (1.0)*/)
+    {
+      // Simulated, and traced, by another rank
+      if (!DistributedHelper::IsLocal (node))
+	return;
+
+      boost::shared_ptr<std::ostream> outputStream = OpenOutput (file);
+      if (!outputStream)
+	return;
+
+      std::list<Ptr<TableStatsTracer> > tracers;
+      tracers.push_back (Install (node, outputStream, period));
+
+      StartOutput (outputStream, tracers);
+    }
+
+    void
+    TableStatsTracer::Install (const NodeContainer &nodes, const std::string &file, Time period/* = Seconds (1.0)*/)
+    {
+      boost::shared_ptr<std::ostream> outputStream = OpenOutput (file);
+      if (!outputStream)
+	return;
+
+      std::list<Ptr<TableStatsTracer> > tracers;
+      for (NodeContainer::Iterator node = nodes.Begin ();
+	  node != nodes.End ();
+	  ++node)
+	{
+	  if (!DistributedHelper::IsLocal (*node))
+	    continue;
+
+	  tracers.push_back (Install (*node, outputStream, period));
+	}
+
+      StartOutput (outputStream, tracers);
+    }
+
+    Ptr<TableStatsTracer>
+    TableStatsTracer::Install (Ptr<Node> node,
+			       boost::shared_ptr<std::ostream> outputStream,
+			       Time period/* = Seconds (1.0)*/)
+    {
+      NS_LOG_DEBUG ("Node: " << node->GetId ());
+
+      return Create<TableStatsTracer> (outputStream, node, period);
+    }
+
+    void
+    TableStatsTracer::InstallAll (const std::string &file, Time period/* = Seconds (1.0)*/)
+    {
+      boost::shared_ptr<std::ostream> outputStream = OpenOutput (file);
+      if (!outputStream)
+	return;
+
+      std::list<Ptr<TableStatsTracer> > tracers;
+      for (NodeList::Iterator node = NodeList::Begin ();
+	  node != NodeList::End ();
+	  ++node)
+	{
+	  if (!DistributedHelper::IsLocal (*node))
+	    continue;
+
+	  tracers.push_back (Install (*node, outputStream, period));
+	}
+
+      StartOutput (outputStream, tracers);
+    }
+
+    void
+    TableStatsTracer::Destroy ()
+    {
+      for (TracerStreams<TableStatsTracer>::List::iterator i = g_tracers.begin ();
+	  i != g_tracers.end (); i++)
+	{
+	  i->get<0> ()->flush ();
+	}
+
+      g_tracers.clear ();
+    }
+
+    void
+    TableStatsTracer::PrintHeader (std::ostream &os) const
+    {
+      os << "Time" << "\t"
+	  << "Node" << "\t"
+	  << "Table" << "\t"
+	  << "Entries" << "\t"
+	  << "TrieNodes" << "\t"
+	  << "Bytes" << "\t"
+	  << "Lookups" << "\t"
+	  << "Hits" << "\t"
+	  << "Misses" << "\t"
+	  << "AvgDepth" << "\t"
+	  << "Inserts" << "\t"
+	  << "Erases" << "\t"
+	  << "Expired";
+    }
+
+    void
+    TableStatsTracer::Stats (const std::string &table, const TableStats &stats)
+    {
+      *m_os << Simulator::Now ().ToDouble (Time::S) << "\t"
+	  << m_node << "\t"
+	  << table << "\t"
+	  << stats.m_entries << "\t"
+	  << stats.m_nodes << "\t"
+	  << stats.m_bytes << "\t"
+	  << stats.m_lookups << "\t"
+	  << stats.m_hits << "\t"
+	  << stats.GetMisses () << "\t"
+	  << stats.GetAverageDepth () << "\t"
+	  << stats.m_inserts << "\t"
+	  << stats.m_erases << "\t"
+	  << stats.m_expired << "\n";
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
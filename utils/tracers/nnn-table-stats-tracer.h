@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-table-stats-tracer.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-table-stats-tracer.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-table-stats-tracer.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_TABLE_STATS_TRACER_H_
+#define NNN_TABLE_STATS_TRACER_H_
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/node-container.h"
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/shared_ptr.hpp>
+#include <list>
+
+namespace ns3
+{
+  class Node;
+
+  namespace nnn
+  {
+    struct TableStats;
+
+    /**
+     * @ingroup nnn-tracers
+     * @brief Tracer writing the table counters read by the TableStatsProbe of a node
+     *
+     * Every period, one line per table of the node is written with its sizes
+     * and the lookups, hits, misses, average lookup depth, inserts, erases and
+     * expired entries of the period.
+     */
+    class TableStatsTracer : public SimpleRefCount<TableStatsTracer>
+    {
+    public:
+      /**
+       * @brief Trace constructor that attaches to the probe of the node, installing one if needed
+       * @param os     reference to the output stream
+       * @param node   pointer to the node
+       * @param period time between two readings, if the probe is installed by the tracer
+       */
+      TableStatsTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node, Time period);
+
+      /**
+       * @brief Destructor
+       */
+      ~TableStatsTracer ();
+
+      /**
+       * @brief Helper method to install tracers on a specific simulation node
+       *
+       * @param node Node on which to install tracer
+       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param period How often the tables are read (default, every second)
+       */
+      static void
+      Install (Ptr<Node> node, const std::string &file, Time period = Seconds (1.0));
+
+      /**
+       * @brief Helper method to install tracers on the selected simulation nodes
+       *
+       * @param nodes Nodes on which to install tracer
+       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param period How often the tables are read (default, every second)
+       */
+      static void
+      Install (const NodeContainer &nodes, const std::string &file, Time period = Seconds (1.0));
+
+      /**
+       * @brief Helper method to install tracers on a specific simulation node
+       *
+       * @param node Node on which to install tracer
+       * @param outputStream Smart pointer to a stream
+       * @param period How often the tables are read (default, every second)
+       */
+      static Ptr<TableStatsTracer>
+      Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream, Time period = Seconds (1.0));
+
+      /**
+       * @brief Helper method to install tracers on all simulation nodes
+       *
+       * Under the distributed simulator only the nodes of this rank are traced,
+       * into the file given by DistributedHelper::GetRankFileName
+       *
+       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param period How often the tables are read (default, every second)
+       */
+      static void
+      InstallAll (const std::string &file, Time period = Seconds (1.0));
+
+      /**
+       * @brief Explicit request to remove all statically created tracers
+       *
+       * It is also called by Simulator::Destroy
+       */
+      static void
+      Destroy ();
+
+      /**
+       * @brief Print head of the trace (e.g., for post-processing)
+       *
+       * @param os reference to output stream
+       */
+      void
+      PrintHeader (std::ostream &os) const;
+
+    private:
+      void
+      Stats (const std::string &table, const TableStats &stats);
+
+    private:
+      std::string m_node;
+      boost::shared_ptr<std::ostream> m_os;
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_TABLE_STATS_TRACER_H_ */
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright (c) 2015 Waseda University, Sato Laboratory
+ *
+ *   This file is part of nnnsim.
+ *
+ *  nnn-tracer-streams.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-tracer-streams.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with nnn-tracer-streams.h. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ */
+
+#ifndef NNN_TRACER_STREAMS_H_
+#define NNN_TRACER_STREAMS_H_
+
+#include "ns3/ptr.h"
+#include "ns3/simulator.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include <iostream>
+#include <list>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Output streams of one tracer class, with the tracers writing to each
+     */
+    template<class T>
+    struct TracerStreams
+    {
+      typedef std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<T> > > > List;
+    };
+
+    /**
+     * @brief Keep the tracers writing to a stream until the simulator is destroyed
+     *
+     * The first call schedules T::Destroy with Simulator::ScheduleDestroy,
+     * which flushes the streams and clears kept. Every run thus releases its
+     * tracers when the simulator is destroyed, so runs repeated in one
+     * process, or in processes forked from it, never share or write to the
+     * streams of a previous run.
+     *
+     * @param kept streams of the tracer class, cleared by T::Destroy
+     * @param outputStream stream the tracers write to
+     * @param tracers tracers installed on outputStream
+     */
+    template<class T>
+    void
+    KeepTracers (typename TracerStreams<T>::List &kept, boost::shared_ptr<std::ostream> outputStream,
+		 const std::list<Ptr<T> > &tracers)
+    {
+      if (kept.empty ())
+	Simulator::ScheduleDestroy (&T::Destroy);
+
+      kept.push_back (boost::make_tuple (outputStream, tracers));
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_TRACER_STREAMS_H_ */
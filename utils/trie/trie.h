@@ -165,6 +165,7 @@ namespace ns3
 	, children_ (bucket_traits (buckets_.get (), bucketSize_))
 	, payload_ (PayloadTraits::empty_payload)
 	, parent_ (0)
+	, nodes_ (0)
 	{
 	}
 
@@ -179,6 +180,7 @@ namespace ns3
 	clear ()
 	{
 	  children_.clear_and_dispose (trie_delete_disposer ());
+	  nodes_ = 0;
 	}
 
 	template<class Predicate>
@@ -211,6 +213,7 @@ namespace ns3
 		typename PayloadTraits::insert_type payload)
 		{
 	  trie *trieNode = this;
+	  trie *top = root ();
 
 	  BOOST_FOREACH (const Key &subkey, key)
 	  {
@@ -220,6 +223,7 @@ namespace ns3
 		trie *newNode = new trie (subkey, initialBucketSize_, bucketIncrement_);
 		// std::cout << "new " << newNode << "\n";
 		newNode->parent_ = trieNode;
+		top->nodes_++;
 
 		if (trieNode->children_.size () >= trieNode->bucketSize_)
 		  {
@@ -271,6 +275,7 @@ namespace ns3
 	      if (parent_ == 0) return this;
 
 	      trie *parent = parent_;
+	      root ()->nodes_--;
 	      parent->children_.erase_and_dispose (*this, trie_delete_disposer ()); // delete this; basically, committing a suicide
 
 	      return parent->prune ();
@@ -290,6 +295,7 @@ namespace ns3
 	      if (parent_ == 0) return;
 
 	      trie *parent = parent_;
+	      root ()->nodes_--;
 	      parent->children_.erase_and_dispose (*this, trie_delete_disposer ()); // delete this; basically, committing a suicide
 	    }
 	}
@@ -479,6 +485,15 @@ namespace ns3
 	  return key_;
 	}
 
+	/**
+	 * @brief Number of nodes below the root of the trie, kept as nodes are added and pruned
+	 */
+	size_t
+	node_count () const
+	{
+	  return root ()->nodes_;
+	}
+
 	inline void
 	PrintStat (std::ostream &os) const;
 
@@ -492,6 +507,21 @@ namespace ns3
 	  }
 	};
 
+	inline trie *
+	root ()
+	{
+	  trie *node = this;
+	  while (node->parent_ != 0)
+	    node = node->parent_;
+	  return node;
+	}
+
+	inline const trie *
+	root () const
+	{
+	  return const_cast<trie *> (this)->root ();
+	}
+
 	template<class D>
 	struct array_disposer
 	{
@@ -543,6 +573,7 @@ namespace ns3
 
 	typename PayloadTraits::storage_type payload_;
 	trie *parent_; // to make cleaning effective
+	size_t nodes_; // only kept on the root
       };
 
 